@@ -105,6 +105,8 @@ set(QET_RES_FILES
   ${QET_DIR}/sources/ui/configpage/generalconfigurationpage.ui
   )
 set(QET_SRC_FILES
+  ${QET_DIR}/sources/batchexporter.cpp
+  ${QET_DIR}/sources/batchexporter.h
   ${QET_DIR}/sources/borderproperties.cpp
   ${QET_DIR}/sources/borderproperties.h
   ${QET_DIR}/sources/bordertitleblock.cpp
@@ -216,6 +218,8 @@ set(QET_SRC_FILES
 
   ${QET_DIR}/sources/autoNum/assignvariables.cpp
   ${QET_DIR}/sources/autoNum/assignvariables.h
+  ${QET_DIR}/sources/autoNum/compiledformula.cpp
+  ${QET_DIR}/sources/autoNum/compiledformula.h
   ${QET_DIR}/sources/autoNum/numerotationcontextcommands.cpp
   ${QET_DIR}/sources/autoNum/numerotationcontextcommands.h
   ${QET_DIR}/sources/autoNum/numerotationcontext.cpp
@@ -350,6 +354,8 @@ set(QET_SRC_FILES
   ${QET_DIR}/sources/ElementsCollection/elementcollectionhandler.h
   ${QET_DIR}/sources/ElementsCollection/elementcollectionitem.cpp
   ${QET_DIR}/sources/ElementsCollection/elementcollectionitem.h
+  ${QET_DIR}/sources/ElementsCollection/elementdefinitioncache.cpp
+  ${QET_DIR}/sources/ElementsCollection/elementdefinitioncache.h
   ${QET_DIR}/sources/ElementsCollection/elementscollectionmodel.cpp
   ${QET_DIR}/sources/ElementsCollection/elementscollectionmodel.h
   ${QET_DIR}/sources/ElementsCollection/elementscollectionwidget.cpp
@@ -393,6 +399,16 @@ set(QET_SRC_FILES
 
   ${QET_DIR}/sources/project/projectpropertieshandler.cpp
   ${QET_DIR}/sources/project/projectpropertieshandler.h
+  ${QET_DIR}/sources/project/crossrefupdatequeue.cpp
+  ${QET_DIR}/sources/project/crossrefupdatequeue.h
+  ${QET_DIR}/sources/project/diagramcontentdata.cpp
+  ${QET_DIR}/sources/project/diagramcontentdata.h
+  ${QET_DIR}/sources/project/elementregistry.cpp
+  ${QET_DIR}/sources/project/elementregistry.h
+  ${QET_DIR}/sources/project/potentialindex.cpp
+  ${QET_DIR}/sources/project/potentialindex.h
+  ${QET_DIR}/sources/project/projectxmlcache.cpp
+  ${QET_DIR}/sources/project/projectxmlcache.h
 
   ${QET_DIR}/sources/properties/elementdata.cpp
   ${QET_DIR}/sources/properties/elementdata.h
@@ -483,6 +499,8 @@ set(QET_SRC_FILES
 
   ${QET_DIR}/sources/SearchAndReplace/searchandreplaceworker.cpp
   ${QET_DIR}/sources/SearchAndReplace/searchandreplaceworker.h
+  ${QET_DIR}/sources/SearchAndReplace/searchindex.cpp
+  ${QET_DIR}/sources/SearchAndReplace/searchindex.h
 
   ${QET_DIR}/sources/SearchAndReplace/ui/replaceadvanceddialog.cpp
   ${QET_DIR}/sources/SearchAndReplace/ui/replaceadvanceddialog.h
@@ -701,6 +719,8 @@ set(QET_SRC_FILES
   ${QET_DIR}/sources/utils/macosxopenevent.h
   ${QET_DIR}/sources/utils/qetsettings.cpp
   ${QET_DIR}/sources/utils/qetsettings.h
+  ${QET_DIR}/sources/utils/terminalindex.cpp
+  ${QET_DIR}/sources/utils/terminalindex.h
   ${QET_DIR}/sources/utils/qetutils.cpp
   ${QET_DIR}/sources/utils/qetutils.h
 
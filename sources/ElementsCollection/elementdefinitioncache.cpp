@@ -0,0 +1,361 @@
+/*
+	Copyright 2006-2025 The QElectroTech Team
+	This file is part of QElectroTech.
+
+	QElectroTech is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 2 of the License, or
+	(at your option) any later version.
+
+	QElectroTech is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with QElectroTech.  If not, see <http://www.gnu.org/licenses/>.
+*/
+#include "elementdefinitioncache.h"
+
+#include "../qet.h"
+#include "elementslocation.h"
+#include "xmlelementcollection.h"
+
+#include <QFile>
+#include <QFileInfo>
+#include <QMutexLocker>
+#include <QtConcurrentMap>
+
+ElementDefinitionCache* ElementDefinitionCache::m_cache = nullptr;
+
+/**
+	@brief ElementDefinition::xml
+	@return the "definition" xml element of the element.
+*/
+QDomElement ElementDefinition::xml() const
+{
+	return m_document.documentElement();
+}
+
+/**
+	@brief ElementDefinition::hasValidSize
+	@return true if the width, height and hotspot attributes
+	of the definition are present and are integers
+*/
+bool ElementDefinition::hasValidSize() const
+{
+	return m_valid_size;
+}
+
+/**
+	@brief ElementDefinition::size
+	@return the size of the element as written in the definition
+*/
+QSize ElementDefinition::size() const
+{
+	return m_size;
+}
+
+/**
+	@brief ElementDefinition::hotspot
+	@return the hotspot of the element as written in the definition
+*/
+QPoint ElementDefinition::hotspot() const
+{
+	return m_hotspot;
+}
+
+/**
+	@brief ElementDefinition::uuid
+	@return the uuid of the element, can be null
+*/
+QUuid ElementDefinition::uuid() const
+{
+	return m_uuid;
+}
+
+/**
+	@brief ElementDefinition::linkType
+	@return the link type of the element (simple, master, slave...)
+*/
+QString ElementDefinition::linkType() const
+{
+	return m_link_type;
+}
+
+/**
+	@brief ElementDefinition::elementData
+	@return the element data (type, names, informations...) of the element
+*/
+ElementData ElementDefinition::elementData() const
+{
+	return m_data;
+}
+
+/**
+	@brief ElementDefinition::kindInformations
+	@return the kind informations of the element
+*/
+DiagramContext ElementDefinition::kindInformations() const
+{
+	return m_kind_informations;
+}
+
+/**
+	@brief ElementDefinition::terminals
+	@return the xml description of each terminal of the element
+*/
+QList<QDomElement> ElementDefinition::terminals() const
+{
+	return m_terminals;
+}
+
+/**
+	@brief ElementDefinition::texts
+	@return the xml description of each text (input and dynamic text)
+	of the element
+*/
+QList<QDomElement> ElementDefinition::texts() const
+{
+	return m_texts;
+}
+
+/**
+	@brief ElementDefinition::partsCount
+	@return the number of xml elements (graphical parts, terminals
+	and texts) found in the description of the element
+*/
+int ElementDefinition::partsCount() const
+{
+	return m_parts_count;
+}
+
+/**
+	@brief ElementDefinitionCache::definition
+	@param location : location of an element
+	@return the parsed definition of the element at location,
+	or a null pointer if location is not an existing and valid element.
+	The definition is parsed only the first time or when the stored
+	definition is outdated.
+*/
+QSharedPointer<const ElementDefinition> ElementDefinitionCache::definition(
+		const ElementsLocation &location)
+{
+	if (!location.isElement()) {
+		return QSharedPointer<const ElementDefinition>();
+	}
+
+	const QString key_ = key(location);
+	{
+		QMutexLocker locker(&m_mutex);
+		const auto definition = m_definitions.value(key_);
+		if (definition && isUpToDate(*definition, location)) {
+			return definition;
+		}
+	}
+
+		//Parse outside of the lock, several threads can load
+		//different elements at the same time
+	QSharedPointer<const ElementDefinition> definition = load(location);
+
+	QMutexLocker locker(&m_mutex);
+	if (definition) {
+		m_definitions.insert(key_, definition);
+	} else {
+		m_definitions.remove(key_);
+	}
+	return definition;
+}
+
+/**
+	@brief ElementDefinitionCache::preload
+	Parse the definitions of locations which are not already in the cache.
+	Definitions stored in files are parsed concurrently by a pool of threads,
+	definitions embedded in a project are parsed in the calling thread
+	because the embedded collection must only be read from its own thread.
+	This function return when every definition is loaded.
+	@param locations
+*/
+void ElementDefinitionCache::preload(const QList<ElementsLocation> &locations)
+{
+	QList<ElementsLocation> files;
+	for (const auto &location : locations)
+	{
+		if (!location.isElement()) {
+			continue;
+		}
+		if (location.isProject()) {
+			definition(location);
+		} else {
+			files << location;
+		}
+	}
+
+	QtConcurrent::blockingMap(files, [this](const ElementsLocation &location) {
+		definition(location);
+	});
+}
+
+/**
+	@brief ElementDefinitionCache::invalidate
+	Remove the stored definition of the element at location,
+	the next call of definition() will parse it again.
+	@param location
+*/
+void ElementDefinitionCache::invalidate(const ElementsLocation &location)
+{
+	QMutexLocker locker(&m_mutex);
+	m_definitions.remove(key(location));
+}
+
+/**
+	@brief ElementDefinitionCache::clear
+	Remove all stored definitions
+*/
+void ElementDefinitionCache::clear()
+{
+	QMutexLocker locker(&m_mutex);
+	m_definitions.clear();
+}
+
+/**
+	@brief ElementDefinitionCache::key
+	@param location
+	@return the key used to store the definition of location
+*/
+QString ElementDefinitionCache::key(const ElementsLocation &location)
+{
+	if (location.isProject())
+	{
+		return QString::number(
+					reinterpret_cast<quintptr>(location.projectCollection()),
+					16)
+				+ QLatin1Char('+')
+				+ location.collectionPath(false);
+	}
+	return location.fileSystemPath();
+}
+
+/**
+	@brief ElementDefinitionCache::isUpToDate
+	@param definition
+	@param location
+	@return true if definition is still the definition of location
+*/
+bool ElementDefinitionCache::isUpToDate(const ElementDefinition &definition,
+					const ElementsLocation &location)
+{
+	if (location.isProject())
+	{
+		const auto collection = location.projectCollection();
+		return collection
+				&& collection->revision() == definition.m_collection_revision;
+	}
+
+	const QFileInfo info(location.fileSystemPath());
+	return info.exists()
+			&& info.lastModified() == definition.m_last_modified
+			&& info.size() == definition.m_file_size;
+}
+
+/**
+	@brief ElementDefinitionCache::load
+	Parse the definition of the element at location.
+	@param location
+	@return the parsed definition or a null pointer
+	if the element can't be read.
+*/
+QSharedPointer<ElementDefinition> ElementDefinitionCache::load(
+		const ElementsLocation &location)
+{
+	QSharedPointer<ElementDefinition> definition(new ElementDefinition());
+
+	if (location.isProject())
+	{
+		const auto collection = location.projectCollection();
+		if (!collection) {
+			return QSharedPointer<ElementDefinition>();
+		}
+		const QDomElement element = collection->element(
+						location.collectionPath(false));
+		if (element.isNull()) {
+			return QSharedPointer<ElementDefinition>();
+		}
+			//Deep copy, the definition must not follow
+			//the changes made to the collection
+		definition->m_document.appendChild(
+					definition->m_document.importNode(
+						element.firstChildElement(QStringLiteral("definition")),
+						true));
+		definition->m_collection_revision = collection->revision();
+	}
+	else
+	{
+		QFile file(location.fileSystemPath());
+		const QFileInfo info(file);
+		if (!info.exists() || !definition->m_document.setContent(&file)) {
+			return QSharedPointer<ElementDefinition>();
+		}
+		definition->m_last_modified = info.lastModified();
+		definition->m_file_size = info.size();
+	}
+
+	QDomElement root = definition->m_document.documentElement();
+	if (root.tagName() != QLatin1String("definition")) {
+		return QSharedPointer<ElementDefinition>();
+	}
+
+	int w = 0, h = 0, hot_x = 0, hot_y = 0;
+	definition->m_valid_size =
+			QET::attributeIsAnInteger(root, QStringLiteral("width"), &w)
+			&& QET::attributeIsAnInteger(root, QStringLiteral("height"), &h)
+			&& QET::attributeIsAnInteger(root, QStringLiteral("hotspot_x"), &hot_x)
+			&& QET::attributeIsAnInteger(root, QStringLiteral("hotspot_y"), &hot_y);
+	definition->m_size = QSize(w, h);
+	definition->m_hotspot = QPoint(hot_x, hot_y);
+	definition->m_uuid = QUuid(root.firstChildElement(QStringLiteral("uuid"))
+				   .attribute(QStringLiteral("uuid")));
+	definition->m_link_type = root.attribute(QStringLiteral("link_type"));
+	definition->m_data.fromXml(root);
+	definition->m_kind_informations.fromXml(
+				root.firstChildElement(QStringLiteral("kindInformations")),
+				QStringLiteral("kindInformation"));
+
+	for (QDomElement description = root.firstChildElement(QStringLiteral("description")) ;
+		 !description.isNull() ;
+		 description = description.nextSiblingElement(QStringLiteral("description")))
+	{
+			//Workaround for old elements, done once here
+			//because the shared definition must not be modified later :
+			//if no input is the label, the first input become the label.
+		QList<QDomElement> inputs;
+		bool have_label = false;
+		for (QDomElement child = description.firstChildElement() ;
+			 !child.isNull() ;
+			 child = child.nextSiblingElement())
+		{
+			++definition->m_parts_count;
+			if (child.tagName() == QLatin1String("terminal")) {
+				definition->m_terminals << child;
+			}
+			else if (child.tagName() == QLatin1String("dynamic_text")) {
+				definition->m_texts << child;
+			}
+			else if (child.tagName() == QLatin1String("input"))
+			{
+				definition->m_texts << child;
+				inputs << child;
+				if (child.attribute(QStringLiteral("tagg"), QStringLiteral("none"))
+						== QLatin1String("label")) {
+					have_label = true;
+				}
+			}
+		}
+		if (!have_label && !inputs.isEmpty()) {
+			inputs.first().setAttribute(QStringLiteral("tagg"),
+						    QStringLiteral("label"));
+		}
+	}
+
+	return definition;
+}
@@ -0,0 +1,149 @@
+/*
+	Copyright 2006-2025 The QElectroTech Team
+	This file is part of QElectroTech.
+
+	QElectroTech is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 2 of the License, or
+	(at your option) any later version.
+
+	QElectroTech is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with QElectroTech.  If not, see <http://www.gnu.org/licenses/>.
+*/
+#ifndef ELEMENTDEFINITIONCACHE_H
+#define ELEMENTDEFINITIONCACHE_H
+
+#include "../diagramcontext.h"
+#include "../properties/elementdata.h"
+
+#include <QDateTime>
+#include <QDomDocument>
+#include <QHash>
+#include <QMutex>
+#include <QPoint>
+#include <QSharedPointer>
+#include <QSize>
+#include <QUuid>
+
+class ElementsLocation;
+
+/**
+	@brief The ElementDefinition class
+	Parsed definition of an element type.
+	A definition is immutable once built and is shared by every element
+	created from the same location, so the xml returned by xml(),
+	terminals() and texts() must never be modified.
+*/
+class ElementDefinition
+{
+		friend class ElementDefinitionCache;
+
+	public:
+		QDomElement xml() const;
+		bool hasValidSize() const;
+		QSize size() const;
+		QPoint hotspot() const;
+		QUuid uuid() const;
+		QString linkType() const;
+		ElementData elementData() const;
+		DiagramContext kindInformations() const;
+		QList<QDomElement> terminals() const;
+		QList<QDomElement> texts() const;
+		int partsCount() const;
+
+	private:
+		ElementDefinition() {}
+
+		QDomDocument m_document;
+		bool m_valid_size = false;
+		QSize m_size;
+		QPoint m_hotspot;
+		QUuid m_uuid;
+		QString m_link_type;
+		ElementData m_data;
+		DiagramContext m_kind_informations;
+		QList<QDomElement> m_terminals;
+		QList<QDomElement> m_texts;
+		int m_parts_count = 0;
+
+			//Used to know if the definition is still up to date
+		QDateTime m_last_modified;
+		qint64 m_file_size = -1;
+		quint64 m_collection_revision = 0;
+};
+
+/**
+	@brief The ElementDefinitionCache class
+	This class is a thread safe singleton which keep in memory
+	one parsed definition per element location.
+	A definition stored in a file is reloaded when the modification
+	date or the size of the file change,
+	a definition embedded in a project is reloaded when
+	the embedded collection of the project change.
+*/
+class ElementDefinitionCache
+{
+	public:
+		/**
+			@brief instance
+			@return The instance of the cache
+		*/
+		static ElementDefinitionCache* instance()
+		{
+			static QMutex mutex;
+			if (!m_cache)
+			{
+				mutex.lock();
+				if (!m_cache) {
+					m_cache = new ElementDefinitionCache();
+				}
+				mutex.unlock();
+			}
+			return m_cache;
+		}
+
+		/**
+			@brief dropInstance
+			Drop the instance of cache
+		*/
+		static void dropInstance()
+		{
+			static QMutex mutex;
+			if (m_cache)
+			{
+				mutex.lock();
+				delete m_cache;
+				m_cache = nullptr;
+				mutex.unlock();
+			}
+		}
+
+		QSharedPointer<const ElementDefinition> definition(
+				const ElementsLocation &location);
+		void preload(const QList<ElementsLocation> &locations);
+		void invalidate(const ElementsLocation &location);
+		void clear();
+
+	private:
+		ElementDefinitionCache() {}
+		ElementDefinitionCache (const ElementDefinitionCache &);
+		ElementDefinitionCache operator= (const ElementDefinitionCache &);
+		~ElementDefinitionCache() {}
+
+		static QString key(const ElementsLocation &location);
+		static bool isUpToDate(const ElementDefinition &definition,
+				       const ElementsLocation &location);
+		static QSharedPointer<ElementDefinition> load(
+				const ElementsLocation &location);
+
+		QMutex m_mutex;
+		QHash<QString, QSharedPointer<const ElementDefinition>> m_definitions;
+		static ElementDefinitionCache* m_cache;
+};
+
+#endif // ELEMENTDEFINITIONCACHE_H
@@ -23,6 +23,7 @@
 #include "../qetgraphicsitem/element.h"
 #include "../qetproject.h"
 #include "../qetxml.h"
+#include "elementdefinitioncache.h"
 #include "xmlelementcollection.h"
 
 #include <QPicture>
@@ -714,21 +715,24 @@ pugi::xml_document ElementsLocation::pugiXml() const
 	}
 	else
 	{
-			//Get the xml dom from Qt xml and copie to pugi xml
-		QDomDocument qdoc;
+			//Copy the embedded dom directly to pugi xml
 		QString str = m_collection_path;
-		if (isElement()) {
-			QDomElement element = m_project->embeddedElementCollection()->element(str.remove("embed://"));
-			qdoc.appendChild(qdoc.importNode(element.firstChildElement("definition"),true));
-		} else {
-			QDomElement element = m_project->embeddedElementCollection()->directory(str.remove("embed://"));
-			qdoc.appendChild(qdoc.importNode(element, true));
-		}
-		docu.load_string(qdoc.toString(4).toStdString().c_str());
+		return m_project->embeddedElementCollection()->pugiXml(str.remove("embed://"));
 	}
 	return docu;
 }
 
+/**
+	@brief ElementsLocation::definition
+	@return the shared parsed definition of this element,
+	or a null pointer if this location isn't a valid element.
+	@see ElementDefinitionCache
+*/
+QSharedPointer<const ElementDefinition> ElementsLocation::definition() const
+{
+	return ElementDefinitionCache::instance()->definition(*this);
+}
+
 /**
 	@brief ElementsLocation::setXml
 	Replace the current xml description by xml_document;
@@ -754,6 +758,7 @@ bool ElementsLocation::setXml(const QDomDocument &xml_document) const
 	{
 		QString error;
 		QETXML::writeXmlFile(xml_document, fileSystemPath(), &error);
+		ElementDefinitionCache::instance()->invalidate(*this);
 
 		if (!error.isEmpty()) {
 			qDebug() << "ElementsLocation::setXml error : "
@@ -775,6 +780,8 @@ bool ElementsLocation::setXml(const QDomDocument &xml_document) const
 			parent_node.appendChild(xml_document
 						.documentElement()
 						.cloneNode(true));
+			emit m_project->embeddedElementCollection()
+					->elementChanged(collectionPath(false));
 			return true;
 		}
 		//Element doesn't exist, we create the element
@@ -839,12 +846,8 @@ QUuid ElementsLocation::uuid() const
 		return QUuid();
 	}
 
-	auto document = pugiXml();
-	auto uuid_node = document.document_element().child("uuid");
-	if (uuid_node.empty()) {
-		return QUuid();
-	}
-	return QUuid(uuid_node.attribute("uuid").as_string());
+	const auto definition_ = definition();
+	return definition_ ? definition_->uuid() : QUuid();
 }
 
 /**
@@ -874,6 +877,10 @@ QIcon ElementsLocation::icon() const
 */
 QString ElementsLocation::name() const
 {
+	if (const auto definition_ = definition()) {
+		return definition_->elementData().m_names_list.name(fileName());
+	}
+
 	NamesList nl;
 	nl.fromXml(pugiXml().document_element());
 	return nl.name(fileName());
@@ -913,9 +920,9 @@ DiagramContext ElementsLocation::elementInformations() const
 	if (isDirectory()) {
 		return context;
 	}
-	context.fromXml(pugiXml().document_element().child(
-				"elementInformations"),
-			"elementInformation");
+	if (const auto definition_ = definition()) {
+		return definition_->elementData().m_informations;
+	}
 	return  context;
 }
 
@@ -23,12 +23,14 @@
 #include "pugixml/src/pugixml.hpp"
 
 #include <QIcon>
+#include <QSharedPointer>
 #include <QString>
 
 #ifndef Q_OS_LINUX
 #include "sstream"
 #endif
 
+class ElementDefinition;
 class QETProject;
 class XmlElementCollection;
 
@@ -87,6 +89,7 @@ class ElementsLocation
 
 		QDomElement xml() const;
 		pugi::xml_document pugiXml() const;
+		QSharedPointer<const ElementDefinition> definition() const;
 		bool setXml(const QDomDocument &xml_document) const;
 		QUuid uuid() const;
 		QIcon icon() const;
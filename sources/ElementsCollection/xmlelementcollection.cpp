@@ -22,6 +22,14 @@
 #include "../qetxml.h"
 #include "elementslocation.h"
 
+#include <atomic>
+
+namespace {
+		//Shared by every collection, so a revision number is never
+		//reused, even by a collection created at the address of a deleted one.
+	std::atomic<quint64> revision_counter(0);
+}
+
 /**
 	@brief XmlElementCollection::XmlElementCollection
 	Build an empty collection.
@@ -39,6 +47,8 @@ XmlElementCollection::XmlElementCollection(QETProject *project) :
 	QObject(project),
 	m_project(project)
 {
+	initRevision();
+
 	QDomElement collection = m_dom_document.createElement("collection");
 	m_dom_document.appendChild(collection);
 	QDomElement import = m_dom_document.createElement("category");
@@ -121,6 +131,8 @@ XmlElementCollection::XmlElementCollection(const QDomElement &dom_element,
 	QObject(project),
 	m_project(project)
 {
+	initRevision();
+
 	if (dom_element.tagName() == "collection")
 		m_dom_document.appendChild(m_dom_document.importNode(
 						   dom_element, true));
@@ -128,6 +140,39 @@ XmlElementCollection::XmlElementCollection(const QDomElement &dom_element,
 		qDebug() << "XmlElementCollection : tagName of dom_element is not collection";
 }
 
+/**
+	@brief XmlElementCollection::XmlElementCollection
+	Constructor with an collection read by pugixml.
+	The name of xml_node must be "collection"
+	@param xml_node : the collection, copied in the dom document
+	of this collection without intermediate dom.
+	@param project : the project of this collection
+*/
+XmlElementCollection::XmlElementCollection(const pugi::xml_node &xml_node,
+					   QETProject *project) :
+	QObject(project),
+	m_project(project)
+{
+	initRevision();
+
+	if (qstrcmp(xml_node.name(), "collection") == 0)
+		m_dom_document.appendChild(QETXML::pugiToDomElement(
+						   m_dom_document, xml_node));
+	else
+		qDebug() << "XmlElementCollection : name of xml_node is not collection";
+}
+
+/**
+	@brief XmlElementCollection::revision
+	@return the revision number of this collection.
+	The revision change each time an element or a directory
+	is added, changed or removed, and is unique across all collections.
+*/
+quint64 XmlElementCollection::revision() const
+{
+	return m_revision;
+}
+
 /**
 	@brief XmlElementCollection::root
 	The root is the first DOM-Element the xml collection, the tag name
@@ -180,33 +225,40 @@ QDomElement XmlElementCollection::child(const QDomElement &parent_element,
 	if (parent_element.ownerDocument() != m_dom_document)
 		return QDomElement();
 
-		//Get all childs element of parent_element
-	QDomNodeList child_list = parent_element.childNodes();
-	QString tag_name(child_name.endsWith(".elmt")? "element" : "category");
-	QList <QDomElement> found_dom_element;
-	for (int i=0 ; i<child_list.length() ; i++)
+	const QString tag_name(child_name.endsWith(".elmt")? "element" : "category");
+	for (QDomElement child_element = parent_element.firstChildElement(tag_name) ;
+	     !child_element.isNull() ;
+	     child_element = child_element.nextSiblingElement(tag_name))
 	{
-		QDomElement child_element = child_list.item(i).toElement();
-		if (child_element.tagName() == tag_name)
-			found_dom_element << child_element;
+		if (child_element.attribute("name") == child_name)
+			return child_element;
 	}
 
-	if (found_dom_element.isEmpty()) return QDomElement();
-
-	foreach (QDomElement elmt, found_dom_element)
-		if (elmt.attribute("name") == child_name)
-			return elmt;
-
 	return QDomElement();
 }
 
 /**
 	@brief XmlElementCollection::child
 	@param path
-	@return the DomElement at path if exist, else return a null QDomElement
+	@return the DomElement at path if exist, else return a null QDomElement.
+	The found DomElement is kept in an index,
+	so the path is walked only the first time.
 */
 QDomElement XmlElementCollection::child(const QString &path) const
 {
+	const auto indexed = m_path_index.constFind(path);
+	if (indexed != m_path_index.constEnd())
+	{
+			//The dom can be changed without this collection,
+			//only trust an item still attached to the document
+		QDomNode node = indexed.value();
+		while (!node.isNull() && !node.isDocument())
+			node = node.parentNode();
+		if (!node.isNull())
+			return indexed.value();
+		m_path_index.remove(path);
+	}
+
 	QStringList path_list = path.split("/");
 	if (path_list.isEmpty()) return QDomElement();
 
@@ -221,6 +273,7 @@ QDomElement XmlElementCollection::child(const QString &path) const
 			parent_element = child_element;
 	}
 
+	m_path_index.insert(path, parent_element);
 	return parent_element;
 }
 
@@ -345,6 +398,27 @@ QDomElement XmlElementCollection::directory(const QString &path) const
 		return QDomElement();
 }
 
+/**
+	@brief XmlElementCollection::pugiXml
+	@param path : path of an element or a directory in this collection
+	@return a pugixml copy of the definition of the element at path,
+	or of the directory at path. The dom is copied node by node,
+	without write and parse it again as text.
+	The document is empty if nothing is found at path.
+*/
+pugi::xml_document XmlElementCollection::pugiXml(const QString &path) const
+{
+	pugi::xml_document document;
+
+	const QDomElement dom_element = path.endsWith(".elmt")
+			? element(path).firstChildElement("definition")
+			: directory(path);
+	if (!dom_element.isNull())
+		QETXML::domToPugiElement(document, dom_element);
+
+	return document;
+}
+
 /**
 	@brief XmlElementCollection::addElement
 	Add the element at location to this collection.
@@ -438,6 +512,7 @@ QString XmlElementCollection::addElement(ElementsLocation &location)
 			}
 
 			integrated_path.append("/"+str);
+			m_path_index.insert(integrated_path, parent_element);
 		}
 	}
 	else if (location.isProject()) {
@@ -483,6 +558,7 @@ QString XmlElementCollection::addElement(ElementsLocation &location)
 				parent_element = child_element;
 
 			integrated_path.append("/"+str);
+			m_path_index.insert(integrated_path, parent_element);
 		}
 	}
 
@@ -548,6 +624,7 @@ bool XmlElementCollection::removeElement(const QString& path)
 
 	if (!elmt.isNull()) {
 		elmt.parentNode().removeChild(elmt);
+		unindexPath(path);
 		emit elementRemoved(path);
 		return true;
 	}
@@ -634,6 +711,7 @@ bool XmlElementCollection::createDir(const QString& path,
 	new_dir.appendChild(name_list.toXml(m_dom_document));
 
 	parent_dir.appendChild(new_dir);
+	m_path_index.insert(new_dir_path, new_dir);
 
 	emit directorieAdded(new_dir_path);
 
@@ -652,6 +730,7 @@ bool XmlElementCollection::removeDir(const QString& path)
 	QDomElement dir = directory(path);
 	if (!dir.isNull()) {
 		dir.parentNode().removeChild(dir);
+		unindexPath(path);
 		emit directoryRemoved(path);
 		return true;
 	}
@@ -792,6 +871,8 @@ ElementsLocation XmlElementCollection::copyDirectory(
 				    + "/" + new_dir_name);
 	if (!element.isNull()) {
 		element.parentNode().removeChild(element);
+		unindexPath(destination.collectionPath(false)
+			    + "/" + new_dir_name);
 		emit directoryRemoved(destination.collectionPath(false)
 				      + "/" + new_dir_name);
 	}
@@ -910,6 +991,8 @@ ElementsLocation XmlElementCollection::copyElement(
 	bool removed = false;
 	if (!element.isNull()) {
 		element.parentNode().removeChild(element);
+		unindexPath(destination.collectionPath(false)
+			    + "/" + new_elmt_name);
 		removed = true;
 	}
 
@@ -930,3 +1013,38 @@ ElementsLocation XmlElementCollection::copyElement(
 
 	return copy_loc;
 }
+
+/**
+	@brief XmlElementCollection::initRevision
+	Give a new revision number to this collection,
+	and renew it each time the content of the collection change.
+*/
+void XmlElementCollection::initRevision()
+{
+	m_revision = ++revision_counter;
+
+	auto renew = [this]() { m_revision = ++revision_counter; };
+	connect(this, &XmlElementCollection::elementAdded,     this, renew);
+	connect(this, &XmlElementCollection::elementChanged,   this, renew);
+	connect(this, &XmlElementCollection::elementRemoved,   this, renew);
+	connect(this, &XmlElementCollection::directorieAdded,  this, renew);
+	connect(this, &XmlElementCollection::directoryRemoved, this, renew);
+}
+
+/**
+	@brief XmlElementCollection::unindexPath
+	Remove from the path index the item at path and all its children.
+	Must be called each time an item is removed from the dom of this collection.
+	@param path
+*/
+void XmlElementCollection::unindexPath(const QString &path)
+{
+	const QString children_path = path + "/";
+	for (auto it = m_path_index.begin() ; it != m_path_index.end() ; )
+	{
+		if (it.key() == path || it.key().startsWith(children_path))
+			it = m_path_index.erase(it);
+		else
+			++it;
+	}
+}
@@ -20,6 +20,7 @@
 
 #include <QObject>
 #include <QDomElement>
+#include <QHash>
 #include "elementslocation.h"
 
 class QDomElement;
@@ -38,6 +39,9 @@ class XmlElementCollection : public QObject
 		XmlElementCollection (QETProject *project);
 		XmlElementCollection (const QDomElement &dom_element,
 				      QETProject *project);
+		XmlElementCollection (const pugi::xml_node &xml_node,
+				      QETProject *project);
+		quint64 revision() const;
 		QDomElement root() const;
 		QDomElement importCategory() const;
 		QDomNodeList childs(const QDomElement &parent_element) const;
@@ -54,6 +58,7 @@ class XmlElementCollection : public QObject
 				const QDomElement &parent_element) const;
 		QDomElement element(const QString &path) const;
 		QDomElement directory(const QString &path) const;
+		pugi::xml_document pugiXml(const QString &path) const;
 		QString addElement (ElementsLocation &location);
 		bool addElementDefinition (const QString &dir_path,
 					   const QString &elmt_name,
@@ -78,6 +83,8 @@ class XmlElementCollection : public QObject
 		void cleanUnusedDirectory();
 
 	private:
+		void initRevision();
+		void unindexPath(const QString &path);
 		ElementsLocation copyDirectory(
 				ElementsLocation &source,
 				ElementsLocation &destination,
@@ -122,6 +129,10 @@ class XmlElementCollection : public QObject
 	private:
 		QDomDocument m_dom_document;
 		QETProject *m_project = nullptr;
+		quint64 m_revision = 0;
+			//Path -> element or category, filled by child(path)
+			//and by the functions which add or remove items.
+		mutable QHash<QString, QDomElement> m_path_index;
 };
 
 #endif // XMLELEMENTCOLLECTION_H
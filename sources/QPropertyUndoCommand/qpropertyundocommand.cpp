@@ -75,6 +75,15 @@ QPropertyUndoCommand::QPropertyUndoCommand(const QPropertyUndoCommand *other)
 	setText(other->text());
 }
 
+/**
+	@brief QPropertyUndoCommand::object
+	@return the object whose property is changed by this command
+*/
+QObject *QPropertyUndoCommand::object() const
+{
+	return m_object;
+}
+
 /**
 	@brief QPropertyUndoCommand::setNewValue
 	Set the new value of the property (set with redo) to new_value
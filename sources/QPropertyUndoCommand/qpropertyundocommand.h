@@ -47,6 +47,7 @@ class QPropertyUndoCommand : public QUndoCommand
 		void setNewValue(const QVariant &new_value);
 		void enableAnimation (bool animate = true);
 		void setAnimated(bool animate = true, bool first_time = true);
+		QObject *object() const;
 
 		int id() const override{return 10000;}
 		bool mergeWith(const QUndoCommand *other) override;
@@ -24,6 +24,7 @@
 #include "../qetgraphicsitem/element.h"
 #include "../qetgraphicsitem/independenttextitem.h"
 #include "../qetinformation.h"
+#include "../qetproject.h"
 #include "../undocommand/changeelementinformationcommand.h"
 #include "../undocommand/changetitleblockcommand.h"
 
@@ -52,6 +53,7 @@ void SearchAndReplaceWorker::replaceDiagram(QList<Diagram *> diagram_list)
 		}
 	}
 
+	ProjectBatchScope batch(project);
 	QUndoStack *us = project->undoStack();
 	us->beginMacro(QObject::tr("Chercher/remplacer les propriétés de folio"));
 	for (Diagram *d : diagram_list)
@@ -117,7 +119,9 @@ void SearchAndReplaceWorker::replaceElement(QList<Element *> list)
 		}
 	}
 
-	project_->undoStack()->beginMacro(QObject::tr("Chercher/remplacer les propriétés d'éléments."));
+		//All changes are made by a single command,
+		//so the project is notified once when the command is done or undone
+	QMap<QPointer<Element>, QPair<DiagramContext, DiagramContext>> changes;
 	for (Element *elmt : list)
 	{
 			//We apply change only for master, slave, and terminal element.
@@ -134,14 +138,18 @@ void SearchAndReplaceWorker::replaceElement(QList<Element *> list)
 													  m_element_context.value(key).toString()));
 			}
 
-			if (old_context != new_context)
-			{
-				ChangeElementInformationCommand *undo = new ChangeElementInformationCommand(elmt, old_context, new_context);
-				project_->undoStack()->push(undo);
+			if (old_context != new_context) {
+				changes.insert(QPointer<Element>(elmt), qMakePair(old_context, new_context));
 			}
 		}
 	}
-	project_->undoStack()->endMacro();
+
+	if (!changes.isEmpty())
+	{
+		project_->undoStack()->beginMacro(QObject::tr("Chercher/remplacer les propriétés d'éléments."));
+		project_->undoStack()->push(new ChangeElementInformationCommand(changes));
+		project_->undoStack()->endMacro();
+	}
 }
 
 void SearchAndReplaceWorker::replaceElement(Element *element)
@@ -170,6 +178,7 @@ void SearchAndReplaceWorker::replaceIndiText(QList<IndependentTextItem *> list)
 		}
 	}
 
+	ProjectBatchScope batch(project_);
 	project_->undoStack()->beginMacro(QObject::tr("Chercher/remplacer des textes independants"));
 	for (IndependentTextItem *text : list)
 	{
@@ -210,6 +219,7 @@ void SearchAndReplaceWorker::replaceConductor(QList<Conductor *> list)
 		}
 	}
 
+	ProjectBatchScope batch(project_);
 	project_->undoStack()->beginMacro(QObject::tr("Chercher/remplacer les propriétés de conducteurs."));
 	for (Conductor *c : list)
 	{
@@ -297,6 +307,7 @@ void SearchAndReplaceWorker::replaceAdvanced(
 		return;
 	}
 
+	ProjectBatchScope batch(project_);
 	project_->undoStack()->beginMacro(QObject::tr("Rechercher / remplacer avancé"));
 	if (who == 0)
 	{
@@ -311,14 +322,18 @@ void SearchAndReplaceWorker::replaceAdvanced(
 	}
 	else if (who == 1)
 	{
+		QMap<QPointer<Element>, QPair<DiagramContext, DiagramContext>> changes;
 		for (Element *element : elements)
 		{
 			DiagramContext old_context = element->elementInformations();
 			DiagramContext new_context = replaceAdvanced(element);
 			if (old_context != new_context) {
-				project_->undoStack()->push(new ChangeElementInformationCommand(element, old_context, new_context));
+				changes.insert(QPointer<Element>(element), qMakePair(old_context, new_context));
 			}
 		}
+		if (!changes.isEmpty()) {
+			project_->undoStack()->push(new ChangeElementInformationCommand(changes));
+		}
 	}
 	else if (who == 2)
 	{
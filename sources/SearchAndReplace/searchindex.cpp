@@ -0,0 +1,348 @@
+/*
+	Copyright 2006-2025 The QElectroTech Team
+	This file is part of QElectroTech.
+	
+	QElectroTech is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 2 of the License, or
+	(at your option) any later version.
+	
+	QElectroTech is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+	
+	You should have received a copy of the GNU General Public License
+	along with QElectroTech.  If not, see <http://www.gnu.org/licenses/>.
+*/
+#include "searchindex.h"
+
+namespace {
+		//Same characters as \w of QRegularExpression (without unicode properties)
+	inline bool isWordChar(const QChar &c)
+	{
+		const ushort u = c.unicode();
+		return (u >= 'a' && u <= 'z')
+				|| (u >= 'A' && u <= 'Z')
+				|| (u >= '0' && u <= '9')
+				|| u == '_';
+	}
+
+	inline bool hasRegularExpressionChar(const QString &str)
+	{
+		static const QString special_chars = QStringLiteral("\\^$.|?*+()[]{}");
+		for (const QChar &c : str) {
+			if (special_chars.contains(c)) {
+				return true;
+			}
+		}
+		return false;
+	}
+}
+
+/**
+	@brief SearchIndex::Query::isValid
+	@return true if the query can be used for a search
+*/
+bool SearchIndex::Query::isValid() const
+{
+	return !whole_word || regular_expression.isValid();
+}
+
+/**
+	@brief SearchIndex::query
+	@param text : the searched text, if whole_word is true,
+	text is used in a regular expression
+	@param whole_word : true to only search text as entire words
+	@param case_sensitivity
+	@return the query to give to search() and matches()
+*/
+SearchIndex::Query SearchIndex::query(const QString &text,
+				      bool whole_word,
+				      Qt::CaseSensitivity case_sensitivity)
+{
+	Query query_;
+	query_.text = text;
+	query_.whole_word = whole_word;
+	query_.case_sensitivity = case_sensitivity;
+	if (whole_word)
+	{
+		query_.regular_expression.setPattern("\\b" + text + "\\b");
+		if (case_sensitivity == Qt::CaseInsensitive) {
+			query_.regular_expression.setPatternOptions(
+						QRegularExpression::CaseInsensitiveOption);
+		}
+	}
+	return query_;
+}
+
+/**
+	@brief SearchIndex::tokens
+	@param str
+	@return the lowercase words of str.
+	A word is a sequence of letters, digits and underscores (ascii only),
+	like a word of \b in a regular expression.
+*/
+QStringList SearchIndex::tokens(const QString &str)
+{
+	QStringList tokens_;
+	int start = -1;
+	for (int i = 0 ; i <= str.size() ; ++i)
+	{
+		if (i < str.size() && isWordChar(str.at(i)))
+		{
+			if (start < 0) {
+				start = i;
+			}
+		}
+		else if (start >= 0)
+		{
+			tokens_.append(str.mid(start, i - start).toLower());
+			start = -1;
+		}
+	}
+	return tokens_;
+}
+
+/**
+	@brief SearchIndex::addEntry
+	Add a new entry to this index
+	@param terms : the terms of the entry
+	@return the id of the entry
+*/
+int SearchIndex::addEntry(const QStringList &terms)
+{
+	const int id = m_terms.size();
+	m_terms.append(terms);
+	indexTerms(id, terms);
+	return id;
+}
+
+/**
+	@brief SearchIndex::setTerms
+	Replace the terms of the entry id,
+	used when the searched item change.
+	@param id
+	@param terms
+*/
+void SearchIndex::setTerms(int id, const QStringList &terms)
+{
+	if (id < 0 || id >= m_terms.size()) {
+		return;
+	}
+
+	unindexTerms(id);
+	m_terms[id] = terms;
+	indexTerms(id, terms);
+}
+
+/**
+	@brief SearchIndex::terms
+	@param id
+	@return the terms of the entry id
+*/
+QStringList SearchIndex::terms(int id) const
+{
+	return m_terms.value(id);
+}
+
+/**
+	@brief SearchIndex::count
+	@return the number of entries of this index
+*/
+int SearchIndex::count() const
+{
+	return m_terms.size();
+}
+
+/**
+	@brief SearchIndex::clear
+	Remove every entries
+*/
+void SearchIndex::clear()
+{
+	m_terms.clear();
+	m_postings.clear();
+	m_last_word.clear();
+	m_last_word_tokens.clear();
+}
+
+/**
+	@brief SearchIndex::search
+	@param query
+	@return the id of every entries matching query.
+	A entry match if one of its terms contain the text of query,
+	or match the regular expression of query if query is a whole word query.
+*/
+QSet<int> SearchIndex::search(const Query &query) const
+{
+	QSet<int> found;
+	if (!query.isValid()) {
+		return found;
+	}
+
+	for (const int id : candidates(query)) {
+		if (matches(id, query)) {
+			found.insert(id);
+		}
+	}
+	return found;
+}
+
+/**
+	@brief SearchIndex::matches
+	@param id
+	@param query
+	@return true if the entry id match query
+	@see search
+*/
+bool SearchIndex::matches(int id, const Query &query) const
+{
+	if (id < 0 || id >= m_terms.size() || !query.isValid()) {
+		return false;
+	}
+
+	for (const QString &term : m_terms.at(id))
+	{
+		if (query.whole_word)
+		{
+			if (query.regular_expression.match(term).hasMatch()) {
+				return true;
+			}
+		}
+		else if (term.contains(query.text, query.case_sensitivity)) {
+			return true;
+		}
+	}
+	return false;
+}
+
+/**
+	@brief SearchIndex::indexTerms
+	Add the tokens of terms to the postings of entry id
+	@param id
+	@param terms
+*/
+void SearchIndex::indexTerms(int id, const QStringList &terms)
+{
+	for (const QString &term : terms)
+	{
+		for (const QString &token : tokens(term))
+		{
+			auto it = m_postings.find(token);
+			if (it == m_postings.end())
+			{
+				m_postings.insert(token, QSet<int>{id});
+					//A new token can contain the last searched word
+				m_last_word.clear();
+			}
+			else {
+				it->insert(id);
+			}
+		}
+	}
+}
+
+/**
+	@brief SearchIndex::unindexTerms
+	Remove entry id from the postings of its current terms
+	@param id
+*/
+void SearchIndex::unindexTerms(int id)
+{
+	for (const QString &term : m_terms.at(id))
+	{
+		for (const QString &token : tokens(term))
+		{
+			auto it = m_postings.find(token);
+			if (it == m_postings.end()) {
+				continue;
+			}
+			it->remove(id);
+			if (it->isEmpty()) {
+				m_postings.erase(it);
+			}
+		}
+	}
+}
+
+/**
+	@brief SearchIndex::candidates
+	@param query
+	@return the entries which can match query, according to the tokens.
+	The terms of the candidates must still be compared to the query.
+*/
+QSet<int> SearchIndex::candidates(const Query &query) const
+{
+	const QStringList words = tokens(query.text);
+
+	if (query.whole_word)
+	{
+			//The text is a regular expression,
+			//we can't know the words it match
+		if (words.isEmpty() || hasRegularExpressionChar(query.text)) {
+			return allEntries();
+		}
+
+			//Each word of the text surrounded by \b must be a whole token
+			//of a matching term.
+		QSet<int> candidates_ = m_postings.value(words.first());
+		for (int i = 1 ; i < words.size() && !candidates_.isEmpty() ; ++i) {
+			candidates_.intersect(m_postings.value(words.at(i)));
+		}
+		return candidates_;
+	}
+
+	if (words.isEmpty()) {
+		return allEntries();
+	}
+
+		//A word of the text is always inside a single token of a matching
+		//term, the longest word give the smallest list of tokens.
+	QString word;
+	for (const QString &w : words) {
+		if (w.size() > word.size()) {
+			word = w;
+		}
+	}
+
+	QStringList tokens_;
+	if (!m_last_word.isEmpty() && word.contains(m_last_word))
+	{
+		for (const QString &token : qAsConst(m_last_word_tokens)) {
+			if (token.contains(word)) {
+				tokens_.append(token);
+			}
+		}
+	}
+	else
+	{
+		for (auto it = m_postings.constBegin() ; it != m_postings.constEnd() ; ++it) {
+			if (it.key().contains(word)) {
+				tokens_.append(it.key());
+			}
+		}
+	}
+	m_last_word = word;
+	m_last_word_tokens = tokens_;
+
+	QSet<int> candidates_;
+	for (const QString &token : qAsConst(tokens_)) {
+		candidates_.unite(m_postings.value(token));
+	}
+	return candidates_;
+}
+
+/**
+	@brief SearchIndex::allEntries
+	@return the id of every entries
+*/
+QSet<int> SearchIndex::allEntries() const
+{
+	QSet<int> all;
+	all.reserve(m_terms.size());
+	for (int i = 0 ; i < m_terms.size() ; ++i) {
+		all.insert(i);
+	}
+	return all;
+}
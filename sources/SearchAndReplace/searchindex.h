@@ -0,0 +1,84 @@
+/*
+	Copyright 2006-2025 The QElectroTech Team
+	This file is part of QElectroTech.
+	
+	QElectroTech is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 2 of the License, or
+	(at your option) any later version.
+	
+	QElectroTech is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+	
+	You should have received a copy of the GNU General Public License
+	along with QElectroTech.  If not, see <http://www.gnu.org/licenses/>.
+*/
+#ifndef SEARCHINDEX_H
+#define SEARCHINDEX_H
+
+#include <QHash>
+#include <QRegularExpression>
+#include <QSet>
+#include <QStringList>
+#include <QVector>
+
+/**
+	@brief The SearchIndex class
+	Inverted index of the terms searched by the search and replace widget.
+	Each entry (a folio, an element, a text or a conductor)
+	is a list of terms, the terms are cut in words (tokens)
+	and each lowercase token know the entries where it is used.
+	A search only compare the terms of the entries which
+	have the words of the searched text, instead of every entry.
+*/
+class SearchIndex
+{
+	public:
+		/**
+			@brief The Query struct
+			A searched text with the options of the search
+			@see SearchIndex::query
+		*/
+		struct Query
+		{
+			QString text;
+			bool whole_word = false;
+			Qt::CaseSensitivity case_sensitivity = Qt::CaseInsensitive;
+			QRegularExpression regular_expression;
+
+			bool isValid() const;
+		};
+
+		static Query query(const QString &text,
+				   bool whole_word,
+				   Qt::CaseSensitivity case_sensitivity);
+		static QStringList tokens(const QString &str);
+
+		int addEntry(const QStringList &terms);
+		void setTerms(int id, const QStringList &terms);
+		QStringList terms(int id) const;
+		int count() const;
+		void clear();
+
+		QSet<int> search(const Query &query) const;
+		bool matches(int id, const Query &query) const;
+
+	private:
+		void indexTerms(int id, const QStringList &terms);
+		void unindexTerms(int id);
+		QSet<int> candidates(const Query &query) const;
+		QSet<int> allEntries() const;
+
+		QVector<QStringList> m_terms;
+		QHash<QString, QSet<int>> m_postings;
+
+			//Tokens containing m_last_word, kept to only look at them
+			//when the next searched word contain m_last_word
+			//(the user type the next letter)
+		mutable QString m_last_word;
+		mutable QStringList m_last_word_tokens;
+};
+
+#endif // SEARCHINDEX_H
@@ -17,9 +17,12 @@
 */
 #include "searchandreplacewidget.h"
 
+#include "../../ElementsCollection/elementdefinitioncache.h"
 #include "../../QWidgetAnimation/qwidgetanimation.h"
+#include "../../autoNum/assignvariables.h"
 #include "../../diagram.h"
 #include "../../diagramcontent.h"
+#include "../../project/diagramcontentdata.h"
 #include "../../qetapp.h"
 #include "../../qetdiagrameditor.h"
 #include "../../qetgraphicsitem/conductor.h"
@@ -37,6 +40,8 @@
 #include "ui_searchandreplacewidget.h"
 
 #include <QSettings>
+#include <QTextDocument>
+#include <algorithm>
 
 /**
 	@brief SearchAndReplaceWidget::SearchAndReplaceWidget
@@ -127,6 +132,12 @@ void SearchAndReplaceWidget::clear()
 	qDeleteAll(m_conductor_hash.keys());
 	m_conductor_hash.clear();
 
+	qDeleteAll(m_pending_hash.keys());
+	m_pending_hash.clear();
+	m_pending_element_uuid.clear();
+
+	clearIndex();
+
 	for (QTreeWidgetItem *qtwi : m_category_qtwi)
 		qtwi->setHidden(false);
 
@@ -231,7 +242,11 @@ void SearchAndReplaceWidget::setHideAdvanced(bool hide)
 
 /**
 	@brief SearchAndReplaceWidget::fillItemsList
-	Fill the tree
+	Fill the tree and the search index.
+	The index is kept up to date when the folios, elements,
+	conductors and texts change.
+	The folios not yet materialized are indexed from the content
+	they keep (see addPendingDiagram).
 */
 void SearchAndReplaceWidget::fillItemsList()
 {
@@ -240,6 +255,10 @@ void SearchAndReplaceWidget::fillItemsList()
 
 	qDeleteAll(m_element_hash.keys());
 	m_element_hash.clear();
+	qDeleteAll(m_pending_hash.keys());
+	m_pending_hash.clear();
+	m_pending_element_uuid.clear();
+	clearIndex();
 
 	QETProject *project_ = m_editor->currentProject();
 	if (!project_)
@@ -262,26 +281,30 @@ void SearchAndReplaceWidget::fillItemsList()
 	m_indi_text_qtwi    ->setCheckState(0, Qt::Checked);
 	m_conductor_qtwi    ->setCheckState(0, Qt::Checked);
 
+	const bool folio_label = QSettings().value("genericpanel/folio", true).toBool();
+
 	DiagramContent dc;
+	QHash<QString, ElementData::Type> pending_types;
 	for (Diagram *diagram : project_->diagrams())
 	{
-		QString str;
-
-		QSettings settings;
-		if (settings.value("genericpanel/folio", true).toBool()) {
-			str = diagram->border_and_titleblock.finalfolio();
-		} else {
-			str = QString::number(diagram->folioIndex()+1);
-		}
-
-		str.append(" " + diagram->title());
-
 		QTreeWidgetItem *qtwi = new QTreeWidgetItem(m_folio_qtwi);
-		qtwi->setText(0, str);
-		qtwi->setData(0, Qt::UserRole, searchTerms(diagram));
+		qtwi->setText(0, diagramText(diagram, folio_label));
 		qtwi->setCheckState(0, Qt::Checked);
+		indexItem(qtwi, searchTerms(diagram));
 		m_diagram_hash.insert(qtwi, QPointer<Diagram>(diagram));
-		dc += DiagramContent(diagram, false);
+		if (diagram->isMaterialized()) {
+			dc += DiagramContent(diagram, false);
+		} else {
+			addPendingDiagram(diagram, pending_types);
+		}
+
+		m_index_connections << connect(&diagram->border_and_titleblock,
+					       &BorderTitleBlock::informationChanged,
+					       this, [this, qtwi, diagram, folio_label]()
+		{
+			qtwi->setText(0, diagramText(diagram, folio_label));
+			updateIndexedItem(qtwi, searchTerms(diagram));
+		});
 	}
 
 	for (Element *elmt : dc.m_elements)
@@ -296,24 +319,12 @@ void SearchAndReplaceWidget::fillItemsList()
 	}
 
 	for (IndependentTextItem *iti : dc.m_text_fields)
-	{
-		QTreeWidgetItem *qtwi = new QTreeWidgetItem(m_indi_text_qtwi);
-		qtwi->setText(0, iti->toPlainText());
-		qtwi->setCheckState(0, Qt::Checked);
-		qtwi->setData(0, Qt::UserRole, iti->toPlainText());
-		m_text_hash.insert(qtwi, QPointer<IndependentTextItem>(iti));
-	}
+		addText(iti);
 
 	m_indi_text_qtwi->sortChildren(0, Qt::AscendingOrder);
 
 	for (Conductor *c : dc.m_potential_conductors)
-	{
-		QTreeWidgetItem *qtwi = new QTreeWidgetItem(m_conductor_qtwi);
-		qtwi->setText(0, c->properties().text);
-		qtwi->setCheckState(0, Qt::Checked);
-		qtwi->setData(0, Qt::UserRole, searchTerms(c));
-		m_conductor_hash.insert(qtwi, QPointer<Conductor>(c));
-	}
+		addConductor(c);
 	m_conductor_qtwi->sortChildren(0, Qt::AscendingOrder);
 
 	updateNextPreviousButtons();
@@ -325,61 +336,476 @@ void SearchAndReplaceWidget::fillItemsList()
 	@brief SearchAndReplaceWidget::addElement
 	Add a tree widget item for element
 	@param element
+	@param qtwi : the item of element while its folio
+	was not materialized, if nullptr a new item is created
 */
-void SearchAndReplaceWidget::addElement(Element *element)
+void SearchAndReplaceWidget::addElement(Element *element,
+					QTreeWidgetItem *qtwi)
 {
-	QTreeWidgetItem *parent = m_elements_qtwi;
-	switch (element->linkType()) {
-		case Element::Simple:
-			parent = m_simple_elmt_qtwi;
-			break;
-		case Element::NextReport:
-			parent = m_report_elmt_qtwi;
-			break;
-		case Element::PreviousReport:
-			parent = m_report_elmt_qtwi;
-			break;
-		case Element::Master:
-			parent = m_master_elmt_qtwi;
-			break;
-		case Element::Slave:
-			parent = m_slave_elmt_qtwi;
-			break;
-		case Element::Terminale:
-			parent = m_terminal_elmt_qtwi;
-			break;
-		default:
-			break;
+	if (qtwi)
+	{
+		m_element_hash.insert(qtwi, QPointer<Element>(element));
+		qtwi->setText(0, elementText(element));
+		updateIndexedItem(qtwi, searchTerms(element));
+	}
+	else
+	{
+		QTreeWidgetItem *parent = m_elements_qtwi;
+		switch (element->linkType()) {
+			case Element::Simple:
+				parent = m_simple_elmt_qtwi;
+				break;
+			case Element::NextReport:
+				parent = m_report_elmt_qtwi;
+				break;
+			case Element::PreviousReport:
+				parent = m_report_elmt_qtwi;
+				break;
+			case Element::Master:
+				parent = m_master_elmt_qtwi;
+				break;
+			case Element::Slave:
+				parent = m_slave_elmt_qtwi;
+				break;
+			case Element::Terminale:
+				parent = m_terminal_elmt_qtwi;
+				break;
+			default:
+				break;
+		}
+		qtwi = new QTreeWidgetItem(parent);
+		m_element_hash.insert(qtwi, QPointer<Element>(element));
+
+		qtwi->setText(0, elementText(element));
+		qtwi->setCheckState(0, Qt::Checked);
+		indexItem(qtwi, searchTerms(element));
 	}
-	QTreeWidgetItem *qtwi = new QTreeWidgetItem(parent);
-	m_element_hash.insert(qtwi, QPointer<Element>(element));
 
-	QString str;
-	str += element->elementInformations().value("label").toString();
-	if(!str.isEmpty())
-		str += ("   ");
-	str += element->elementInformations().value("comment").toString();
-	if (str.isEmpty())
-		str = tr("Inconnue");
-	qtwi->setText(0, str);
-	qtwi->setCheckState(0, Qt::Checked);
-	qtwi->setData(0, Qt::UserRole, searchTerms(element));
+	auto update_ = [this, qtwi, element]()
+	{
+		qtwi->setText(0, elementText(element));
+		updateIndexedItem(qtwi, searchTerms(element));
+	};
+	m_index_connections << connect(element, &Element::elementInfoChange,
+				       this, update_);
+
+		//The user and composite texts are also searched
+	QList<DynamicElementTextItem *> texts = element->dynamicTextItems();
+	for (ElementTextItemGroup *group : element->textGroups()) {
+		texts.append(group->texts());
+	}
+	for (DynamicElementTextItem *deti : texts) {
+		m_index_connections << connect(deti, &DynamicElementTextItem::plainTextChanged,
+					       this, update_);
+	}
+}
+
+/**
+	@brief SearchAndReplaceWidget::addConductor
+	Add a tree widget item for conductor
+	@param conductor
+	@param qtwi : the item of conductor while its folio
+	was not materialized, if nullptr a new item is created
+*/
+void SearchAndReplaceWidget::addConductor(Conductor *conductor,
+					  QTreeWidgetItem *qtwi)
+{
+	if (qtwi)
+	{
+		qtwi->setText(0, conductor->properties().text);
+		updateIndexedItem(qtwi, searchTerms(conductor));
+	}
+	else
+	{
+		qtwi = new QTreeWidgetItem(m_conductor_qtwi);
+		qtwi->setText(0, conductor->properties().text);
+		qtwi->setCheckState(0, Qt::Checked);
+		indexItem(qtwi, searchTerms(conductor));
+	}
+	m_conductor_hash.insert(qtwi, QPointer<Conductor>(conductor));
+
+	m_index_connections << connect(conductor, &Conductor::propertiesChange,
+				       this, [this, qtwi, conductor]()
+	{
+		qtwi->setText(0, conductor->properties().text);
+		updateIndexedItem(qtwi, searchTerms(conductor));
+	});
+}
+
+/**
+	@brief SearchAndReplaceWidget::addText
+	Add a tree widget item for the independent text
+	@param text
+	@param qtwi : the item of text while its folio
+	was not materialized, if nullptr a new item is created
+*/
+void SearchAndReplaceWidget::addText(IndependentTextItem *text,
+				     QTreeWidgetItem *qtwi)
+{
+	if (qtwi)
+	{
+		qtwi->setText(0, text->toPlainText());
+		updateIndexedItem(qtwi, QStringList(text->toPlainText()));
+	}
+	else
+	{
+		qtwi = new QTreeWidgetItem(m_indi_text_qtwi);
+		qtwi->setText(0, text->toPlainText());
+		qtwi->setCheckState(0, Qt::Checked);
+		indexItem(qtwi, QStringList(text->toPlainText()));
+	}
+	m_text_hash.insert(qtwi, QPointer<IndependentTextItem>(text));
+
+	m_index_connections << connect(text->document(),
+				       &QTextDocument::contentsChanged,
+				       this, [this, qtwi, text]()
+	{
+		qtwi->setText(0, text->toPlainText());
+		updateIndexedItem(qtwi, QStringList(text->toPlainText()));
+	});
+}
+
+/**
+	@brief SearchAndReplaceWidget::addPendingDiagram
+	Add the tree widget items of the elements, conductors and texts
+	of a folio not yet materialized.
+	The items are indexed from the content kept by the folio
+	(see Diagram::pendingContent), the folio is materialized
+	only when one of these items is used (see materializeItem).
+	@param diagram
+	@param types : the type of the elements already found,
+	shared by the folios of the project
+*/
+void SearchAndReplaceWidget::addPendingDiagram(
+		Diagram *diagram,
+		QHash<QString, ElementData::Type> &types)
+{
+	const DiagramContentData &content = diagram->pendingContent();
+
+	for (const auto &data : content.elements)
+	{
+		if (!types.contains(data.type))
+		{
+			const auto definition = ElementDefinitionCache::instance()
+					->definition(data.location(diagram->project()));
+			types.insert(data.type,
+				     definition ? definition->elementData().m_type
+						: ElementData::Simple);
+		}
+
+		QTreeWidgetItem *parent = m_elements_qtwi;
+		switch (types.value(data.type)) {
+			case ElementData::Simple:
+				parent = m_simple_elmt_qtwi;
+				break;
+			case ElementData::NextReport:
+			case ElementData::PreviousReport:
+				parent = m_report_elmt_qtwi;
+				break;
+			case ElementData::Master:
+				parent = m_master_elmt_qtwi;
+				break;
+			case ElementData::Slave:
+				parent = m_slave_elmt_qtwi;
+				break;
+			case ElementData::Terminal:
+				parent = m_terminal_elmt_qtwi;
+				break;
+			default:
+				break;
+		}
+
+		QTreeWidgetItem *qtwi = new QTreeWidgetItem(parent);
+		qtwi->setText(0, elementText(data.informations));
+		qtwi->setCheckState(0, Qt::Checked);
+		indexItem(qtwi, searchTerms(data));
+		m_pending_hash.insert(qtwi, QPointer<Diagram>(diagram));
+		m_pending_element_uuid.insert(qtwi, data.uuid);
+	}
+
+	for (const auto &data : content.conductors)
+	{
+		QTreeWidgetItem *qtwi = new QTreeWidgetItem(m_conductor_qtwi);
+		qtwi->setText(0, data.properties.text);
+		qtwi->setCheckState(0, Qt::Checked);
+		indexItem(qtwi, searchTerms(data.properties));
+		m_pending_hash.insert(qtwi, QPointer<Diagram>(diagram));
+	}
+
+	QTextDocument document;
+	for (const auto &html : content.texts_html)
+	{
+			//Same plain text as IndependentTextItem::toPlainText
+		document.setHtml(html);
+		QTreeWidgetItem *qtwi = new QTreeWidgetItem(m_indi_text_qtwi);
+		qtwi->setText(0, document.toPlainText());
+		qtwi->setCheckState(0, Qt::Checked);
+		indexItem(qtwi, QStringList(document.toPlainText()));
+		m_pending_hash.insert(qtwi, QPointer<Diagram>(diagram));
+	}
+}
+
+/**
+	@brief SearchAndReplaceWidget::materializeItem
+	Materialize the folio of item if item is the item of an element,
+	a conductor or a text of a folio not yet materialized.
+	@param item
+	@return false if item was removed because it's not found
+	in the materialized folio, true otherwise.
+*/
+bool SearchAndReplaceWidget::materializeItem(QTreeWidgetItem *item)
+{
+	if (!m_pending_hash.contains(item)) {
+		return true;
+	}
+
+	QPointer<Diagram> diagram = m_pending_hash.value(item);
+	if (diagram) {
+		materializeDiagramItems(diagram.data());
+	}
+	return m_item_id.contains(item);
+}
+
+/**
+	@brief SearchAndReplaceWidget::materializeSelectedItems
+	Materialize the folios of the visible and selected items,
+	used before replace all the selected items.
+*/
+void SearchAndReplaceWidget::materializeSelectedItems()
+{
+	QSet<Diagram *> diagrams;
+	for (auto it = m_pending_hash.constBegin() ;
+	     it != m_pending_hash.constEnd() ;
+	     ++it)
+	{
+		if (it.value()
+				&& !it.key()->isHidden()
+				&& it.key()->checkState(0) == Qt::Checked) {
+			diagrams.insert(it.value().data());
+		}
+	}
+
+	for (Diagram *diagram : qAsConst(diagrams)) {
+		materializeDiagramItems(diagram);
+	}
+}
+
+/**
+	@brief SearchAndReplaceWidget::materializeDiagramItems
+	Materialize diagram and give to the items of its elements,
+	conductors and texts the graphics item they represent.
+	The elements are found by their uuid, the conductors and texts
+	which have no uuid are found by their search terms.
+	@param diagram
+*/
+void SearchAndReplaceWidget::materializeDiagramItems(Diagram *diagram)
+{
+	diagram->project()->materializeDiagram(diagram);
+	if (!diagram->isMaterialized()) {
+		return;
+	}
+
+	disconnect(ui->m_tree_widget, &QTreeWidget::itemChanged,
+		   this, &SearchAndReplaceWidget::itemChanged);
+
+	DiagramContent dc(diagram, false);
+	QHash<QUuid, Element *> elements;
+	for (Element *elmt : qAsConst(dc.m_elements)) {
+		elements.insert(elmt->uuid(), elmt);
+	}
+	QList<Conductor *> conductors = dc.m_potential_conductors;
+	QList<IndependentTextItem *> texts = dc.m_text_fields.values();
+
+	const auto items = m_pending_hash.keys(QPointer<Diagram>(diagram));
+	for (QTreeWidgetItem *qtwi : items)
+	{
+		m_pending_hash.remove(qtwi);
+		const QStringList terms = m_index.terms(m_item_id.value(qtwi, -1));
+
+		if (m_pending_element_uuid.contains(qtwi))
+		{
+			if (Element *elmt = elements.take(m_pending_element_uuid.take(qtwi))) {
+				addElement(elmt, qtwi);
+			} else {
+				removeIndexedItem(qtwi);
+			}
+		}
+		else if (qtwi->parent() == m_conductor_qtwi)
+		{
+			auto found = std::find_if(conductors.begin(), conductors.end(),
+						  [&terms](Conductor *c) {
+				return searchTerms(c) == terms;
+			});
+			if (found != conductors.end()) {
+				addConductor(*found, qtwi);
+				conductors.erase(found);
+			} else {
+				removeIndexedItem(qtwi);
+			}
+		}
+		else
+		{
+			auto found = std::find_if(texts.begin(), texts.end(),
+						  [&terms](IndependentTextItem *iti) {
+				return QStringList(iti->toPlainText()) == terms;
+			});
+			if (found != texts.end()) {
+				addText(*found, qtwi);
+				texts.erase(found);
+			} else {
+				removeIndexedItem(qtwi);
+			}
+		}
+	}
+
+		//The items not found in the content kept by the folio
+	for (Element *elmt : qAsConst(elements)) {
+		addElement(elmt);
+	}
+	for (Conductor *c : qAsConst(conductors)) {
+		addConductor(c);
+	}
+	for (IndependentTextItem *iti : qAsConst(texts)) {
+		addText(iti);
+	}
+
+	connect(ui->m_tree_widget, &QTreeWidget::itemChanged,
+		this, &SearchAndReplaceWidget::itemChanged);
+}
+
+/**
+	@brief SearchAndReplaceWidget::removeIndexedItem
+	Remove item from the tree and from the search index,
+	the id of item in the index is not reused.
+	@param item
+*/
+void SearchAndReplaceWidget::removeIndexedItem(QTreeWidgetItem *item)
+{
+	const int id = m_item_id.take(item);
+	if (id < 0 || id >= m_indexed_items.size()
+			|| m_indexed_items.at(id) != item) {
+		return;
+	}
+
+	m_index.setTerms(id, QStringList());
+	m_shown_ids.remove(id);
+	m_indexed_items[id] = nullptr;
+	delete item;
+}
+
+/**
+	@brief SearchAndReplaceWidget::clearIndex
+	Clear the search index and stop to follow the changes of the items
+*/
+void SearchAndReplaceWidget::clearIndex()
+{
+	for (const auto &connection : qAsConst(m_index_connections)) {
+		disconnect(connection);
+	}
+	m_index_connections.clear();
+
+	m_index.clear();
+	m_indexed_items.clear();
+	m_item_id.clear();
+	m_shown_ids.clear();
+}
+
+/**
+	@brief SearchAndReplaceWidget::indexItem
+	Add item to the search index.
+	item is hidden if it doesn't match the current search.
+	@param item : a new item, visible
+	@param terms : the terms searched for item
+	@return the id of item in the index
+*/
+int SearchAndReplaceWidget::indexItem(QTreeWidgetItem *item,
+				      const QStringList &terms)
+{
+	const int id = m_index.addEntry(terms);
+	m_indexed_items.append(item);
+	m_item_id.insert(item, id);
+
+	if (ui->m_search_le->text().isEmpty()) {
+		m_shown_ids.insert(id);
+	} else if (m_index.matches(id, currentQuery())) {
+		m_shown_ids.insert(id);
+		setVisibleAllParents(item);
+	} else {
+		item->setHidden(true);
+	}
+	return id;
+}
+
+/**
+	@brief SearchAndReplaceWidget::updateIndexedItem
+	Update the terms of item in the search index
+	and show or hide item according to the current search.
+	@param item
+	@param terms
+*/
+void SearchAndReplaceWidget::updateIndexedItem(QTreeWidgetItem *item,
+					       const QStringList &terms)
+{
+	const int id = m_item_id.value(item, -1);
+	if (id < 0) {
+		return;
+	}
+
+	m_index.setTerms(id, terms);
+
+	if (ui->m_search_le->text().isEmpty()) {
+		return;
+	}
+
+	if (m_index.matches(id, currentQuery()))
+	{
+		if (!m_shown_ids.contains(id))
+		{
+			m_shown_ids.insert(id);
+			item->setHidden(false);
+			setVisibleAllParents(item);
+		}
+	}
+	else if (m_shown_ids.remove(id)) {
+		item->setHidden(true);
+	}
+}
+
+/**
+	@brief SearchAndReplaceWidget::currentQuery
+	@return the search query according to the search line edit
+	and the search options
+*/
+SearchIndex::Query SearchAndReplaceWidget::currentQuery() const
+{
+	return SearchIndex::query(ui->m_search_le->text(),
+				  ui->m_mode_cb->currentIndex() != 0,
+				  ui->m_case_sensitive_cb->isChecked()
+				  ? Qt::CaseSensitive
+				  : Qt::CaseInsensitive);
 }
 
 /**
 	@brief SearchAndReplaceWidget::search
-	Start the search
+	Start the search.
+	The matching items are found with the search index,
+	and only the items which change of state are shown or hidden.
 */
 void SearchAndReplaceWidget::search()
 {
 	QString str = ui->m_search_le->text();
 	if(str.isEmpty())
 	{
-		for (QTreeWidgetItemIterator it(m_root_qtwi) ; *it ; ++it) {
-			(*it)->setHidden(false);
+		for (int id = 0 ; id < m_indexed_items.size() ; ++id) {
+				//The removed items are null
+			if (!m_shown_ids.contains(id) && m_indexed_items.at(id)) {
+				m_indexed_items.at(id)->setHidden(false);
+				m_shown_ids.insert(id);
+			}
 		}
 
 		for (QTreeWidgetItem *item : m_category_qtwi) {
+			item->setHidden(false);
 			item->setExpanded(false);
 		}
 		m_root_qtwi->setExpanded(true);
@@ -389,60 +815,50 @@ void SearchAndReplaceWidget::search()
 	}
 	else
 	{
-		for (QTreeWidgetItemIterator it(m_root_qtwi) ; *it ; ++it) {
-			(*it)->setHidden(true);
+		const SearchIndex::Query query = currentQuery();
+		if (!query.isValid())
+		{
+			qWarning() <<QObject::tr("this is an error in the code")
+				  << query.regular_expression.errorString()
+				  << query.regular_expression.patternErrorOffset();
+			return;
 		}
 
-		bool match = false;
+		const QSet<int> found = m_index.search(query);
 
-			//Extended search,
-			//on each string stored in column 0 with role : UserRole
-		QList<QTreeWidgetItem *> qtwi_list;
-		qtwi_list.append(m_diagram_hash.keys());
-		qtwi_list.append(m_element_hash.keys());
-		qtwi_list.append(m_text_hash.keys());
-		qtwi_list.append(m_conductor_hash.keys());
-		for (QTreeWidgetItem *qtwi : qtwi_list)
+			//Only change the items which change of state
+		for (const int id : qAsConst(m_shown_ids)) {
+			if (!found.contains(id)) {
+				m_indexed_items.at(id)->setHidden(true);
+			}
+		}
+		QSet<QTreeWidgetItem *> visible_parents;
+		for (const int id : found)
 		{
-			QStringList list = qtwi->data(0, Qt::UserRole)
-					.toStringList();
-
-			if(ui->m_mode_cb->currentIndex() == 0)
-			{
-					//Contain string
-				list = list.filter(
-					str,
-					ui->m_case_sensitive_cb->isChecked()
-							? Qt::CaseSensitive
-							: Qt::CaseInsensitive);
+			QTreeWidgetItem *qtwi = m_indexed_items.at(id);
+			if (!m_shown_ids.contains(id)) {
+				qtwi->setHidden(false);
 			}
-			else
-			{
-					//entire word
-				QRegularExpression rx("\\b" + str + "\\b");
-				if (!rx.isValid())
-					{
-					qWarning() <<QObject::tr("this is an error in the code")
-						  << rx.errorString()
-						  << rx.patternErrorOffset();
-					return;
-				}
-				if (!ui->m_case_sensitive_cb->isChecked()) {
-					rx.setPatternOptions(
-					QRegularExpression::CaseInsensitiveOption);
-				}
-				list = list.filter(rx);
+			for (QTreeWidgetItem *parent = qtwi->parent() ;
+			     parent && !visible_parents.contains(parent) ;
+			     parent = parent->parent()) {
+				visible_parents.insert(parent);
 			}
-			if (!list.isEmpty())
-			{
-				match = true;
-				qtwi->setHidden(false);
-				setVisibleAllParents(qtwi);
+		}
+		m_shown_ids = found;
+
+			//A category is visible if it have a matching item
+		for (QTreeWidgetItem *item : m_category_qtwi)
+		{
+			const bool visible = visible_parents.contains(item);
+			item->setHidden(!visible);
+			if (visible) {
+				item->setExpanded(true);
 			}
 		}
 
 		QPalette background = ui->m_search_le->palette();
-		background.setColor(QPalette::Base, match
+		background.setColor(QPalette::Base, !found.isEmpty()
 				    ? QColor("#E0FFF0")
 				    : QColor("#FFE0EF"));
 		ui->m_search_le->setPalette(background);
@@ -485,34 +901,53 @@ void SearchAndReplaceWidget::setUpConenctions()
 		}
 	});
 
+		//The items of a folio not yet materialized are in m_pending_hash
 	connect(m_select_elements, &QAction::triggered, [this]()
 	{
-		DiagramContent dc(m_diagram_hash.value(ui->m_tree_widget->currentItem()), false);
+		const auto diagram = m_diagram_hash.value(ui->m_tree_widget->currentItem());
+		DiagramContent dc(diagram, false);
 		for (auto elmt : dc.m_elements) {
 			if (auto item = m_element_hash.key(elmt)) {
 				item->setCheckState(0, Qt::Checked);
 			}
 		}
+		for (auto item : m_pending_hash.keys(diagram)) {
+			if (m_pending_element_uuid.contains(item)) {
+				item->setCheckState(0, Qt::Checked);
+			}
+		}
 	});
 
 	connect(m_select_conductors, &QAction::triggered, [this]()
 	{
-		DiagramContent dc(m_diagram_hash.value(ui->m_tree_widget->currentItem()), false);
+		const auto diagram = m_diagram_hash.value(ui->m_tree_widget->currentItem());
+		DiagramContent dc(diagram, false);
 		for (auto cond : dc.conductors()) {
 			if (auto item = m_conductor_hash.key(cond)) {
 				item->setCheckState(0, Qt::Checked);
 			}
 		}
+		for (auto item : m_pending_hash.keys(diagram)) {
+			if (item->parent() == m_conductor_qtwi) {
+				item->setCheckState(0, Qt::Checked);
+			}
+		}
 	});
 
 	connect(m_select_texts, &QAction::triggered, [this]()
 	{
-		DiagramContent dc(m_diagram_hash.value(ui->m_tree_widget->currentItem()), false);
+		const auto diagram = m_diagram_hash.value(ui->m_tree_widget->currentItem());
+		DiagramContent dc(diagram, false);
 		for (auto text : dc.m_text_fields) {
 			if (auto item = m_text_hash.key(text)) {
 				item->setCheckState(0, Qt::Checked);
 			}
 		}
+		for (auto item : m_pending_hash.keys(diagram)) {
+			if (item->parent() == m_indi_text_qtwi) {
+				item->setCheckState(0, Qt::Checked);
+			}
+		}
 	});
 }
 
@@ -908,15 +1343,54 @@ QStringList SearchAndReplaceWidget::searchTerms(Element *element)
 	return list;
 }
 
+/**
+	@brief SearchAndReplaceWidget::searchTerms
+	@param data : an element of a folio not yet materialized
+	@return All QString use as terms for search,
+	the same as searchTerms(Element *) once the folio is materialized.
+*/
+QStringList SearchAndReplaceWidget::searchTerms(const ElementContentData &data)
+{
+	QStringList list;
+	for (QString key : QETInformation::elementInfoKeys())
+	{
+		QString str = data.informations.value(key).toString();
+		if (!str.isEmpty()) {
+			list.append(str);
+		}
+	}
+
+	list.append(data.userTexts());
+	for (const auto &text : data.texts) {
+		if (text.text_from == QLatin1String("CompositeText")) {
+			list.append(autonum::AssignVariables::replaceVariable(
+					    text.composite_text,
+					    data.informations));
+		}
+	}
+
+	return list;
+}
+
 /**
 	@brief SearchAndReplaceWidget::searchTerms
 	@param conductor
 	@return all QString use as terms for search.
 */
 QStringList SearchAndReplaceWidget::searchTerms(Conductor *conductor)
+{
+	return searchTerms(conductor->properties());
+}
+
+/**
+	@brief SearchAndReplaceWidget::searchTerms
+	@param properties : the properties of a conductor
+	@return all QString use as terms for search.
+*/
+QStringList SearchAndReplaceWidget::searchTerms(
+		const ConductorProperties &properties)
 {
 	QStringList list;
-	ConductorProperties properties = conductor->properties();
 
 	list.append(properties.text);
 	list.append(properties.m_function);
@@ -927,6 +1401,54 @@ QStringList SearchAndReplaceWidget::searchTerms(Conductor *conductor)
 	return list;
 }
 
+/**
+	@brief SearchAndReplaceWidget::diagramText
+	@param diagram
+	@param folio_label : true to use the folio label of the title block,
+	false to use the index of the folio
+	@return the text of the tree item of diagram
+*/
+QString SearchAndReplaceWidget::diagramText(Diagram *diagram,
+					    bool folio_label)
+{
+	QString str;
+	if (folio_label) {
+		str = diagram->border_and_titleblock.finalfolio();
+	} else {
+		str = QString::number(diagram->folioIndex()+1);
+	}
+
+	str.append(" " + diagram->title());
+	return str;
+}
+
+/**
+	@brief SearchAndReplaceWidget::elementText
+	@param element
+	@return the text of the tree item of element
+*/
+QString SearchAndReplaceWidget::elementText(Element *element)
+{
+	return elementText(element->elementInformations());
+}
+
+/**
+	@brief SearchAndReplaceWidget::elementText
+	@param informations : the informations of an element
+	@return the text of the tree item of the element
+*/
+QString SearchAndReplaceWidget::elementText(const DiagramContext &informations)
+{
+	QString str;
+	str += informations.value("label").toString();
+	if(!str.isEmpty())
+		str += ("   ");
+	str += informations.value("comment").toString();
+	if (str.isEmpty())
+		str = tr("Inconnue");
+	return str;
+}
+
 /**
 	@brief SearchAndReplaceWidget::on_m_quit_button_clicked
 */
@@ -951,6 +1473,18 @@ void SearchAndReplaceWidget::on_m_tree_widget_itemDoubleClicked(
 {
 	Q_UNUSED(column)
 
+		//A result of a folio not yet materialized is opened,
+		//the folio is materialized and the item highlighted
+	if (m_pending_hash.contains(item))
+	{
+		if (!materializeItem(item)) {
+			return;
+		}
+		if (item == ui->m_tree_widget->currentItem()) {
+			on_m_tree_widget_currentItemChanged(item, nullptr);
+		}
+	}
+
 	if (m_diagram_hash.keys().contains(item))
 	{
 		QPointer<Diagram> diagram = m_diagram_hash.value(item);
@@ -1141,7 +1675,8 @@ void SearchAndReplaceWidget::on_m_replace_pb_clicked()
 		return;
 	}
 	if (!m_category_qtwi.contains(qtwi)
-			&& qtwi->checkState(0) == Qt::Checked)
+			&& qtwi->checkState(0) == Qt::Checked
+			&& materializeItem(qtwi))
 	{
 		if (ui->m_folio_pb->text().endsWith(tr(" [édité]")) &&
 			m_diagram_hash.keys().contains(qtwi))
@@ -1234,6 +1769,14 @@ void SearchAndReplaceWidget::on_m_replace_pb_clicked()
 */
 void SearchAndReplaceWidget::on_m_replace_all_pb_clicked()
 {
+		//Only the folios of the selected items are materialized
+	if (ui->m_element_pb->text().endsWith(tr(" [édité]"))
+			|| !ui->m_replace_le->text().isEmpty()
+			|| ui->m_conductor_pb->text().endsWith(tr(" [édité]"))
+			|| ui->m_advanced_replace_pb->text().endsWith(tr(" [édité]"))) {
+		materializeSelectedItems();
+	}
+
 	if (ui->m_folio_pb->text().endsWith(tr(" [édité]"))) {
 		m_worker.replaceDiagram(selectedDiagram());
 	}
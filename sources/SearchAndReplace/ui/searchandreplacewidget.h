@@ -22,6 +22,7 @@
 #include "../../qetgraphicsitem/element.h"
 #include "../../qetgraphicsitem/independenttextitem.h"
 #include "../searchandreplaceworker.h"
+#include "../searchindex.h"
 
 #include <QTreeWidgetItemIterator>
 #include <QWidget>
@@ -29,6 +30,9 @@
 class QTreeWidgetItem;
 class QETDiagramEditor;
 class QAction;
+class ConductorProperties;
+class DiagramContext;
+struct ElementContentData;
 
 namespace Ui {
 	class SearchAndReplaceWidget;
@@ -52,7 +56,22 @@ class SearchAndReplaceWidget : public QWidget
 		void setUpTreeItems();
 		void setHideAdvanced(bool hide);
 		void fillItemsList();
-		void addElement(Element *element);
+		void addElement(Element *element, QTreeWidgetItem *qtwi = nullptr);
+		void addConductor(Conductor *conductor,
+				  QTreeWidgetItem *qtwi = nullptr);
+		void addText(IndependentTextItem *text,
+			     QTreeWidgetItem *qtwi = nullptr);
+		void addPendingDiagram(Diagram *diagram,
+				       QHash<QString, ElementData::Type> &types);
+		bool materializeItem(QTreeWidgetItem *item);
+		void materializeSelectedItems();
+		void materializeDiagramItems(Diagram *diagram);
+		void removeIndexedItem(QTreeWidgetItem *item);
+		void clearIndex();
+		int indexItem(QTreeWidgetItem *item, const QStringList &terms);
+		void updateIndexedItem(QTreeWidgetItem *item,
+				       const QStringList &terms);
+		SearchIndex::Query currentQuery() const;
 		void search();
 		void setUpActions();
 		void setUpConenctions();
@@ -85,8 +104,13 @@ class SearchAndReplaceWidget : public QWidget
 		
 		static QStringList searchTerms(Diagram *diagram);
 		static QStringList searchTerms(Element *element);
+		static QStringList searchTerms(const ElementContentData &data);
 		static QStringList searchTerms(Conductor *conductor);
+		static QStringList searchTerms(const ConductorProperties &properties);
 		static QStringList searchTerms(QString str);
+		static QString diagramText(Diagram *diagram, bool folio_label);
+		static QString elementText(Element *element);
+		static QString elementText(const DiagramContext &informations);
 		
 	private slots:
 		void on_m_quit_button_clicked();
@@ -130,7 +154,20 @@ class SearchAndReplaceWidget : public QWidget
 		QPointer<Element> m_highlighted_element;
 		QPointer<QGraphicsObject> m_last_selected;
 		QHash<QTreeWidgetItem *, QPointer <Diagram>> m_diagram_hash;
+			//Items of the elements, conductors and texts of the folios
+			//not yet materialized, they are indexed from the content
+			//kept by the folio and moved to the hashes above when
+			//the folio is materialized (see materializeDiagramItems)
+		QHash<QTreeWidgetItem *, QPointer <Diagram>> m_pending_hash;
+		QHash<QTreeWidgetItem *, QUuid> m_pending_element_uuid;
 		SearchAndReplaceWorker m_worker;
+			//Search terms of the items, the id of an item in m_index
+			//is its index in m_indexed_items
+		SearchIndex m_index;
+		QVector<QTreeWidgetItem *> m_indexed_items;
+		QHash<QTreeWidgetItem *, int> m_item_id;
+		QSet<int> m_shown_ids;
+		QList<QMetaObject::Connection> m_index_connections;
 		QWidgetAnimation *m_vertical_animation;
 		QWidgetAnimation *m_horizontal_animation;
 
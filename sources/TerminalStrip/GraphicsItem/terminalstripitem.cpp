@@ -35,7 +35,15 @@ TerminalStripItem::TerminalStripItem(QPointer<TerminalStrip> strip,
 {
 	setFlags(QGraphicsItem::ItemIsMovable | QGraphicsItem::ItemIsSelectable);
 	setAcceptHoverEvents(true);
+	if (m_strip)
+	{
+		m_strip_connections << connect(m_strip.data(), &TerminalStrip::orderChanged,
+					       this, &TerminalStripItem::updateGeometry);
+		m_strip_connections << connect(m_strip.data(), &TerminalStrip::bridgeChanged,
+					       this, &TerminalStripItem::updateGeometry);
+	}
 	setDefaultLayout();
+	updateGeometry();
 }
 
 TerminalStripItem::TerminalStripItem(QGraphicsItem *parent) :
@@ -43,18 +51,34 @@ TerminalStripItem::TerminalStripItem(QGraphicsItem *parent) :
 {
 	setFlags(QGraphicsItem::ItemIsMovable | QGraphicsItem::ItemIsSelectable);
 	setAcceptHoverEvents(true);
+	updateGeometry();
 }
 
 void TerminalStripItem::setTerminalStrip(TerminalStrip *strip)
 {
+	for (const auto &connection : qAsConst(m_strip_connections)) {
+		disconnect(connection);
+	}
+	m_strip_connections.clear();
+
 	m_strip = strip;
 	m_drawer.setStrip(QSharedPointer<TerminalStripDrawer::TrueTerminalStrip> {
 						  new TerminalStripDrawer::TrueTerminalStrip { strip }});
 	m_pending_strip_uuid = QUuid();
 
+		//The width of the drawing depend of the terminals of the strip
+	if (strip)
+	{
+		m_strip_connections << connect(strip, &TerminalStrip::orderChanged,
+					       this, &TerminalStripItem::updateGeometry);
+		m_strip_connections << connect(strip, &TerminalStrip::bridgeChanged,
+					       this, &TerminalStripItem::updateGeometry);
+	}
+
 	if (!m_drawer.haveLayout()) {
 		setDefaultLayout();
 	}
+	updateGeometry();
 }
 
 /**
@@ -79,11 +103,28 @@ void TerminalStripItem::paint(QPainter *painter, const QStyleOptionGraphicsItem
 }
 
 QRectF TerminalStripItem::boundingRect() const
+{
+	return m_bounding_rect;
+}
+
+/**
+ * @brief TerminalStripItem::updateGeometry
+ * Update the bounding rect of this item from the drawer.
+ * Must be called each time the strip or the layout drawn
+ * by this item change, else the index of the scene keep
+ * an obsolete bounding rect of this item.
+ */
+void TerminalStripItem::updateGeometry()
 {
 	auto br_ = m_drawer.boundingRect();
 	br_.adjust(-5,-5,5,5);
 
-	return br_;
+	if (br_ != m_bounding_rect)
+	{
+		prepareGeometryChange();
+		m_bounding_rect = br_;
+	}
+	update();
 }
 
 /**
@@ -122,11 +163,13 @@ void TerminalStripItem::refreshPending()
 void TerminalStripItem::setLayout(QSharedPointer<TerminalStripLayoutPattern> layout)
 {
 	m_drawer.setLayout(layout);
+	updateGeometry();
 }
 
 void TerminalStripItem::setDefaultLayout()
 {
 	if (m_strip && m_strip->project()) {
 		m_drawer.setLayout(m_strip->project()->projectPropertiesHandler().terminalStripLayoutHandler().defaultLayout());
+		updateGeometry();
 	}
 }
@@ -49,6 +49,7 @@ class TerminalStripItem : public QetGraphicsItem
 		void mouseDoubleClickEvent(QGraphicsSceneMouseEvent *event) override;
 		void refreshPending();
 		void setLayout(QSharedPointer<TerminalStripLayoutPattern> layout);
+		void updateGeometry();
 
 	private:
 		void setDefaultLayout();
@@ -57,6 +58,8 @@ class TerminalStripItem : public QetGraphicsItem
 		QPointer<TerminalStrip> m_strip;
 		TerminalStripDrawer::TerminalStripDrawer m_drawer;
 		QUuid m_pending_strip_uuid;
+		QRectF m_bounding_rect;
+		QList<QMetaObject::Connection> m_strip_connections;
 
 };
 
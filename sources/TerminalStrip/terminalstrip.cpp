@@ -1011,9 +1011,14 @@ bool TerminalStrip::fromXml(QDomElement &xml_element)
 	auto xml_layout = xml_element.firstChildElement(QStringLiteral("layout"));
 	if (!xml_layout.isNull())
 	{
-			//Get all free elements terminal of the project
+			//Get all free elements terminal of the project, indexed by uuid
 		const ElementProvider ep(m_project);
-		auto free_terminals = ep.freeTerminal();
+		QHash<QUuid, TerminalElement *> free_terminals;
+		for (const auto &terminal_elmt : ep.freeTerminal()) {
+			if (!free_terminals.contains(terminal_elmt->uuid())) {
+				free_terminals.insert(terminal_elmt->uuid(), terminal_elmt);
+			}
+		}
 
 			//Read each physical terminal
 		for(auto &xml_physical : QETXML::findInDomElement(xml_layout, PhysicalTerminal::xmlTagName()))
@@ -1024,16 +1029,9 @@ bool TerminalStrip::fromXml(QDomElement &xml_element)
 			for (auto &xml_real : QETXML::findInDomElement(xml_physical, RealTerminal::xmlTagName()))
 			{
 				const auto uuid_ = QUuid(xml_real.attribute(QStringLiteral("element_uuid")));
-				for (auto terminal_elmt : qAsConst(free_terminals))
-				{
-					if (terminal_elmt->uuid() == uuid_)
-					{
-						real_t_vector.append(terminal_elmt->realTerminal());
-							//Remove the actual terminal element from the vector, they dicrease the size
-							//of the vector and so each iteration have less terminal element to check
-						free_terminals.removeOne(terminal_elmt);
-						break;
-					}
+					//Take the terminal element, a terminal element can be used only once
+				if (auto terminal_elmt = free_terminals.take(uuid_)) {
+					real_t_vector.append(terminal_elmt->realTerminal());
 				}
 			}
 
@@ -19,6 +19,8 @@
 #include "../../../qeticons.h"
 #include "../terminalstriplayouteditor.h"
 #include "../../../qetproject.h"
+#include "../../../diagram.h"
+#include "../../GraphicsItem/terminalstripitem.h"
 
 #include <QVBoxLayout>
 
@@ -37,6 +39,24 @@ QIcon TerminalStripProjectConfigPage::icon() const {
 	return QET::Icons::TerminalStrip;
 }
 
+/**
+ * @brief TerminalStripProjectConfigPage::applyProjectConf
+ * The layout is edited in place by the layout editor,
+ * update the geometry of every terminal strip item drawn with it.
+ */
+void TerminalStripProjectConfigPage::applyProjectConf()
+{
+	for (const auto &diagram : project()->diagrams())
+	{
+		for (const auto &item : diagram->items())
+		{
+			if (item->type() == TerminalStripItem::Type) {
+				static_cast<TerminalStripItem *>(item)->updateGeometry();
+			}
+		}
+	}
+}
+
 void TerminalStripProjectConfigPage::initWidgets()
 {
 	m_layout_editor = new TerminalStripLayoutEditor{ project()->projectPropertiesHandler().terminalStripLayoutHandler().defaultLayout(),
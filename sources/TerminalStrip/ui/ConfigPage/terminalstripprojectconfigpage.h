@@ -31,7 +31,7 @@ class TerminalStripProjectConfigPage : public ProjectConfigPage
 		QString title() const override;
 		QIcon icon() const override;
 
-		void applyProjectConf() override {}
+		void applyProjectConf() override;
 
 	protected:
 		void initWidgets() override;
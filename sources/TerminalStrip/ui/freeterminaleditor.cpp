@@ -21,6 +21,7 @@
 #include "../undocommand/changeelementdatacommand.h"
 #include "../../diagram.h"
 #include "../../elementprovider.h"
+#include "../../qetproject.h"
 #include "freeterminalmodel.h"
 #include "../terminalstrip.h"
 #include "../UndoCommand/addterminaltostripcommand.h"
@@ -111,6 +112,7 @@ void FreeTerminalEditor::apply()
 	const auto modified_data = m_model->modifiedModelRealTerminalData();
 	if (modified_data.size())
 	{
+		ProjectBatchScope batch(m_project);
 		m_project->undoStack()->beginMacro(tr("Modifier des propriétés de borniers"));
 
 		for (const auto &data_ : modified_data)
@@ -23,6 +23,7 @@
 #include "../../qetgraphicsitem/terminalelement.h"
 #include "../realterminal.h"
 #include "../../qetinformation.h"
+#include "../../qetproject.h"
 
 const int LABEL_CELL = 0;
 const int XREF_CELL = 1;
@@ -305,6 +306,7 @@ QVector<QSharedPointer<RealTerminal> > FreeTerminalModel::realTerminalForIndex(c
  */
 void FreeTerminalModel::fillTerminalVector()
 {
+	m_project->materializeDiagrams(ElementData::Terminal);
 	ElementProvider provider_(m_project);
 	auto free_terminal_vector = provider_.freeTerminal();
 
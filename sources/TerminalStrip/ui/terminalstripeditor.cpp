@@ -193,6 +193,7 @@ void TerminalStripEditor::apply()
 
 	if (m_current_strip)
 	{
+		ProjectBatchScope batch(m_project);
 		m_project->undoStack()->beginMacro(tr("Modifier des propriétés de borniers"));
 
 		TerminalStripData data;
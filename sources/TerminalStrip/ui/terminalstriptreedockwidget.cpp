@@ -307,6 +307,7 @@ QTreeWidgetItem* TerminalStripTreeDockWidget::addTerminalStrip(TerminalStrip *te
  */
 void TerminalStripTreeDockWidget::addFreeTerminal()
 {
+	m_project->materializeDiagrams(ElementData::Terminal);
 	ElementProvider ep(m_project);
 	auto vector_ = ep.freeTerminal();
 
@@ -23,6 +23,8 @@
 #include "../qetgraphicsitem/conductor.h"
 #include "../qetgraphicsitem/element.h"
 #include "../qetxml.h"
+#include "../utils/qetsettings.h"
+#include "compiledformula.h"
 
 #include <QStringList>
 #include <QVariant>
@@ -186,12 +188,59 @@ namespace autonum
 		@param diagram - the diagram where occure the formula.
 		@param elmt - parent element (if any) of the formula
 		@return the string with variable assigned.
+		The label is computed in one pass by a CompiledFormula,
+		the successive replacements are only done when a value
+		of a variable is itself a formula.
 	*/
 	QString AssignVariables::formulaToLabel(QString formula,
 						sequentialNumbers &seqStruct,
 						Diagram *diagram,
 						const Element *elmt,
 						const Conductor *cndr)
+	{
+		if (diagram)
+		{
+				//%F is replaced before compile the formula,
+				//because the folio is often itself a formula (e.g "%id")
+			QString compiled_formula = formula;
+			if (compiled_formula.contains(QStringLiteral("%F"))) {
+				compiled_formula.replace(QStringLiteral("%F"),
+							 diagram->border_and_titleblock.folio());
+			}
+
+			bool ok = false;
+			const QString label = CompiledFormula::compile(compiled_formula)->toLabel(
+						      seqStruct, diagram, elmt, cndr, &ok);
+			if (ok) {
+				return label;
+			}
+		}
+
+		return formulaToLabelSequentially(std::move(formula),
+						  seqStruct,
+						  diagram,
+						  elmt,
+						  cndr);
+	}
+
+	/**
+		@brief AssignVariables::formulaToLabelSequentially
+		Same as formulaToLabel, but the variables are replaced
+		one after the other, the value of a variable can use
+		the variables replaced after it.
+		Used when it matters, and as reference to check CompiledFormula.
+		@param formula
+		@param seqStruct
+		@param diagram
+		@param elmt
+		@param cndr
+		@return the string with variable assigned.
+	*/
+	QString AssignVariables::formulaToLabelSequentially(QString formula,
+							    sequentialNumbers &seqStruct,
+							    Diagram *diagram,
+							    const Element *elmt,
+							    const Conductor *cndr)
 	{
 		AssignVariables av(std::move(formula),
 				   seqStruct,
@@ -212,6 +261,28 @@ namespace autonum
 	*/
 	QString AssignVariables::replaceVariable(const QString &formula,
 						 const DiagramContext &dc)
+	{
+		bool ok = false;
+		const QString str = CompiledFormula::compile(formula)->replaceVariable(
+					    dc, &ok);
+		if (ok) {
+			return str;
+		}
+		return replaceVariableSequentially(formula, dc);
+	}
+
+	/**
+		@brief AssignVariables::replaceVariableSequentially
+		Replace the variables one after the other,
+		the value of a variable can use the variables replaced after it.
+		Used when it matters, see CompiledFormula::replaceVariable,
+		and as reference to check CompiledFormula.
+		@param formula
+		@param dc
+		@return
+	*/
+	QString AssignVariables::replaceVariableSequentially(const QString &formula,
+							     const DiagramContext &dc)
 	{
 		QString str = formula;
 		str.replace("%{label}", dc.value("label").toString());
@@ -341,10 +412,9 @@ namespace autonum
 						 -> border_and_titleblock
 						 .locmach());
 
-			QSettings settings;
 			if (m_element)
 			{
-			if (settings.value("border-columns_0", true).toBool()){
+			if (QetSettings::borderColumnsStartAtZero()){
 				m_assigned_label.replace("%c", QString::number(m_diagram->convertPosition(m_element->scenePos()).number() - 1));
 				}else{
 				m_assigned_label.replace("%c", QString::number(m_diagram->convertPosition(m_element->scenePos()).number()));
@@ -0,0 +1,465 @@
+/*
+	Copyright 2006-2025 The QElectroTech Team
+	This file is part of QElectroTech.
+
+	QElectroTech is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 2 of the License, or
+	(at your option) any later version.
+
+	QElectroTech is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with QElectroTech.  If not, see <http://www.gnu.org/licenses/>.
+*/
+#include "compiledformula.h"
+
+#include "../diagram.h"
+#include "../diagramcontext.h"
+#include "../diagramposition.h"
+#include "../qetgraphicsitem/conductor.h"
+#include "../qetgraphicsitem/element.h"
+#include "../qetproject.h"
+#include "../utils/qetsettings.h"
+#include "assignvariables.h"
+
+#include <QHash>
+#include <QMutex>
+#include <QMutexLocker>
+#include <QSet>
+
+namespace autonum
+{
+	/**
+		@brief CompiledFormula::compile
+		@param formula
+		@return the compiled formula of formula.
+		The compiled formulas are cached, a formula string
+		is only compiled the first time.
+	*/
+	QSharedPointer<const CompiledFormula> CompiledFormula::compile(
+			const QString &formula)
+	{
+		static QMutex mutex;
+		static QHash<QString, QSharedPointer<const CompiledFormula>> cache;
+
+		QMutexLocker locker(&mutex);
+		auto compiled = cache.value(formula);
+		if (!compiled)
+		{
+				//The formulas of a project are not numerous,
+				//but the cache must not grow forever.
+			if (cache.size() >= 1024) {
+				cache.clear();
+			}
+			compiled = QSharedPointer<const CompiledFormula>(
+					   new CompiledFormula(formula));
+			cache.insert(formula, compiled);
+		}
+		return compiled;
+	}
+
+	/**
+		@brief CompiledFormula::CompiledFormula
+		Split formula in literal runs and variable slots
+		@param formula
+	*/
+	CompiledFormula::CompiledFormula(const QString &formula) :
+		m_formula(formula)
+	{
+		static const QVector<QPair<QString, SlotType>> slot_names {
+			{QStringLiteral("f"),      FolioIndexSlot},
+			{QStringLiteral("id"),     FolioIndexSlot},
+			{QStringLiteral("total"),  FolioTotalSlot},
+			{QStringLiteral("M"),      PlantSlot},
+			{QStringLiteral("LM"),     LocMachSlot},
+			{QStringLiteral("c"),      ColumnSlot},
+			{QStringLiteral("l"),      RowSlot},
+			{QStringLiteral("prefix"), PrefixSlot},
+			{QStringLiteral("wf"),     WireFunctionSlot},
+			{QStringLiteral("wv"),     WireTensionSlot},
+			{QStringLiteral("wc"),     WireColorSlot},
+			{QStringLiteral("ws"),     WireSectionSlot}
+		};
+		static const QVector<QPair<QString, SequenceType>> sequence_names {
+			{QStringLiteral("sequ_"),  Unit},
+			{QStringLiteral("seqt_"),  Ten},
+			{QStringLiteral("seqh_"),  Hundred},
+			{QStringLiteral("sequf_"), UnitFolio},
+			{QStringLiteral("seqtf_"), TenFolio},
+			{QStringLiteral("seqhf_"), HundredFolio}
+		};
+
+		const int size = formula.size();
+		int pos = 0;
+		while (pos < size)
+		{
+			int next = formula.indexOf(QLatin1Char('%'), pos);
+			if (next == -1) {
+				next = size;
+			}
+
+			Token token;
+			token.m_begin = pos;
+			if (next != pos)
+			{
+				token.m_size = next - pos;
+				m_tokens << token;
+				pos = next;
+				continue;
+			}
+
+			int end = formula.indexOf(QLatin1Char('%'), pos + 1);
+			if (end == -1) {
+				end = size;
+			}
+			token.m_size = end - pos;
+			token.m_percent = true;
+			const QString text = formula.mid(pos + 1, end - pos - 1);
+
+				//None of the slot names is the start of another one
+			for (const auto &slot : slot_names)
+			{
+				if (text.startsWith(slot.first)) {
+					token.m_slot = slot.second;
+					token.m_slot_size = slot.first.size() + 1;
+					break;
+				}
+			}
+
+			if (text.startsWith(QLatin1Char('{')))
+			{
+				const int close = text.indexOf(QLatin1Char('}'));
+				if (close > 1) {
+					token.m_braced_name = text.mid(1, close - 1);
+					token.m_braced_size = close + 2;
+				}
+			}
+
+				//Same characters as DiagramContext::validKeyRegExp()
+			for (const auto &c : text)
+			{
+				if ((c >= QLatin1Char('a') && c <= QLatin1Char('z'))
+						|| (c >= QLatin1Char('0') && c <= QLatin1Char('9'))
+						|| c == QLatin1Char('-') || c == QLatin1Char('_')) {
+					++token.m_name_size;
+				} else {
+					break;
+				}
+			}
+
+			for (const auto &sequence : sequence_names)
+			{
+				if (text.startsWith(sequence.first))
+				{
+					token.m_sequence = sequence.second;
+					token.m_sequence_begin = sequence.first.size() + 1;
+					for (int i = sequence.first.size() ;
+						 i < text.size()
+						 && text.at(i) >= QLatin1Char('0')
+						 && text.at(i) <= QLatin1Char('9') ;
+						 ++i) {
+						++token.m_sequence_size;
+					}
+					break;
+				}
+			}
+
+			m_tokens << token;
+			pos = end;
+		}
+	}
+
+	/**
+		@brief CompiledFormula::toLabel
+		Assign the variables of this formula in one pass.
+		The precedence between the variables which start at the same '%'
+		is the order of the replacements done by AssignVariables :
+		folio and element/conductor variables, then titleblock variables,
+		then project variables and finally the sequentials.
+		@param seq_struct : sequentials used by the formula
+		@param diagram : diagram where the formula is used, must not be null
+		@param elmt : element of the formula, can be null
+		@param cndr : conductor of the formula, can be null
+		@param ok : set to false if a value assigned to a variable
+		contain a '%'. The successive replacements done by AssignVariables
+		can assign the variables of this value too, the label must be
+		computed again with AssignVariables.
+		@return the label
+	*/
+	QString CompiledFormula::toLabel(const sequentialNumbers &seq_struct,
+					 Diagram *diagram,
+					 const Element *elmt,
+					 const Conductor *cndr,
+					 bool *ok) const
+	{
+		*ok = true;
+
+		QString label;
+		label.reserve(m_formula.size() + 16);
+
+		bool fields_loaded = false;
+		DiagramContext titleblock_fields;
+		DiagramContext project_fields;
+
+		for (const auto &token : m_tokens)
+		{
+			const QChar *text = m_formula.constData() + token.m_begin;
+			if (!token.m_percent) {
+				label.append(text, token.m_size);
+				continue;
+			}
+
+			QString value;
+			int consumed = 0;
+
+			switch (token.m_slot)
+			{
+				case FolioIndexSlot:
+					value = QString::number(diagram->folioIndex() + 1);
+					break;
+				case FolioTotalSlot:
+					value = QString::number(
+								diagram->border_and_titleblock.folioTotal());
+					break;
+				case PlantSlot:
+					value = diagram->border_and_titleblock.plant();
+					break;
+				case LocMachSlot:
+					value = diagram->border_and_titleblock.locmach();
+					break;
+				case ColumnSlot:
+					if (elmt)
+					{
+						const int number = diagram->convertPosition(
+									   elmt->scenePos()).number();
+						value = QetSettings::borderColumnsStartAtZero()
+								? QString::number(number - 1)
+								: QString::number(number);
+					}
+					break;
+				case RowSlot:
+					if (elmt) {
+						value = diagram->convertPosition(elmt->scenePos()).letter();
+					}
+					break;
+				case PrefixSlot:
+					if (elmt) {
+						value = elmt->getPrefix();
+					}
+					break;
+				case WireFunctionSlot:
+					if (cndr) {
+						value = cndr->properties().m_function;
+					}
+					break;
+				case WireTensionSlot:
+					if (cndr) {
+						value = cndr->properties().m_tension_protocol;
+					}
+					break;
+				case WireColorSlot:
+					if (cndr) {
+						value = cndr->properties().m_wire_color;
+					}
+					break;
+				case WireSectionSlot:
+					if (cndr) {
+						value = cndr->properties().m_wire_section;
+					}
+					break;
+				case NoSlot:
+					break;
+			}
+
+			const bool slot_used = token.m_slot != NoSlot
+					&& (token.m_slot < ColumnSlot
+					    || (elmt && token.m_slot <= PrefixSlot)
+					    || (cndr && token.m_slot >= WireFunctionSlot));
+			if (slot_used) {
+				consumed = token.m_slot_size;
+			}
+			else
+			{
+				if (!fields_loaded)
+				{
+					titleblock_fields = diagram->border_and_titleblock.additionalFields();
+					if (diagram->project()) {
+						project_fields = diagram->project()->projectProperties();
+					}
+					fields_loaded = true;
+				}
+
+				if (!namedValue(titleblock_fields, m_formula, token, value, consumed)
+						&& !namedValue(project_fields, m_formula, token, value, consumed)
+						&& token.m_sequence != NoSequence)
+				{
+						//AssignVariables replace %sequ_1 before %sequ_12,
+						//use the shortest number of the sequential which exist.
+					const QStringList &list = sequence(seq_struct, token.m_sequence);
+					int number = 0;
+					for (int i = 0 ;
+						 i < token.m_sequence_size
+						 && text[token.m_sequence_begin] != QLatin1Char('0') ;
+						 ++i)
+					{
+						number = number * 10 + text[token.m_sequence_begin + i].digitValue();
+						if (number > list.size()) {
+							break;
+						}
+						if (number >= 1) {
+							value = list.at(number - 1);
+							consumed = token.m_sequence_begin + i + 1;
+							break;
+						}
+					}
+				}
+			}
+
+			if (consumed && value.contains(QLatin1Char('%'))) {
+				*ok = false;
+			}
+			label.append(value);
+			label.append(text + consumed, token.m_size - consumed);
+		}
+
+		return label;
+	}
+
+	/**
+		@brief CompiledFormula::replaceVariable
+		Replace the variables in form %{my-var} in one pass,
+		like AssignVariables::replaceVariable
+		@param dc : values of the variables
+		@param ok : set to false if a value contain a "%{",
+		the successive replacements done by AssignVariables::replaceVariable
+		can assign the variables of this value too.
+		@return the formula with assigned variables
+	*/
+	QString CompiledFormula::replaceVariable(const DiagramContext &dc,
+						 bool *ok) const
+	{
+		static const QSet<QString> names = [] {
+			QSet<QString> names_ {
+				QStringLiteral("label"),
+				QStringLiteral("plant"),
+				QStringLiteral("comment"),
+				QStringLiteral("description"),
+				QStringLiteral("designation"),
+				QStringLiteral("manufacturer"),
+				QStringLiteral("manufacturer_reference"),
+				QStringLiteral("supplier"),
+				QStringLiteral("quantity"),
+				QStringLiteral("unity"),
+				QStringLiteral("machine_manufacturer_reference"),
+				QStringLiteral("location"),
+				QStringLiteral("function")
+			};
+			for (int i = 1 ; i <= 4 ; ++i)
+			{
+				const QString n = QString::number(i);
+				names_ << QStringLiteral("auxiliary") + n
+				       << QStringLiteral("description_auxiliary") + n
+				       << QStringLiteral("designation_auxiliary") + n
+				       << QStringLiteral("manufacturer_auxiliary") + n
+				       << QStringLiteral("manufacturer_reference_auxiliary") + n
+				       << QStringLiteral("supplier_auxiliary") + n
+				       << QStringLiteral("quantity_auxiliary") + n
+				       << QStringLiteral("unity_auxiliary") + n;
+			}
+			return names_;
+		}();
+
+		*ok = true;
+
+		QString str;
+		str.reserve(m_formula.size() + 16);
+
+		for (const auto &token : m_tokens)
+		{
+			const QChar *text = m_formula.constData() + token.m_begin;
+			int consumed = 0;
+			if (token.m_percent && token.m_braced_size)
+			{
+				if (token.m_braced_name == QLatin1String("void")) {
+					consumed = token.m_braced_size;
+				}
+				else if (names.contains(token.m_braced_name))
+				{
+					const QString value = dc.value(token.m_braced_name).toString();
+					if (value.contains(QLatin1String("%{"))) {
+						*ok = false;
+					}
+					str.append(value);
+					consumed = token.m_braced_size;
+				}
+			}
+			str.append(text + consumed, token.m_size - consumed);
+		}
+
+		return str;
+	}
+
+	/**
+		@brief CompiledFormula::namedValue
+		Find the variable of dc used by token.
+		A variable is used in form %{name} or %name, in the last form
+		the shortest name wins, like the replacements in alphabetical order
+		done by AssignVariables.
+		@param dc : the variables
+		@param formula : the formula of token
+		@param token
+		@param value : set to the value of the found variable
+		@param size : set to the size of the text used by the found variable
+		@return true if a variable is found
+	*/
+	bool CompiledFormula::namedValue(const DiagramContext &dc,
+					 const QString &formula,
+					 const Token &token,
+					 QString &value,
+					 int &size)
+	{
+		if (token.m_braced_size && dc.contains(token.m_braced_name))
+		{
+			value = dc.value(token.m_braced_name).toString();
+			size = token.m_braced_size;
+			return true;
+		}
+
+		for (int i = 1 ; i <= token.m_name_size ; ++i)
+		{
+			const QString name = formula.mid(token.m_begin + 1, i);
+			if (dc.contains(name))
+			{
+				value = dc.value(name).toString();
+				size = i + 1;
+				return true;
+			}
+		}
+		return false;
+	}
+
+	/**
+		@brief CompiledFormula::sequence
+		@param seq_struct
+		@param type
+		@return the list of seq_struct which store the sequentials of type
+	*/
+	const QStringList &CompiledFormula::sequence(
+			const sequentialNumbers &seq_struct,
+			SequenceType type)
+	{
+		switch (type)
+		{
+			case Ten:          return seq_struct.ten;
+			case Hundred:      return seq_struct.hundred;
+			case UnitFolio:    return seq_struct.unit_folio;
+			case TenFolio:     return seq_struct.ten_folio;
+			case HundredFolio: return seq_struct.hundred_folio;
+			default:           return seq_struct.unit;
+		}
+	}
+}
@@ -0,0 +1,124 @@
+/*
+	Copyright 2006-2025 The QElectroTech Team
+	This file is part of QElectroTech.
+
+	QElectroTech is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 2 of the License, or
+	(at your option) any later version.
+
+	QElectroTech is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with QElectroTech.  If not, see <http://www.gnu.org/licenses/>.
+*/
+#ifndef COMPILEDFORMULA_H
+#define COMPILEDFORMULA_H
+
+#include <QSharedPointer>
+#include <QString>
+#include <QVector>
+
+class Conductor;
+class Diagram;
+class DiagramContext;
+class Element;
+
+namespace autonum
+{
+	class sequentialNumbers;
+
+	/**
+		@brief The CompiledFormula class
+		A formula split once in literal runs and variable slots,
+		so the variables of the formula can be assigned in one pass.
+		A compiled formula doesn't depend of the diagram or element
+		where it's used and is shared through a cache by every label
+		which use the same formula string.
+		The variables are assigned with the same precedence
+		than the successive replacements done by AssignVariables,
+		except %F which must be replaced before compile the formula.
+	*/
+	class CompiledFormula
+	{
+		public:
+			static QSharedPointer<const CompiledFormula> compile(
+					const QString &formula);
+
+			QString toLabel(const sequentialNumbers &seq_struct,
+					Diagram *diagram,
+					const Element *elmt,
+					const Conductor *cndr,
+					bool *ok) const;
+			QString replaceVariable(const DiagramContext &dc,
+						bool *ok) const;
+
+		private:
+			CompiledFormula(const QString &formula);
+
+			enum SlotType {
+				NoSlot,
+				FolioIndexSlot,    //%f and %id
+				FolioTotalSlot,    //%total
+				PlantSlot,         //%M
+				LocMachSlot,       //%LM
+				ColumnSlot,        //%c
+				RowSlot,           //%l
+				PrefixSlot,        //%prefix
+				WireFunctionSlot,  //%wf
+				WireTensionSlot,   //%wv
+				WireColorSlot,     //%wc
+				WireSectionSlot    //%ws
+			};
+
+			enum SequenceType {
+				NoSequence,
+				Unit,
+				Ten,
+				Hundred,
+				UnitFolio,
+				TenFolio,
+				HundredFolio
+			};
+
+			/**
+				@brief The Token struct
+				A literal run of the formula if m_percent is false,
+				else a '%' followed by the text up to the next '%'.
+			*/
+			struct Token
+			{
+				int m_begin = 0;
+				int m_size = 0;
+				bool m_percent = false;
+					//Everything below is only used when m_percent is true
+				SlotType m_slot = NoSlot;
+				int m_slot_size = 0;
+					//Name between braces of %{name}, and total size
+				QString m_braced_name;
+				int m_braced_size = 0;
+					//Characters usable as variable name after the '%'
+				int m_name_size = 0;
+				SequenceType m_sequence = NoSequence;
+				int m_sequence_begin = 0;
+				int m_sequence_size = 0;
+			};
+
+			static bool namedValue(const DiagramContext &dc,
+					       const QString &formula,
+					       const Token &token,
+					       QString &value,
+					       int &size);
+			static const QStringList &sequence(
+					const sequentialNumbers &seq_struct,
+					SequenceType type);
+
+			QString m_formula;
+			QVector<Token> m_tokens;
+	};
+}
+
+#endif // COMPILEDFORMULA_H
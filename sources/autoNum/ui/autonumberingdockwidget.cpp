@@ -20,6 +20,7 @@
 #include "../../diagram.h"
 #include "../../diagramview.h"
 #include "../../qetapp.h"
+#include "../../qetproject.h"
 #include "../../titleblockproperties.h"
 #include "../../ui/projectpropertiesdialog.h"
 #include "../numerotationcontext.h"
@@ -258,6 +259,7 @@ void AutoNumberingDockWidget::on_m_conductor_cb_activated(int)
 {
 	QString current_autonum = ui->m_conductor_cb->currentText();
 
+	ProjectBatchScope batch(m_project);
 	m_project->setCurrentConductorAutoNum(current_autonum);
 	m_project_view->currentDiagram()->diagram()->setConductorsAutonumName(current_autonum);
 	m_project_view->currentDiagram()->diagram()->loadCndFolioSeq();
@@ -287,6 +289,7 @@ void AutoNumberingDockWidget::elementAutoNumChanged()
 */
 void AutoNumberingDockWidget::on_m_element_cb_activated(int)
 {
+	ProjectBatchScope batch(m_project);
 	m_project->setCurrrentElementAutonum(ui->m_element_cb->currentText());
 	m_project_view->currentDiagram()->diagram()->loadElmtFolioSeq();
 }
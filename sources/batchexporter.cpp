@@ -0,0 +1,272 @@
+/*
+	Copyright 2006-2025 The QElectroTech Team
+	This file is part of QElectroTech.
+
+	QElectroTech is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 2 of the License, or
+	(at your option) any later version.
+
+	QElectroTech is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with QElectroTech.  If not, see <http://www.gnu.org/licenses/>.
+*/
+#include "batchexporter.h"
+
+#include "diagram.h"
+#include "exportdialog.h"
+#include "qetproject.h"
+
+#include <QDir>
+#include <QElapsedTimer>
+#include <QFileInfo>
+#include <QFuture>
+#include <QImage>
+#include <QPainter>
+#include <QPdfWriter>
+#include <QSvgGenerator>
+#include <QtConcurrentRun>
+
+#include <iostream>
+
+/**
+	@brief BatchExporter::BatchExporter
+	@param arguments : the command line arguments,
+	with a export format and the project files to export.
+*/
+BatchExporter::BatchExporter(const QETArguments &arguments) :
+	m_arguments(arguments),
+	m_properties(ExportProperties::defaultExportProperties())
+{
+	m_properties.format = m_arguments.exportFormat();
+}
+
+/**
+	@brief BatchExporter::exec
+	Export every asked folios of every project files.
+	@return EXIT_SUCCESS if every files are written, else EXIT_FAILURE
+*/
+int BatchExporter::exec()
+{
+	const QString format = m_arguments.exportFormat();
+	if (!formatIsSupported(format))
+	{
+		std::cerr << qPrintable(QObject::tr("Format d'export inconnu : %1").arg(format))
+			  << std::endl;
+		return EXIT_FAILURE;
+	}
+	if (m_arguments.projectFiles().isEmpty())
+	{
+		std::cerr << qPrintable(QObject::tr("Aucun projet à exporter")) << std::endl;
+		return EXIT_FAILURE;
+	}
+
+	QElapsedTimer total_timer;
+	total_timer.start();
+
+	bool success = true;
+	QList<Result> results;
+	QList<QFuture<Result>> futures;
+	const QList<int> folios = m_arguments.exportFolios();
+	const QString extension = format == QLatin1String("JPG") ? QStringLiteral("jpg")
+								 : format.toLower();
+
+	for (const QString &project_path : m_arguments.projectFiles())
+	{
+		QETProject project(project_path);
+		if (project.state() != QETProject::Ok)
+		{
+			std::cerr << qPrintable(QObject::tr("Impossible d'ouvrir le projet %1")
+						.arg(project_path))
+				  << std::endl;
+			success = false;
+			continue;
+		}
+
+		const QFileInfo project_info(project_path);
+		QDir target_dir(m_arguments.exportDir().isEmpty()
+				? project_info.absolutePath()
+				: m_arguments.exportDir());
+		if (!target_dir.exists() && !target_dir.mkpath(QStringLiteral("."))) {
+			std::cerr << qPrintable(QObject::tr("Impossible de créer le dossier %1")
+						.arg(target_dir.absolutePath()))
+				  << std::endl;
+			return EXIT_FAILURE;
+		}
+
+		const QList<Diagram *> diagrams = project.diagrams();
+		for (int i = 0 ; i < diagrams.size() ; ++i)
+		{
+			if (!folios.isEmpty() && !folios.contains(i + 1)) {
+				continue;
+			}
+
+			Diagram *diagram = diagrams.at(i);
+				//Only the exported folios are loaded
+			project.materializeDiagram(diagram);
+			const QString file_path = target_dir.absoluteFilePath(
+						QStringLiteral("%1_%2.%3")
+						.arg(project_info.completeBaseName())
+						.arg(i + 1, 2, 10, QLatin1Char('0'))
+						.arg(extension));
+
+			QElapsedTimer render_timer;
+			render_timer.start();
+
+				//Render the diagram in the main thread
+			const ExportProperties diagram_properties =
+					diagram->applyProperties(m_properties);
+			const QSize size = diagram->imageSize() * m_arguments.exportScale();
+			QPicture picture;
+			if (format != QLatin1String("DXF")) {
+				diagram->toPaintDevice(picture, size.width(), size.height());
+			}
+			diagram->applyProperties(diagram_properties);
+
+			if (format == QLatin1String("DXF"))
+			{
+					//The items of the diagram are read in the main thread,
+					//the file is written by the pool of threads
+				const auto write_dxf = ExportDialog::prepareDxf(diagram,
+									       size.width(),
+									       size.height(),
+									       file_path,
+									       m_properties);
+				const qint64 render_ms = render_timer.elapsed();
+				futures << QtConcurrent::run([=]() {
+					QElapsedTimer timer;
+					timer.start();
+					write_dxf();
+
+					Result result;
+					result.m_file_path = file_path;
+					result.m_render_ms = render_ms;
+					result.m_write_ms = timer.elapsed();
+					result.m_success = QFileInfo::exists(file_path);
+					return result;
+				});
+				continue;
+			}
+
+			const qint64 render_ms = render_timer.elapsed();
+			futures << QtConcurrent::run([=]() {
+				return writePicture(picture, size, format, file_path, render_ms);
+			});
+		}
+	}
+
+		//Summary
+	std::cout << qPrintable(QObject::tr("Fichier ; rendu (ms) ; écriture (ms) ; état"))
+		  << std::endl;
+	for (auto &future : futures) {
+		results << future.result();
+	}
+	for (const Result &result : qAsConst(results))
+	{
+		success &= result.m_success;
+		std::cout << qPrintable(QStringLiteral("%1 ; %2 ; %3 ; %4")
+					.arg(result.m_file_path)
+					.arg(result.m_render_ms)
+					.arg(result.m_write_ms)
+					.arg(result.m_success ? QObject::tr("ok")
+							      : QObject::tr("échec")))
+			  << std::endl;
+	}
+	std::cout << qPrintable(QObject::tr("%1 fichier(s) exporté(s) en %2 ms")
+				.arg(results.size())
+				.arg(total_timer.elapsed()))
+		  << std::endl;
+
+	return success ? EXIT_SUCCESS : EXIT_FAILURE;
+}
+
+/**
+	@brief BatchExporter::formatIsSupported
+	@param format : format in upper case
+	@return true if format can be used by the command line export
+*/
+bool BatchExporter::formatIsSupported(const QString &format)
+{
+	static const QStringList formats {
+		QStringLiteral("PDF"),
+		QStringLiteral("SVG"),
+		QStringLiteral("PNG"),
+		QStringLiteral("JPG"),
+		QStringLiteral("BMP"),
+		QStringLiteral("DXF")
+	};
+	return formats.contains(format);
+}
+
+/**
+	@brief BatchExporter::writePicture
+	Play picture in a file of format format.
+	This function doesn't use any QGraphicsItem
+	and can be called from any thread.
+	@param picture : the rendered folio
+	@param size : size of the folio
+	@param format : PDF, SVG or a raster format
+	@param file_path : file to write
+	@param render_ms : time spent to render picture
+	@return the result of the writing
+*/
+BatchExporter::Result BatchExporter::writePicture(const QPicture &picture,
+						  const QSize &size,
+						  const QString &format,
+						  const QString &file_path,
+						  qint64 render_ms)
+{
+	QElapsedTimer timer;
+	timer.start();
+
+	Result result;
+	result.m_file_path = file_path;
+	result.m_render_ms = render_ms;
+
+	if (format == QLatin1String("SVG"))
+	{
+			//Same size as ExportDialog::generateSvg
+		QSvgGenerator svg_engine;
+		svg_engine.setSize(QSize((size.width()*9/16), (size.height()*9/16)));
+		svg_engine.setFileName(file_path);
+		QPainter painter;
+		result.m_success = painter.begin(&svg_engine);
+		if (result.m_success) {
+			picture.play(&painter);
+			result.m_success = painter.end();
+		}
+	}
+	else if (format == QLatin1String("PDF"))
+	{
+		QPdfWriter pdf_writer(file_path);
+		pdf_writer.setResolution(72);
+		pdf_writer.setPageSize(QPageSize(QSizeF(size), QPageSize::Point));
+		pdf_writer.setPageMargins(QMarginsF());
+		QPainter painter;
+		result.m_success = painter.begin(&pdf_writer);
+		if (result.m_success) {
+			picture.play(&painter);
+			result.m_success = painter.end();
+		}
+	}
+	else
+	{
+		QImage image(size, QImage::Format_RGB32);
+		image.fill(Qt::white);
+		QPainter painter;
+		result.m_success = !image.isNull() && painter.begin(&image);
+		if (result.m_success)
+		{
+			picture.play(&painter);
+			painter.end();
+			result.m_success = image.save(file_path, qPrintable(format));
+		}
+	}
+
+	result.m_write_ms = timer.elapsed();
+	return result;
+}
@@ -0,0 +1,70 @@
+/*
+	Copyright 2006-2025 The QElectroTech Team
+	This file is part of QElectroTech.
+
+	QElectroTech is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 2 of the License, or
+	(at your option) any later version.
+
+	QElectroTech is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with QElectroTech.  If not, see <http://www.gnu.org/licenses/>.
+*/
+#ifndef BATCHEXPORTER_H
+#define BATCHEXPORTER_H
+
+#include "exportproperties.h"
+#include "qetarguments.h"
+
+#include <QPicture>
+#include <QSize>
+
+/**
+	@brief The BatchExporter class
+	Export the folios of the projects given on the command line,
+	without graphical interface, then print a summary with the time
+	spent for each file.
+	Folios are rendered one after another in the main thread
+	(the diagrams are QGraphicsScene), the encoding and the writing
+	of the files are done concurrently in a pool of threads.
+	For the DXF format, the items are read in the main thread
+	(see ExportDialog::prepareDxf) and the files are written
+	concurrently too.
+	Usage :
+	qelectrotech --export=PNG [--export-dir=DIR] [--export-folios=1,3-5]
+	[--export-scale=2] project.qet...
+*/
+class BatchExporter
+{
+	public:
+		BatchExporter(const QETArguments &arguments);
+
+		int exec();
+
+		static bool formatIsSupported(const QString &format);
+
+	private:
+		struct Result
+		{
+			QString m_file_path;
+			qint64 m_render_ms = 0;
+			qint64 m_write_ms = 0;
+			bool m_success = false;
+		};
+
+		static Result writePicture(const QPicture &picture,
+					   const QSize &size,
+					   const QString &format,
+					   const QString &file_path,
+					   qint64 render_ms);
+
+		QETArguments m_arguments;
+		ExportProperties m_properties;
+};
+
+#endif // BATCHEXPORTER_H
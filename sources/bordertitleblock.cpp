@@ -25,6 +25,7 @@
 #include "qetversion.h"
 #include "titleblocktemplate.h"
 #include "titleblocktemplaterenderer.h"
+#include "utils/qetsettings.h"
 
 
 #include <QLocale>
@@ -55,11 +56,9 @@ BorderTitleBlock::BorderTitleBlock(QObject *parent) :
 	m_titleblock_template_renderer = new TitleBlockTemplateRenderer(this);
 	m_titleblock_template_renderer -> setTitleBlockTemplate(QETApp::defaultTitleBlockTemplate());
 
-	// disable the QPicture-based cache from Qt 4.8 to avoid rendering errors and crashes
-#if QT_VERSION < QT_VERSION_CHECK(4, 8, 0)	// ### Qt 6: remove
-#else
-	m_titleblock_template_renderer -> setUseCache(false);
-#endif
+	// the renderer cache a pixmap of the titleblock for the screen,
+	// the QPicture used before Qt 4.8 caused rendering errors and crashes
+	m_titleblock_template_renderer -> setUseCache(true);
 
 	// dimensions par defaut du schema
 	importBorder(BorderProperties());
@@ -517,8 +516,6 @@ void BorderTitleBlock::draw(QPainter *painter)
 	painter -> setPen(pen);
 	painter -> setBrush(Qt::NoBrush);
 
-	QSettings settings;
-
 	//Draw the borer
 	if (display_border_) painter -> drawRect(diagram_rect_);
 
@@ -548,7 +545,7 @@ void BorderTitleBlock::draw(QPainter *painter)
 				columns_header_height_
 			);
 			painter -> drawRect(numbered_rectangle);
-			if (settings.value("border-columns_0", true).toBool()){
+			if (QetSettings::borderColumnsStartAtZero()){
 			painter -> drawText(numbered_rectangle,
 					    Qt::AlignVCenter
 					    | Qt::AlignCenter,
@@ -645,13 +642,11 @@ void BorderTitleBlock::drawDxf(
 		);
 	}
 
-	QSettings settings;
-
 	// draw the numbering of the columns
 	// dessine la numerotation des colonnes
 	if (display_border_ &&
 		display_columns_) {
-	int offset = settings.value("border-columns_0", true).toBool() ? -1 : 0;
+	int offset = QetSettings::borderColumnsStartAtZero() ? -1 : 0;
 		for (int i = 1 ; i <= columns_count_ ; ++ i) {
 	    double xCoord = diagram_rect_.topLeft().x() * Createdxf::xScale +
 					(rows_header_width_ + ((i - 1) *
@@ -893,8 +888,9 @@ void BorderTitleBlock::setFolio(const QString &folio)
 	by regenerating a DiagramContext object.
 	@param initial_context :
 	Base diagram context that will be overridden by diagram-wide values
+	@return true if the informations given to the titleblock template changed
 */
-void BorderTitleBlock::updateDiagramContextForTitleBlock(
+bool BorderTitleBlock::updateDiagramContextForTitleBlock(
 		const DiagramContext &initial_context) {
 	// Our final DiagramContext is the initial one (which is supposed to bring
 	// project-wide properties), overridden by the "additional fields" one...
@@ -923,7 +919,7 @@ void BorderTitleBlock::updateDiagramContextForTitleBlock(
 	context.addValue("previous-folio-num", m_previous_folio_num);
 	context.addValue("next-folio-num", m_next_folio_num);
 
-	m_titleblock_template_renderer -> setContext(context);
+	return m_titleblock_template_renderer -> setContext(context);
 }
 
 /**
@@ -967,13 +963,15 @@ QString BorderTitleBlock::incrementLetters(const QString &string) {
 
 	\~ @param project_properties : Project-wide properties,
 	to be merged with diagram-wide ones.
+
+	\~ @return true if the folio data displayed by the title block changed
 */
-void BorderTitleBlock::setFolioData(
+bool BorderTitleBlock::setFolioData(
 		int index,
 		int total,
 		const QString& autonum,
 		const DiagramContext &project_properties) {
-	if (index < 1 || total < 1 || index > total) return;
+	if (index < 1 || total < 1 || index > total) return(false);
 
 	// memorize information
 	// memorise les informations
@@ -991,29 +989,31 @@ void BorderTitleBlock::setFolioData(
 	btb_final_folio_.replace("%id",    QString::number(folio_index_));
 	btb_final_folio_.replace("%total", QString::number(folio_total_));
 
-	updateDiagramContextForTitleBlock(project_properties);
+	return(updateDiagramContextForTitleBlock(project_properties));
 }
 
 /**
 	@brief BorderTitleBlock::setPreviousFolioNum
 	@param previous the new value of the "previous-folio-num" field
+	@return true if the field changed
 */
-void BorderTitleBlock::setPreviousFolioNum(const QString &previous)
+bool BorderTitleBlock::setPreviousFolioNum(const QString &previous)
 {
 	m_previous_folio_num = previous;
 	DiagramContext context = m_titleblock_template_renderer->context();
 	context.addValue("previous-folio-num", m_previous_folio_num);
-	m_titleblock_template_renderer->setContext(context);
+	return m_titleblock_template_renderer->setContext(context);
 }
 
 /**
 	@brief BorderTitleBlock::setNextFolioNum
 	@param next the new value of the "next-folio-num" field
+	@return true if the field changed
 */
-void BorderTitleBlock::setNextFolioNum(const QString &next)
+bool BorderTitleBlock::setNextFolioNum(const QString &next)
 {
 	m_next_folio_num = next;
 	DiagramContext context = m_titleblock_template_renderer->context();
 	context.addValue("next-folio-num", m_next_folio_num);
-	m_titleblock_template_renderer->setContext(context);
+	return m_titleblock_template_renderer->setContext(context);
 }
@@ -160,10 +160,10 @@ class BorderTitleBlock : public QObject
 		
 		// methods to set title block basic data
 		void setFolio(const QString &folio);
-		void setFolioData(int, int, const QString& = nullptr,
+		bool setFolioData(int, int, const QString& = nullptr,
 				  const DiagramContext & = DiagramContext());
-		void setPreviousFolioNum(const QString &previous);
-		void setNextFolioNum(const QString &next);
+		bool setPreviousFolioNum(const QString &previous);
+		bool setNextFolioNum(const QString &next);
 		
 		void titleBlockToXml(QDomElement &);
 		void titleBlockFromXml(const QDomElement &);
@@ -193,7 +193,7 @@ class BorderTitleBlock : public QObject
 	
 	private:
 		void updateRectangles();
-		void updateDiagramContextForTitleBlock(
+		bool updateDiagramContextForTitleBlock(
 				const DiagramContext & = DiagramContext());
 		QString incrementLetters(const QString &);
 	
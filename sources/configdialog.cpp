@@ -21,6 +21,7 @@
 #include "qetapp.h"
 
 #include "machine_info.h"
+#include "utils/qetsettings.h"
 
 /**
 	Constructeur
@@ -125,6 +126,8 @@ void ConfigDialog::applyConf()
 	foreach(ConfigPage *page, pages) {
 		page -> applyConf();
 	}
+		//Update the settings kept in memory by the hot paths
+	QetSettings::reloadSnapshot();
 	accept();
 }
 
@@ -19,6 +19,9 @@
 #include <QFile>
 #include <QTextStream>
 #include <QMessageBox>
+#include <QMutex>
+#include <QMutexLocker>
+#include <QSharedPointer>
 #include <QString>
 #include "exportdialog.h"
 
@@ -26,8 +29,88 @@
 const double Createdxf::sheetWidth = 4000;
 const double Createdxf::sheetHeight = 2700;
 
-double Createdxf::xScale = 1;
-double Createdxf::yScale = 1;
+thread_local double Createdxf::xScale = 1;
+thread_local double Createdxf::yScale = 1;
+
+namespace {
+	/**
+		@brief The DxfFile struct
+		A dxf file kept open from Createdxf::dxfBegin to Createdxf::dxfEnd,
+		every primitive is written in the same buffered stream.
+	*/
+	struct DxfFile
+	{
+		QFile m_file;
+		QTextStream m_stream;
+	};
+
+	QMutex dxf_files_mutex;
+	QHash<QString, QSharedPointer<DxfFile>> dxf_files;
+}
+
+/**
+	@brief Createdxf::openStream
+	Open the file fileName and keep it open until closeStream is called.
+	Several files can be open at the same time,
+	each one can be written by a different thread.
+	@param fileName
+	@param mode : QIODevice::WriteOnly to create a new file,
+	QIODevice::Append to continue an existing file.
+	@return the stream of the file or nullptr if the file can't be open
+*/
+QTextStream *Createdxf::openStream(const QString &fileName,
+				   QIODevice::OpenMode mode)
+{
+	QSharedPointer<DxfFile> dxf_file(new DxfFile());
+	dxf_file->m_file.setFileName(fileName);
+	if (!dxf_file->m_file.open(mode)) {
+		return nullptr;
+	}
+	dxf_file->m_stream.setDevice(&dxf_file->m_file);
+
+	QMutexLocker locker(&dxf_files_mutex);
+	dxf_files.insert(fileName, dxf_file);
+	return &dxf_file->m_stream;
+}
+
+/**
+	@brief Createdxf::stream
+	@param fileName
+	@return the stream of the file fileName opened by dxfBegin.
+	If the file isn't open, the file is open in append mode
+	and stay open until dxfEnd is called.
+	Return nullptr if the file can't be open.
+*/
+QTextStream *Createdxf::stream(const QString &fileName)
+{
+	{
+		QMutexLocker locker(&dxf_files_mutex);
+		const auto dxf_file = dxf_files.value(fileName);
+		if (dxf_file) {
+			return &dxf_file->m_stream;
+		}
+	}
+	return openStream(fileName, QIODevice::Append);
+}
+
+/**
+	@brief Createdxf::closeStream
+	Flush and close the file fileName
+	@param fileName
+*/
+void Createdxf::closeStream(const QString &fileName)
+{
+	QSharedPointer<DxfFile> dxf_file;
+	{
+		QMutexLocker locker(&dxf_files_mutex);
+		dxf_file = dxf_files.take(fileName);
+	}
+	if (dxf_file)
+	{
+		dxf_file->m_stream.flush();
+		dxf_file->m_file.close();
+	}
+}
 
 Createdxf::Createdxf()
 {
@@ -44,8 +127,8 @@ void Createdxf::dxfBegin (const QString& fileName)
 	// Creation of an output stream object in text mode.
 	// Header section of every dxf file.
 	if (!fileName.isEmpty()) {
-		QFile file(fileName);
-		if (!file.open(QFile::WriteOnly)) {
+		QTextStream *stream_ = openStream(fileName);
+		if (!stream_) {
 			// error message
 			QMessageBox errorFileOpen;
 			errorFileOpen.setIcon(QMessageBox::Warning);
@@ -54,7 +137,7 @@ void Createdxf::dxfBegin (const QString& fileName)
 			errorFileOpen.exec();
 			exit(0);
 		} else {
-			QTextStream To_Dxf(&file);
+			QTextStream &To_Dxf = *stream_;
 			To_Dxf << 999           << "\r\n";
 			To_Dxf << "QET"         << "\r\n";
 			To_Dxf << 0             << "\r\n";
@@ -222,7 +305,6 @@ void Createdxf::dxfBegin (const QString& fileName)
 			To_Dxf << "SECTION"     << "\r\n";
 			To_Dxf << 2             << "\r\n";
 			To_Dxf << "ENTITIES"    << "\r\n";
-			file.close();
 		}
 	}
 }
@@ -236,20 +318,20 @@ void Createdxf::dxfEnd(const QString& fileName)
 {
 	// Creation of an output stream object in text mode.
 	if (!fileName.isEmpty()) {
-		QFile file(fileName);
-		if (!file.open(QFile::Append)) {
+		QTextStream *stream_ = stream(fileName);
+		if (!stream_) {
 			// error message
 			QMessageBox errorFileOpen;
 			errorFileOpen.setText("Error: File "+fileName+" was not written correctly.");
 			errorFileOpen.setInformativeText("Close all Files and Re-Run");
 			errorFileOpen.exec();
 		} else {
-			QTextStream To_Dxf(&file);
+			QTextStream &To_Dxf = *stream_;
 			To_Dxf << 0             << "\r\n";
 			To_Dxf << "ENDSEC"      << "\r\n";
 			To_Dxf << 0             << "\r\n";
 			To_Dxf << "EOF";
-			file.close();
+			closeStream(fileName);
 		}
 	}
 }
@@ -271,15 +353,15 @@ void Createdxf::drawCircle(
 		int colour)
 {
 	if (!fileName.isEmpty()) {
-		QFile file(fileName);
-		if (!file.open(QFile::Append)) {
+		QTextStream *stream_ = stream(fileName);
+		if (!stream_) {
 			// error message
 			QMessageBox errorFileOpen;
 			errorFileOpen.setText("Error: File "+fileName+" was not written correctly.");
 			errorFileOpen.setInformativeText("Close all Files and Re-Run");
 			errorFileOpen.exec();
 		} else {
-			QTextStream To_Dxf(&file);
+			QTextStream &To_Dxf = *stream_;
 			// Draw the circle
 			To_Dxf << 0         << "\r\n";
 			To_Dxf << "CIRCLE"  << "\r\n";
@@ -295,7 +377,6 @@ void Createdxf::drawCircle(
 			To_Dxf << 0.0       << "\r\n";    // Z in UCS (User Coordinate System)coordinates
 			To_Dxf << 40        << "\r\n";
 			To_Dxf << radius    << "\r\n";    // radius of circle
-			file.close();
 		}
 	}
 }
@@ -319,15 +400,15 @@ void Createdxf::drawLine (
 		const int &colour)
 {
 	if (!fileName.isEmpty()) {
-		QFile file(fileName);
-		if (!file.open(QFile::Append)) {
+		QTextStream *stream_ = stream(fileName);
+		if (!stream_) {
 			// error message
 			QMessageBox errorFileOpen;
 			errorFileOpen.setText("Error: File "+fileName+" was not written correctly.");
 			errorFileOpen.setInformativeText("Close all Files and Re-Run");
 			errorFileOpen.exec();
 		} else {
-			QTextStream To_Dxf(&file);
+			QTextStream &To_Dxf = *stream_;
 			// Draw the Line
 			To_Dxf << 0         << "\r\n";
 			To_Dxf << "LINE"    << "\r\n";
@@ -347,7 +428,6 @@ void Createdxf::drawLine (
 			To_Dxf << y2        << "\r\n";    // Y in UCS (User Coordinate System)coordinates
 			To_Dxf << 31        << "\r\n";
 			To_Dxf << 0.0       << "\r\n";    // Z in UCS (User Coordinate System)coordinates
-			file.close();
 		}
 	}
 }
@@ -418,6 +498,19 @@ long Createdxf::RGBcodeTable[255]
 */
 int Createdxf::getcolorCode (const long red, const long green, const long blue)
 {
+		//The same few colors are asked for each primitive,
+		//keep the result of the search.
+	static QMutex mutex;
+	static QHash<long, int> color_codes;
+	const long rgb = (red << 16) | (green << 8) | blue;
+	{
+		QMutexLocker locker(&mutex);
+		const auto it = color_codes.constFind(rgb);
+		if (it != color_codes.constEnd()) {
+			return it.value();
+		}
+	}
+
 	long acirgb, r,g,b;
 	long mindst = 2147483647L;
 	long dst = 0;
@@ -435,6 +528,9 @@ int Createdxf::getcolorCode (const long red, const long green, const long blue)
 			mindst = dst;
 		}
 	}
+
+	QMutexLocker locker(&mutex);
+	color_codes.insert(rgb, minndx);
 	return minndx;
 }
 
@@ -644,15 +740,15 @@ void Createdxf::drawArc(
 		int color)
 {
 	if (!fileName.isEmpty()) {
-		QFile file(fileName);
-		if (!file.open(QFile::Append)) {
+		QTextStream *stream_ = stream(fileName);
+		if (!stream_) {
 			// error message
 			QMessageBox errorFileOpen;
 			errorFileOpen.setText("Error: File "+fileName+" was not written correctly.");
 			errorFileOpen.setInformativeText("Close all Files and Re-Run");
 			errorFileOpen.exec();
 		} else {
-			QTextStream To_Dxf(&file);
+			QTextStream &To_Dxf = *stream_;
 			// Draw the arc
 			To_Dxf << 0         << "\r\n";
 			To_Dxf << "ARC"     << "\r\n";
@@ -672,7 +768,6 @@ void Createdxf::drawArc(
 			To_Dxf << startAngle<< "\r\n";    // start angle
 			To_Dxf << 51        << "\r\n";
 			To_Dxf << endAngle  << "\r\n";    // end angle
-			file.close();
 		}
 	}
 }
@@ -700,15 +795,15 @@ void Createdxf::drawText(
 	double xScaleW)
 {
 	if (!fileName.isEmpty()) {
-	QFile file(fileName);
-	if (!file.open(QFile::Append)) {
+	QTextStream *stream_ = stream(fileName);
+	if (!stream_) {
 		// error message
 		QMessageBox errorFileOpen;
 		errorFileOpen.setText("Error: File "+fileName+" was not written correctly.");
 		errorFileOpen.setInformativeText("Close all Files and Re-Run");
 		errorFileOpen.exec();
 	} else {
-		QTextStream To_Dxf(&file);
+		QTextStream &To_Dxf = *stream_;
 		// Draw the text
 		To_Dxf << 0         << "\r\n";
 		To_Dxf << "TEXT"    << "\r\n";
@@ -730,7 +825,6 @@ void Createdxf::drawText(
 		To_Dxf << text      << "\r\n";    // Text Value
 		To_Dxf << 50        << "\r\n";
 		To_Dxf << rotation  << "\r\n";    // Text Rotation
-		file.close();
 	}
 	}
 }
@@ -753,15 +847,15 @@ void Createdxf::drawTextAligned(
 		int colour)
 {
 	if (!fileName.isEmpty()) {
-		QFile file(fileName);
-		if (!file.open(QFile::Append)) {
+		QTextStream *stream_ = stream(fileName);
+		if (!stream_) {
 			// error message
 			QMessageBox errorFileOpen;
 			errorFileOpen.setText("Error: File "+fileName+" was not written correctly.");
 			errorFileOpen.setInformativeText("Close all Files and Re-Run");
 			errorFileOpen.exec();
 		} else {
-			QTextStream To_Dxf(&file);
+			QTextStream &To_Dxf = *stream_;
 			// Draw the circle
 			To_Dxf << 0         << "\r\n";
 			To_Dxf << "TEXT"    << "\r\n";
@@ -815,7 +909,6 @@ void Createdxf::drawTextAligned(
 				To_Dxf << 31       << "\r\n";
 				To_Dxf << 0.0      << "\r\n"; // Z in UCS (User Coordinate System)coordinates
 			}
-			file.close();
 		}
 	}
 }
@@ -834,15 +927,15 @@ void Createdxf::drawPolyline(const QString &filepath,
 {
 	qreal x,y;
 	if (!filepath.isEmpty()) {
-	QFile file(filepath);
-	if (!file.open(QFile::Append)) {
+	QTextStream *stream_ = stream(filepath);
+	if (!stream_) {
 		// error message
 		QMessageBox errorFileOpen;
 		errorFileOpen.setText("Error: File "+filepath+" was not written correctly.");
 		errorFileOpen.setInformativeText("Close all Files and Re-Run");
 		errorFileOpen.exec();
 	} else {
-		QTextStream To_Dxf(&file);
+		QTextStream &To_Dxf = *stream_;
 		// Draw the Line
 		To_Dxf << 0         << "\r\n";
 		To_Dxf << "POLYLINE"    << "\r\n";
@@ -889,7 +982,6 @@ void Createdxf::drawPolyline(const QString &filepath,
 		To_Dxf << 8         << "\r\n";
 		To_Dxf << 0         << "\r\n";    // Layer number (default layer in autocad)
 
-		file.close();
 	}
 	}
 }
@@ -157,8 +157,16 @@ class Createdxf
 
 		static const double sheetWidth;
 		static const double sheetHeight;
-		static double		xScale;
-		static double		yScale;
+			//Scale of the file being written by the current thread
+		static thread_local double xScale;
+		static thread_local double yScale;
+
+	private:
+		static QTextStream *openStream(
+				const QString &fileName,
+				QIODevice::OpenMode mode = QIODevice::WriteOnly);
+		static QTextStream *stream(const QString &fileName);
+		static void closeStream(const QString &fileName);
 };
 
 #endif // CREATEDXF_H
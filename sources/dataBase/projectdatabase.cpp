@@ -17,6 +17,7 @@
 */
 #include "projectdatabase.h"
 
+#include "../ElementsCollection/elementdefinitioncache.h"
 #include "../diagram.h"
 #include "../diagramposition.h"
 #include "../elementprovider.h"
@@ -27,6 +28,7 @@
 
 #include <QLocale>
 #include <QSqlError>
+#include <QSqlRecord>
 
 #include <QSqlDriver>
 #include <sqlite3.h>
@@ -42,6 +44,10 @@ projectDataBase::projectDataBase(QETProject *project, QObject *parent) :
 	QObject(parent),
 	m_project(project)
 {
+	m_flush_timer.setSingleShot(true);
+	m_flush_timer.setInterval(0);
+	connect(&m_flush_timer, &QTimer::timeout, this, &projectDataBase::flush);
+
 	createDataBase();
 	connect(m_project, &QETProject::diagramAdded, [this](QETProject *, Diagram *diagram) {
 		this->addDiagram(diagram);
@@ -51,19 +57,11 @@ projectDataBase::projectDataBase(QETProject *project, QObject *parent) :
 	});
 	connect(m_project, &QETProject::projectDiagramsOrderChanged, [this]()
 	{
-		for (auto diagram : m_project->diagrams())
-		{
-			m_diagram_order_changed.bindValue(":pos", m_project->folioIndex(diagram)+1);
-			m_diagram_order_changed.bindValue(":uuid", diagram->uuid());
-			m_diagram_order_changed.exec();
-
-
-			m_diagram_info_order_changed.bindValue(":folio", diagram->border_and_titleblock.titleblockInformation().value("folio"));
-			m_diagram_info_order_changed.bindValue(":uuid", diagram->uuid());
-			m_diagram_info_order_changed.exec();
-
+			//The position and the folio information of each diagram can change
+		for (auto diagram : m_project->diagrams()) {
+			m_dirty_diagrams.insert(diagram, diagram);
 		}
-		emit dataBaseUpdated();
+		flush();
 	});
 }
 
@@ -79,14 +77,67 @@ projectDataBase::~projectDataBase()
 /**
 	@brief projectDataBase::updateDB
 	Up to date the content of the data base.
+	Every diagram and element of the project is compared to the rows
+	already written, only the rows which changed are written again.
 	Emit the signal dataBaseUpdated
 */
 void projectDataBase::updateDB()
 {
-	populateDiagramTable();
-	populateDiagramInfoTable();
-	populateElementTable();
-	populateElementInfoTable();
+	m_flush_timer.stop();
+	m_dirty_elements.clear();
+	m_dirty_diagrams.clear();
+	m_removed_elements.clear();
+	m_removed_diagrams.clear();
+
+	QList<Diagram *> diagrams;
+	QList<Element *> elements;
+	if (m_project) {
+		diagrams = m_project->diagrams();
+	}
+	if (!diagrams.isEmpty())
+	{
+		const ElementProvider ep(m_project);
+		for (const auto &elmt : ep.find(ElementData::Simple | ElementData::Terminal | ElementData::Master | ElementData::Thumbnail)) {
+			if (elmt && isStored(elmt)) {
+				elements << elmt.data();
+			}
+		}
+	}
+
+		//Rows written but which no longer exist in the project
+	QSet<QString> removed_diagrams;
+	for (auto it = m_diagram_table.m_rows.constBegin() ; it != m_diagram_table.m_rows.constEnd() ; ++it) {
+		removed_diagrams.insert(it.key());
+	}
+	for (const auto &diagram : qAsConst(diagrams)) {
+		removed_diagrams.remove(diagram->uuid().toString());
+	}
+
+	QSet<QString> removed_elements;
+	for (auto it = m_element_table.m_rows.constBegin() ; it != m_element_table.m_rows.constEnd() ; ++it) {
+		removed_elements.insert(it.key());
+	}
+	for (const auto &elmt : qAsConst(elements)) {
+		removed_elements.remove(elmt->uuid().toString());
+	}
+
+		//The elements of the diagrams not yet materialized
+		//are written from the description kept by the diagram
+	QHash<QString, QVariantList> pending_rows, pending_info_rows;
+	for (const auto &diagram : qAsConst(diagrams)) {
+		if (!diagram->isMaterialized()) {
+			pendingElementRows(diagram, pending_rows, pending_info_rows);
+		}
+	}
+	for (auto it = pending_rows.constBegin() ; it != pending_rows.constEnd() ; ++it) {
+		removed_elements.remove(it.key());
+	}
+
+	m_data_base.transaction();
+	writeDiagrams(diagrams, removed_diagrams);
+	writeElements(elements, removed_elements, pending_rows, pending_info_rows);
+	m_data_base.commit();
+
 	emit dataBaseUpdated();
 }
 
@@ -101,42 +152,86 @@ QETProject *projectDataBase::project() const
 
 /**
 	@brief projectDataBase::newQuery
+	The pending changes are written before the query is created.
 	@return a QSqlquery with query as query
 	and the internal database of this class as database to use.
 */
 QSqlQuery projectDataBase::newQuery(const QString &query) {
+	flush();
 	return QSqlQuery(query, m_data_base);
 }
 
 /**
-	@brief projectDataBase::addElement
-	@param element
+	@brief projectDataBase::records
+	The pending changes are written before the query is executed.
+	The result is cached until the content of the data base change,
+	so users of the same query share the same result.
+	@param query
+	@return the rows returned by query, each value is converted to the
+	text to display : a date is written in the short format of the locale.
 */
-void projectDataBase::addElement(Element *element)
+QVector<QStringList> projectDataBase::records(const QString &query)
 {
-	m_insert_elements_query.bindValue(":uuid", element->uuid().toString());
-	m_insert_elements_query.bindValue(":diagram_uuid", element->diagram()->uuid().toString());
-	m_insert_elements_query.bindValue(":pos", element->diagram()->convertPosition(element->scenePos()).toString());
-	m_insert_elements_query.bindValue(":type", element->elementData().typeToString());
-	m_insert_elements_query.bindValue(":sub_type", element->kindInformations()["type"].toString());
-	if (!m_insert_elements_query.exec()) {
-		qDebug() << "projectDataBase::addElement insert element error : " << m_insert_elements_query.lastError();
+	flush();
+	const auto cached = m_records_cache.constFind(query);
+	if (cached != m_records_cache.constEnd()) {
+		return cached.value();
 	}
 
-	m_insert_element_info_query.bindValue(":uuid", element->uuid().toString());
-	auto hash = elementInfoToString(element);
-	for (auto key : hash.keys())
-	{
-		QString value = hash.value(key);
-		QString bind = key.prepend(":");
-		m_insert_element_info_query.bindValue(bind, value);
+	QVector<QStringList> records_;
+	QSqlQuery query_(m_data_base);
+	if (!query_.exec(query)) {
+		qDebug() << "Query error : " << query_.lastError();
 	}
 
-	if (!m_insert_element_info_query.exec()) {
-		qDebug() << "projectDataBase::addElement insert element info error : " << m_insert_element_info_query.lastError();
-	} else {
-		emit dataBaseUpdated();
+	const auto column_count = query_.record().count();
+	while (query_.next())
+	{
+		QStringList record_;
+		record_.reserve(column_count);
+		for (auto i = 0 ; i < column_count ; ++i)
+		{
+			const auto value = query_.value(i);
+			const auto text = value.toString();
+				//Only a text which look like a ISO date (yyyy-MM-dd)
+				//can be converted to a date
+			if (text.size() >= 10
+				&& text.at(4) == QLatin1Char('-')
+				&& text.at(7) == QLatin1Char('-'))
+			{
+				const auto date = value.toDate();
+				if (!date.isNull()) {
+					record_ << QLocale::system().toString(date, QLocale::ShortFormat);
+					continue;
+				}
+			}
+			record_ << text;
+		}
+		records_ << record_;
 	}
+
+	m_records_cache.insert(query, records_);
+	return records_;
+}
+
+/**
+	@brief projectDataBase::generation
+	@return the generation of the data base,
+	increased each time the content of a table change.
+*/
+quint64 projectDataBase::generation() const
+{
+	return m_generation;
+}
+
+/**
+	@brief projectDataBase::addElement
+	@param element
+*/
+void projectDataBase::addElement(Element *element)
+{
+	m_dirty_elements.insert(element, element);
+	scheduleFlush();
 }
 
 /**
@@ -145,12 +240,9 @@ void projectDataBase::addElement(Element *element)
 */
 void projectDataBase::removeElement(Element *element)
 {
-	m_remove_element_query.bindValue(":uuid", element->uuid().toString());
-	if(!m_remove_element_query.exec()) {
-		qDebug() << "projectDataBase::removeElement remove error : " << m_remove_element_query.lastError();
-	} else {
-		emit dataBaseUpdated();
-	}
+	m_dirty_elements.remove(element);
+	m_removed_elements.insert(element->uuid().toString());
+	scheduleFlush();
 }
 
 /**
@@ -159,81 +251,50 @@ void projectDataBase::removeElement(Element *element)
 */
 void projectDataBase::elementInfoChanged(Element *element)
 {
-	auto hash = elementInfoToString(element);
-	for (auto str : QETInformation::elementInfoKeys()) {
-		m_update_element_query.bindValue(":" + str, hash.value(str));
-	}
-	m_update_element_query.bindValue(":uuid", element->uuid().toString());
-	if (!m_update_element_query.exec()) {
-		qDebug() << "projectDataBase::elementInfoChanged update error : " << m_update_element_query.lastError();
-	} else {
-		emit dataBaseUpdated();
-	}
+	m_dirty_elements.insert(element, element);
+	scheduleFlush();
 }
 
 void projectDataBase::elementInfoChanged(QList<Element *> elements)
 {
-	this->blockSignals(true);
-		//Block signal for not emit dataBaseUpdated at
-		//each call of the method elementInfoChanged(Element *element)
-
-	m_data_base.transaction();	
 	for (auto elmt : elements) {
-		elementInfoChanged(elmt);
+		m_dirty_elements.insert(elmt, elmt);
 	}
-	m_data_base.commit();
-
-	this->blockSignals(false);
-	emit dataBaseUpdated();
+	scheduleFlush();
 }
 
 void projectDataBase::addDiagram(Diagram *diagram)
 {
-	m_insert_diagram_query.bindValue(":uuid", diagram->uuid().toString());
-	m_insert_diagram_query.bindValue(":pos", m_project->folioIndex(diagram)+1);
-	if(!m_insert_diagram_query.exec()) {
-		qDebug() << "projectDataBase::addDiagram insert error : " << m_insert_diagram_query.lastError();
-	}
-
-	bindDiagramInfoValues(m_insert_diagram_info_query, diagram);
-
-	if (!m_insert_diagram_info_query.exec()) {
-		qDebug() << "projectDataBase::addDiagram insert info error : " << m_insert_diagram_info_query.lastError();
-	}
-
-		//The information "folio" of other existing diagram can have the variable %total,
-		//so when a new diagram is added this variable change.
-		//We need to update this information in the database.
-	for (auto diagram : project()->diagrams())
-	{
-		m_diagram_info_order_changed.bindValue(":folio", diagram->border_and_titleblock.titleblockInformation().value("folio"));
-		m_diagram_info_order_changed.bindValue(":uuid", diagram->uuid());
-		if (!m_diagram_info_order_changed.exec()) {
-			qDebug() << "projectDataBase::addDiagram update diagram infp order error : " << m_diagram_info_order_changed.lastError();
-		}
-	}
-	emit dataBaseUpdated();
+		//The position of the other diagrams and their information "folio"
+		//can change (the variable %total for example),
+		//so every diagram must be checked.
+	for (auto diagram_ : project()->diagrams()) {
+		m_dirty_diagrams.insert(diagram_, diagram_);
+	}
+	m_dirty_diagrams.insert(diagram, diagram);
+	m_removed_diagrams.remove(diagram->uuid().toString());
+	scheduleFlush();
 }
 
 void projectDataBase::removeDiagram(Diagram *diagram)
 {
-	m_remove_diagram_query.bindValue(":uuid", diagram->uuid().toString());
-	if (!m_remove_diagram_query.exec()) {
-		qDebug() << "projectDataBase::removeDiagram delete error : " << m_remove_diagram_query.lastError();
-	} else {
-		emit dataBaseUpdated();
+	m_dirty_diagrams.remove(diagram);
+	m_removed_diagrams.insert(diagram->uuid().toString());
+	for (const auto &data : diagram->pendingContent().elements) {
+		m_removed_elements.insert(data.uuid.toString());
+	}
+	for (auto diagram_ : project()->diagrams()) {
+		if (diagram_ != diagram) {
+			m_dirty_diagrams.insert(diagram_, diagram_);
+		}
 	}
+	scheduleFlush();
 }
 
 void projectDataBase::diagramInfoChanged(Diagram *diagram)
 {
-	bindDiagramInfoValues(m_update_diagram_info_query, diagram);
-
-	if (!m_update_diagram_info_query.exec()) {
-		qDebug() << "projectDataBase::diagramInfoChanged update error : " << m_update_diagram_info_query.lastError();
-	} else {
-		emit dataBaseUpdated();
-	}
+	m_dirty_diagrams.insert(diagram, diagram);
+	scheduleFlush();
 }
 
 void projectDataBase::diagramOrderChanged()
@@ -431,170 +492,257 @@ void projectDataBase::createSummaryView()
 	}
 }
 
-void projectDataBase::populateDiagramTable()
+/**
+	@brief projectDataBase::scheduleFlush
+	Write the pending changes at the next turn of the event loop,
+	several changes made in a row are written in the same transaction.
+	While the project is in a batch, nothing is scheduled :
+	the project call this function again at the end of the batch.
+*/
+void projectDataBase::scheduleFlush()
 {
-	QSqlQuery query_(m_data_base);
-	query_.exec("DELETE FROM diagram");
-
-	for (auto diagram : m_project->diagrams())
-	{
-		m_insert_diagram_query.bindValue(":uuid", diagram->uuid().toString());
-		m_insert_diagram_query.bindValue(":pos", m_project->folioIndex(diagram)+1);
-		if(!m_insert_diagram_query.exec()) {
-			qDebug() << "projectDataBase::populateDiagramTable insert error : " << m_insert_diagram_query.lastError();
-		}
+	if (m_project && m_project->isInBatch()) {
+		return;
+	}
+	if (!m_flush_timer.isActive()) {
+		m_flush_timer.start();
 	}
 }
 
 /**
-	@brief projectDataBase::populateElementTable
-	Populate the element table
+	@brief projectDataBase::flush
+	Write the pending changes of the diagrams and elements marked dirty.
+	Emit the signal dataBaseUpdated if something was pending.
 */
-void projectDataBase::populateElementTable()
+void projectDataBase::flush()
 {
-	QSqlQuery query_(m_data_base);
-	query_.exec("DELETE FROM element");
+	m_flush_timer.stop();
+	if (m_dirty_elements.isEmpty() && m_dirty_diagrams.isEmpty()
+		&& m_removed_elements.isEmpty() && m_removed_diagrams.isEmpty()) {
+		return;
+	}
+
+	QList<Diagram *> diagrams;
+	for (const auto &diagram : qAsConst(m_dirty_diagrams)) {
+		if (diagram && diagram->project() == m_project) {
+			diagrams << diagram.data();
+		}
+	}
 
-	for (auto diagram : m_project->diagrams())
+	QList<Element *> elements;
+	auto removed_elements = m_removed_elements;
+	for (const auto &elmt : qAsConst(m_dirty_elements))
 	{
-		const ElementProvider ep(diagram);
-		const auto elmt_vector = ep.find(ElementData::Simple | ElementData::Terminal | ElementData::Master | ElementData::Thumbnail);
-			//Insert all values into the database
-		for (const auto &elmt : elmt_vector)
-		{
-			const auto elmt_data = elmt->elementData();
-			m_insert_elements_query.bindValue(":uuid", elmt->uuid().toString());
-			m_insert_elements_query.bindValue(":diagram_uuid", diagram->uuid().toString());
-			m_insert_elements_query.bindValue(":pos", diagram->convertPosition(elmt->scenePos()).toString());
-			m_insert_elements_query.bindValue(":type", elmt_data.typeToString());
-			m_insert_elements_query.bindValue(":sub_type", elmt_data.masterTypeToString());
-			if (!m_insert_elements_query.exec()) {
-				qDebug() << "projectDataBase::populateElementTable insert error : " << m_insert_elements_query.lastError();
-			}
+		if (!elmt) {
+			continue;
+		} else if (isStored(elmt)) {
+			elements << elmt.data();
+		} else {
+			removed_elements.insert(elmt->uuid().toString());
 		}
 	}
+	const auto removed_diagrams = m_removed_diagrams;
+
+	m_dirty_elements.clear();
+	m_dirty_diagrams.clear();
+	m_removed_elements.clear();
+	m_removed_diagrams.clear();
+
+	m_data_base.transaction();
+	writeDiagrams(diagrams, removed_diagrams);
+	writeElements(elements, removed_elements);
+	m_data_base.commit();
+
+	emit dataBaseUpdated();
 }
 
 /**
-	@brief projectDataBase::populateElementInfoTable
-	Populate the element info table
+	@brief projectDataBase::writeRows
+	Write rows in table. A row already written with the same values
+	is not written again. The rows which changed are removed
+	then inserted again with the rows to add, each one with a single batch.
+	@param table : the table to write
+	@param rows : the rows to write, keyed by uuid
+	@param removed : uuid of the rows to remove
 */
-void projectDataBase::populateElementInfoTable()
+void projectDataBase::writeRows(TableRows &table,
+				const QHash<QString, QVariantList> &rows,
+				const QSet<QString> &removed)
 {
-	QSqlQuery query(m_data_base);
-	query.exec(QStringLiteral("DELETE FROM element_info"));
+	QVariantList remove_uuid;
+	for (const auto &uuid : removed) {
+		if (table.m_rows.remove(uuid)) {
+			remove_uuid << uuid;
+		}
+	}
 
-	for (const auto &diagram : m_project->diagrams())
+	QVariantList insert_uuid;
+	QList<QVariantList> insert_values;
+	for (auto it = rows.constBegin() ; it != rows.constEnd() ; ++it)
 	{
-		const ElementProvider ep(diagram);
-		const auto elmt_vector = ep.find(ElementData::Simple | ElementData::Terminal | ElementData::Master | ElementData::Thumbnail);
-
-			//Insert all values into the database
-		for (const auto &elmt : elmt_vector)
+		auto stored = table.m_rows.find(it.key());
+		if (stored != table.m_rows.end())
 		{
-			m_insert_element_info_query.bindValue(QStringLiteral(":uuid"), elmt->uuid().toString());
-			const auto hash = elementInfoToString(elmt);
-			for (const auto &key : hash.keys())
-			{
-				QString value = hash.value(key);
-				QString bind = QStringLiteral(":") + key;
-				m_insert_element_info_query.bindValue(bind, value);
+			if (stored.value() == it.value()) {
+				continue;
 			}
+			remove_uuid << it.key();
+		}
+		table.m_rows.insert(it.key(), it.value());
+		insert_uuid << it.key();
+		insert_values << it.value();
+	}
 
-			if (!m_insert_element_info_query.exec()) {
-				qDebug() << "projectDataBase::populateElementInfoTable insert error : " << m_insert_element_info_query.lastError();
+	if (!remove_uuid.isEmpty() || !insert_uuid.isEmpty())
+	{
+		++m_generation;
+		m_records_cache.clear();
+	}
+
+	if (!remove_uuid.isEmpty())
+	{
+		table.m_remove.bindValue(QStringLiteral(":uuid"), remove_uuid);
+		if (!table.m_remove.execBatch()) {
+			qDebug() << "projectDataBase::writeRows remove error : " << table.m_remove.lastError();
+		}
+	}
+
+	if (!insert_uuid.isEmpty())
+	{
+		table.m_insert.bindValue(QStringLiteral(":uuid"), insert_uuid);
+		for (int i = 0 ; i < table.m_binds.size() ; ++i)
+		{
+			QVariantList column;
+			column.reserve(insert_values.size());
+			for (const auto &values : qAsConst(insert_values)) {
+				column << values.value(i);
 			}
+			table.m_insert.bindValue(table.m_binds.at(i), column);
+		}
+		if (!table.m_insert.execBatch()) {
+			qDebug() << "projectDataBase::writeRows insert error : " << table.m_insert.lastError();
 		}
 	}
 }
 
-void projectDataBase::populateDiagramInfoTable()
+/**
+	@brief projectDataBase::writeDiagrams
+	Write the rows of diagrams in the tables diagram and diagram_info
+	@param diagrams : diagrams to write
+	@param removed : uuid of the diagrams to remove
+*/
+void projectDataBase::writeDiagrams(const QList<Diagram *> &diagrams,
+				    const QSet<QString> &removed)
 {
-	QSqlQuery query(m_data_base);
-	query.exec("DELETE FROM diagram_info");
+	QHash<QString, QVariantList> rows, info_rows;
+	rows.reserve(diagrams.size());
+	info_rows.reserve(diagrams.size());
+	for (const auto &diagram : diagrams)
+	{
+		const auto uuid = diagram->uuid().toString();
+		rows.insert(uuid, diagramRow(diagram));
+		info_rows.insert(uuid, diagramInfoRow(diagram));
+	}
+
+	writeRows(m_diagram_table, rows, removed);
+	writeRows(m_diagram_info_table, info_rows, removed);
+}
 
-	for (auto *diagram : m_project->diagrams())
+/**
+	@brief projectDataBase::writeElements
+	Write the rows of elements in the tables element and element_info
+	@param elements : elements to write
+	@param removed : uuid of the elements to remove
+	@param pending_rows : rows of the table element to write
+	for the elements of the diagrams not yet materialized
+	@param pending_info_rows : rows of the table element_info to write
+	for the elements of the diagrams not yet materialized
+*/
+void projectDataBase::writeElements(const QList<Element *> &elements,
+				    const QSet<QString> &removed,
+				    const QHash<QString, QVariantList> &pending_rows,
+				    const QHash<QString, QVariantList> &pending_info_rows)
+{
+	auto rows = pending_rows;
+	auto info_rows = pending_info_rows;
+	rows.reserve(rows.size() + elements.size());
+	info_rows.reserve(info_rows.size() + elements.size());
+	for (const auto &elmt : elements)
 	{
-		bindDiagramInfoValues(m_insert_diagram_info_query, diagram);
+		const auto uuid = elmt->uuid().toString();
+		rows.insert(uuid, elementRow(elmt));
+		info_rows.insert(uuid, elementInfoRow(elmt));
+	}
 
-		if (!m_insert_diagram_info_query.exec()) {
-			qDebug() << "projectDataBase::populateDiagramInfoTable insert error : " << m_insert_diagram_info_query.lastError();
-		}
+	writeRows(m_element_table, rows, removed);
+	writeRows(m_element_info_table, info_rows, removed);
+}
+
+/**
+	@brief projectDataBase::isStored
+	@param element
+	@return true if element must be written in the data base
+*/
+bool projectDataBase::isStored(Element *element) const
+{
+	if (!element->diagram() || element->diagram()->project() != m_project) {
+		return false;
 	}
+
+	const ElementData::Types types(ElementData::Simple | ElementData::Terminal | ElementData::Master | ElementData::Thumbnail);
+	return types.testFlag(element->elementData().m_type);
 }
 
 void projectDataBase::prepareQuery()
 {
-		//INSERT DIAGRAM
-	m_insert_diagram_query = QSqlQuery(m_data_base);
-	m_insert_diagram_query.prepare("INSERT INTO diagram (uuid, pos) VALUES (:uuid, :pos)");
-
-		//REMOVE DIAGRAM
-	m_remove_diagram_query = QSqlQuery(m_data_base);
-	m_remove_diagram_query.prepare("DELETE FROM diagram WHERE uuid=:uuid");
-
-		//INSERT DIAGRAM INFO
-	m_insert_diagram_info_query = QSqlQuery(m_data_base);
-	QStringList bind_diag_info_values;
-	for (auto key : QETInformation::diagramInfoKeys()) {
-		bind_diag_info_values << key.prepend(":");
-	}
-	QString insert_diag_info("INSERT INTO diagram_info (diagram_uuid, " +
-				   QETInformation::diagramInfoKeys().join(", ") +
-				   ") VALUES (:uuid, " +
-				   bind_diag_info_values.join(", ") +
-				   ")");
-	m_insert_diagram_info_query.prepare(insert_diag_info);
-
-		//UPDATE DIAGRAM INFO
-	QString update_diagram_str("UPDATE diagram_info SET ");
-	for (auto str : QETInformation::diagramInfoKeys()) {
-		update_diagram_str.append(str + " = :" + str + ", ");
-	}
-	update_diagram_str.remove(update_diagram_str.length()-2, 2); //Remove the last ", "
-	update_diagram_str.append(" WHERE diagram_uuid = :uuid");
-	m_update_diagram_info_query = QSqlQuery(m_data_base);
-	m_update_diagram_info_query.prepare(update_diagram_str);
-
-		//UPDATE DIAGRAM ORDER
-	m_diagram_order_changed = QSqlQuery(m_data_base);
-	m_diagram_order_changed.prepare("UPDATE diagram SET pos = :pos WHERE uuid = :uuid");
-	m_diagram_info_order_changed = QSqlQuery(m_data_base);
-	m_diagram_info_order_changed.prepare("UPDATE diagram_info SET folio = :folio WHERE diagram_uuid = :uuid");
-
-		//INSERT ELEMENT
-	QString insert_element_query("INSERT INTO element (uuid, diagram_uuid, pos, type, sub_type) VALUES (:uuid, :diagram_uuid, :pos, :type, :sub_type)");
-	m_insert_elements_query = QSqlQuery(m_data_base);
-	m_insert_elements_query.prepare(insert_element_query);
-
-
-		//INSERT ELEMENT INFO
-	QStringList bind_values;
-	for (auto key : QETInformation::elementInfoKeys()) {
-		bind_values << key.prepend(":");
-	}
-	QString insert_element_info("INSERT INTO element_info (element_uuid," +
-				   QETInformation::elementInfoKeys().join(", ") +
-				   ") VALUES (:uuid," +
-				   bind_values.join(", ") +
-				   ")");
-	m_insert_element_info_query = QSqlQuery(m_data_base);
-	m_insert_element_info_query.prepare(insert_element_info);
-
-		//REMOVE ELEMENT
-	QString remove_element("DELETE FROM element WHERE uuid=:uuid");
-	m_remove_element_query = QSqlQuery(m_data_base);
-	m_remove_element_query.prepare(remove_element);
-
-		//UPDATE ELEMENT INFO
-	QString update_str("UPDATE element_info SET ");
-	for (auto string : QETInformation::elementInfoKeys()) {
-		update_str.append(string + " = :" + string + ", ");
-	}
-	update_str.remove(update_str.length()-2, 2); //Remove the last ", "
-	update_str.append(" WHERE element_uuid = :uuid");
-	m_update_element_query = QSqlQuery(m_data_base);
-	m_update_element_query.prepare(update_str);
+	prepareTable(m_diagram_table,
+		     QStringLiteral("diagram"),
+		     QStringLiteral("uuid"),
+		     QStringList{QStringLiteral("pos")});
+	prepareTable(m_diagram_info_table,
+		     QStringLiteral("diagram_info"),
+		     QStringLiteral("diagram_uuid"),
+		     QETInformation::diagramInfoKeys());
+	prepareTable(m_element_table,
+		     QStringLiteral("element"),
+		     QStringLiteral("uuid"),
+		     QStringList{QStringLiteral("diagram_uuid"),
+				 QStringLiteral("pos"),
+				 QStringLiteral("type"),
+				 QStringLiteral("sub_type")});
+	prepareTable(m_element_info_table,
+		     QStringLiteral("element_info"),
+		     QStringLiteral("element_uuid"),
+		     QETInformation::elementInfoKeys());
+}
+
+/**
+	@brief projectDataBase::prepareTable
+	Prepare the insert and remove queries of table
+	@param table
+	@param name : name of the table in the data base
+	@param uuid_column : name of the column which store the uuid
+	@param columns : name of the other columns
+*/
+void projectDataBase::prepareTable(TableRows &table,
+				   const QString &name,
+				   const QString &uuid_column,
+				   const QStringList &columns)
+{
+	table.m_binds.clear();
+	for (const auto &column : columns) {
+		table.m_binds << QStringLiteral(":") + column;
+	}
+
+	table.m_insert = QSqlQuery(m_data_base);
+	table.m_insert.prepare("INSERT INTO " + name + " (" + uuid_column + ", " +
+			       columns.join(", ") +
+			       ") VALUES (:uuid, " +
+			       table.m_binds.join(", ") +
+			       ")");
+
+	table.m_remove = QSqlQuery(m_data_base);
+	table.m_remove.prepare("DELETE FROM " + name + " WHERE " + uuid_column + " = :uuid");
 }
 
 /**
@@ -618,23 +766,115 @@ QHash<QString, QString> projectDataBase::elementInfoToString(Element *elmt)
 	return hash;
 }
 
-void projectDataBase::bindDiagramInfoValues(QSqlQuery &query, Diagram *diagram)
+/**
+	@brief projectDataBase::elementRow
+	@param element
+	@return the values of the row of element in the table element
+*/
+QVariantList projectDataBase::elementRow(Element *element) const
+{
+	const auto elmt_data = element->elementData();
+	return QVariantList{element->diagram()->uuid().toString(),
+				element->diagram()->convertPosition(element->scenePos()).toString(),
+				elmt_data.typeToString(),
+				elmt_data.masterTypeToString()};
+}
+
+/**
+	@brief projectDataBase::elementInfoRow
+	@param element
+	@return the values of the row of element in the table element_info
+*/
+QVariantList projectDataBase::elementInfoRow(Element *element)
+{
+	const auto hash = elementInfoToString(element);
+	QVariantList row;
+	for (const auto &key : QETInformation::elementInfoKeys()) {
+		row << hash.value(key);
+	}
+	return row;
+}
+
+/**
+	@brief projectDataBase::pendingElementRows
+	Add to rows and info_rows the rows of the elements of diagram
+	while diagram is not materialized, from the description kept by diagram
+	(see Diagram::pendingContent). The type of each element is read
+	from its definition, the label is the label written in the project file.
+	The elements without uuid (project older than 0.5) are not written.
+	@param diagram
+	@param rows : rows of the table element, keyed by uuid
+	@param info_rows : rows of the table element_info, keyed by uuid
+*/
+void projectDataBase::pendingElementRows(Diagram *diagram,
+					 QHash<QString, QVariantList> &rows,
+					 QHash<QString, QVariantList> &info_rows) const
 {
-	query.bindValue(":uuid", diagram->uuid());
+	const ElementData::Types types(ElementData::Simple | ElementData::Terminal | ElementData::Master | ElementData::Thumbnail);
+	const auto diagram_uuid = diagram->uuid().toString();
+	QHash<QString, ElementData> elements_data;
 
-	auto infos = diagram->border_and_titleblock.titleblockInformation();
-	for (auto key : QETInformation::diagramInfoKeys())
+	for (const auto &data : diagram->pendingContent().elements)
+	{
+		if (data.uuid.isNull()) {
+			continue;
+		}
+
+		if (!elements_data.contains(data.type))
+		{
+			const auto definition = ElementDefinitionCache::instance()
+					->definition(data.location(m_project));
+			elements_data.insert(data.type, definition ? definition->elementData()
+								   : ElementData());
+		}
+		const auto elmt_data = elements_data.value(data.type);
+		if (!types.testFlag(elmt_data.m_type)) {
+			continue;
+		}
+
+		const auto uuid = data.uuid.toString();
+		rows.insert(uuid, QVariantList{diagram_uuid,
+					       diagram->convertPosition(data.pos).toString(),
+					       elmt_data.typeToString(),
+					       elmt_data.masterTypeToString()});
+
+		QVariantList info_row;
+		for (const auto &key : QETInformation::elementInfoKeys()) {
+			info_row << data.informations[key].toString();
+		}
+		info_rows.insert(uuid, info_row);
+	}
+}
+
+/**
+	@brief projectDataBase::diagramRow
+	@param diagram
+	@return the values of the row of diagram in the table diagram
+*/
+QVariantList projectDataBase::diagramRow(Diagram *diagram) const
+{
+	return QVariantList{m_project->folioIndex(diagram)+1};
+}
+
+/**
+	@brief projectDataBase::diagramInfoRow
+	@param diagram
+	@return the values of the row of diagram in the table diagram_info
+*/
+QVariantList projectDataBase::diagramInfoRow(Diagram *diagram)
+{
+	const auto infos = diagram->border_and_titleblock.titleblockInformation();
+	QVariantList row;
+	for (const auto &key : QETInformation::diagramInfoKeys())
 	{
-		if (key == "date") {
-			query.bindValue( ":date",
-							 QLocale::system().toDate(infos.value("date").toString(),
-													  QLocale::ShortFormat));
+		if (key == QLatin1String("date")) {
+			row << QLocale::system().toDate(infos.value(QStringLiteral("date")).toString(),
+							QLocale::ShortFormat);
 		} else {
-			auto value = infos.value(key);
-			auto bind = key.prepend(":");
-			query.bindValue(bind, value);
+			row << infos.value(key);
 		}
 	}
+	return row;
 }
 
 #ifdef QET_EXPORT_PROJECT_DB
@@ -689,6 +929,7 @@ void projectDataBase::exportDb(projectDataBase *db,
 	if (path_.isNull()) {
 		return;
 	}
+	db->flush();
 
 	QString connection_name("export_project_db_" + db->project()->uuid().toString());
 
@@ -23,6 +23,11 @@
 #include <QSqlQuery>
 #include <QPointer>
 #include <QFileDialog>
+#include <QHash>
+#include <QSet>
+#include <QStringList>
+#include <QTimer>
+#include <QVector>
 
 class Element;
 class QETProject;
@@ -33,6 +38,16 @@ class sqlite3;
 	@brief The projectDataBase class
 	This class wraps a sqlite data base where you can find several things
 	about the content of a project.
+ *
+	The tables are written inside a transaction and only the rows
+	which changed since the last write are deleted and inserted again.
+	Elements and diagrams changed through the hooks addElement,
+	elementInfoChanged, diagramInfoChanged... are marked dirty and written
+	together, at the next turn of the event loop or before the next query.
+ *
+	Each write which change the content of a table increase the generation
+	of the data base. The results of records() are cached per query until
+	the next generation, several users of the same query share the result.
  *
 	@note this class is still in development.
 */
@@ -47,6 +62,8 @@ class projectDataBase : public QObject
 		void updateDB();
 		QETProject *project() const;
 		QSqlQuery newQuery(const QString &query = QString());
+		QVector<QStringList> records(const QString &query);
+		quint64 generation() const;
 
 		void addElement         (Element *element);
 		void removeElement      (Element *element);
@@ -57,36 +74,75 @@ class projectDataBase : public QObject
 		void removeDiagram      (Diagram *diagram);
 		void diagramInfoChanged (Diagram *diagram);
 		void diagramOrderChanged();
+		void scheduleFlush();
 
 	signals:
 		void dataBaseUpdated();
 
 	private:
+		/**
+			@brief The TableRows struct
+			Copy of the rows written in a table, keyed by uuid.
+			Used to write only the rows which changed.
+		*/
+		struct TableRows
+		{
+			QSqlQuery m_insert,
+					  m_remove;
+				//Bind names of the columns, in the same order
+				//as the values of a row. The uuid is not in the list.
+			QStringList m_binds;
+			QHash<QString, QVariantList> m_rows;
+		};
+
 		bool createDataBase();
 		void createElementNomenclatureView();
 		void createSummaryView();
-		void populateDiagramTable();
-		void populateElementTable();
-		void populateElementInfoTable();
-		void populateDiagramInfoTable();
+		void flush();
+		void writeRows(TableRows &table,
+			       const QHash<QString, QVariantList> &rows,
+			       const QSet<QString> &removed);
+		void writeDiagrams(const QList<Diagram *> &diagrams,
+				   const QSet<QString> &removed);
+		void writeElements(const QList<Element *> &elements,
+				   const QSet<QString> &removed,
+				   const QHash<QString, QVariantList> &pending_rows = QHash<QString, QVariantList>(),
+				   const QHash<QString, QVariantList> &pending_info_rows = QHash<QString, QVariantList>());
+		void pendingElementRows(Diagram *diagram,
+					QHash<QString, QVariantList> &rows,
+					QHash<QString, QVariantList> &info_rows) const;
+		bool isStored(Element *element) const;
 		void prepareQuery();
+		void prepareTable(TableRows &table,
+				  const QString &name,
+				  const QString &uuid_column,
+				  const QStringList &columns);
 		static QHash<QString, QString> elementInfoToString(
 				Element *elmt);
-		void bindDiagramInfoValues(QSqlQuery &query, Diagram *diagram);
+		QVariantList elementRow(Element *element) const;
+		static QVariantList elementInfoRow(Element *element);
+		QVariantList diagramRow(Diagram *diagram) const;
+		static QVariantList diagramInfoRow(Diagram *diagram);
 
 	private:
 		QPointer<QETProject> m_project;
 		QSqlDatabase m_data_base;
-		QSqlQuery m_insert_elements_query,
-				  m_insert_element_info_query,
-				  m_remove_element_query,
-				  m_update_element_query,
-				  m_insert_diagram_query,
-				  m_remove_diagram_query,
-				  m_insert_diagram_info_query,
-				  m_update_diagram_info_query,
-				  m_diagram_order_changed,
-				  m_diagram_info_order_changed;
+		TableRows m_diagram_table,
+				  m_diagram_info_table,
+				  m_element_table,
+				  m_element_info_table;
+
+			//Changes not yet written in the data base
+		QHash<Element *, QPointer<Element>> m_dirty_elements;
+		QHash<Diagram *, QPointer<Diagram>> m_dirty_diagrams;
+		QSet<QString> m_removed_elements,
+					  m_removed_diagrams;
+		QTimer m_flush_timer;
+
+			//Increased each time the content of a table change
+		quint64 m_generation = 0;
+			//Result of records() for each query, at the current generation
+		QHash<QString, QVector<QStringList>> m_records_cache;
 
 #ifdef QET_EXPORT_PROJECT_DB
 	public:
@@ -36,10 +36,13 @@
 #include "qetgraphicsitem/independenttextitem.h"
 #include "qetgraphicsitem/qetshapeitem.h"
 #include "qetgraphicsitem/terminal.h"
+#include "project/diagramcontentdata.h"
+#include "project/projectxmlcache.h"
 #include "qetxml.h"
 #include "undocommand/addelementtextcommand.h"
+#include "utils/qetsettings.h"
+#include "utils/terminalindex.h"
 
-#include <cassert>
 #include <math.h>
 
 int Diagram::xGrid  = 10;
@@ -72,14 +75,26 @@ Diagram::Diagram(QETProject *project) :
 	m_freeze_new_elements   (false),
 	m_freeze_new_conductors_ (false)
 {
-	setItemIndexMethod(QGraphicsScene::NoIndex);
-	/* Set to no index,
-	 * because they can be the source of the crash with conductor and shape ghost.
+	/* The BSP tree index was disabled
+	 * because it was the source of the crash with conductor and shape ghost :
+	 * conductor and shape changed their shape when hovered
+	 * without calling prepareGeometryChange,
+	 * the index kept an obsolete bounding rect of the item.
 	 * https://forum.qt.io/topic/71316/qgraphicsscenefinditembsptreevisitor-visit-crashes-due-to-an-obsolete-paintevent-after-qgraphicsscene-removeitem
 	 * https://stackoverflow.com/questions/38458830/crash-after-qgraphicssceneremoveitem-with-custom-item-class
 	 * http://www.qtcentre.org/archive/index.php/t-33730.html
 	 * http://tech-artists.org/t/qt-properly-removing-qgraphicitems/3063
+	 * Every item of a diagram now call prepareGeometryChange before
+	 * a change of his bounding rect, the items with a bounding rect
+	 * computed from other objects (ElementTextItemGroup, TerminalStripItem)
+	 * keep it in cache and update it themself, the index can be used again.
+	 * The setting "diagrameditor/use_bsp_index" can disable it
+	 * if an item still don't respect this rule.
 	 */
+	setItemIndexMethod(
+				QetSettings::diagramUseBspIndex()
+				? QGraphicsScene::BspTreeIndex
+				: QGraphicsScene::NoIndex);
 
 	qgi_manager_ = new QGIManager(this);
 	setBackgroundBrush(Qt::white);
@@ -191,51 +206,117 @@ void Diagram::drawBackground(QPainter *p, const QRectF &r) {
 			 * then grid spots shall be white,
 			 * else they shall be black in color.
 			 */
-		QPen pen;
-		Diagram::background_color == Qt::black? pen.setColor(Qt::white)
-							  : pen.setColor(Qt::black);
-		pen.setCosmetic(true);
-		p->setPen(pen);
-
-		p -> setBrush(Qt::NoBrush);
+		const QColor grid_color = Diagram::background_color == Qt::black
+					  ? QColor(Qt::white)
+					  : QColor(Qt::black);
 
 		// If user allow zoom out beyond of folio,
 		// we draw grid outside of border.
-		QSettings settings;
-		int xGrid = settings.value(QStringLiteral("diagrameditor/Xgrid"),
-								   Diagram::xGrid).toInt();
-		int yGrid = settings.value(QStringLiteral("diagrameditor/Ygrid"),
-								   Diagram::yGrid).toInt();
-		QRectF rect = settings.value(
-					QStringLiteral("diagrameditor/zoom-out-beyond-of-folio"),
-					false).toBool() ? r
-							: border_and_titleblock
-							  .insideBorderRect()
-							  .intersected(r);
-
-		qreal limit_x = rect.x() + rect.width();
-		qreal limit_y = rect.y() + rect.height();
-
-		int g_x = (int)ceil(rect.x());
-		while (g_x % xGrid) ++ g_x;
-		int g_y = (int)ceil(rect.y());
-		while (g_y % yGrid) ++ g_y;
-
-		QPolygon points;
-		for (int gx = g_x ; gx < limit_x ; gx += xGrid) {
-			for (int gy = g_y ; gy < limit_y ; gy += yGrid) {
-				points << QPoint(gx, gy);
+		int xGrid = QetSettings::diagramEditorXGrid();
+		int yGrid = QetSettings::diagramEditorYGrid();
+		int point_size = QetSettings::diagramEditorGridPointSize();
+		QRectF rect = QetSettings::zoomOutBeyondOfFolio()
+				? r
+				: border_and_titleblock.insideBorderRect().intersected(r);
+
+		const QTransform transform = p -> worldTransform();
+		if (p -> device()
+				&& p -> device() -> devType() == QInternal::Widget
+				&& transform.type() <= QTransform::TxScale
+				&& transform.m11() > 0 && transform.m22() > 0
+				&& xGrid > 0 && yGrid > 0)
+		{
+				//On screen the grid is filled with a tile of one step
+				//of the grid, the tile is in pixels of the view.
+			const int tile_width  = qMax(1, qRound(xGrid * transform.m11()));
+			const int tile_height = qMax(1, qRound(yGrid * transform.m22()));
+			QBrush brush(gridTile(tile_width, tile_height, point_size, grid_color));
+			brush.setTransform(QTransform::fromScale(qreal(xGrid) / tile_width,
+								 qreal(yGrid) / tile_height));
+
+				//Keep the whole points at the edge of rect
+			const qreal margin_x = point_size / (2 * transform.m11());
+			const qreal margin_y = point_size / (2 * transform.m22());
+			p -> fillRect(rect.adjusted(-margin_x, -margin_y,
+						    margin_x, margin_y),
+				      brush);
+		}
+		else
+		{
+			QPen pen(grid_color);
+			pen.setCosmetic(true);
+			pen.setWidth(point_size);
+			p -> setPen(pen);
+			p -> setBrush(Qt::NoBrush);
+
+			qreal limit_x = rect.x() + rect.width();
+			qreal limit_y = rect.y() + rect.height();
+
+			int g_x = (int)ceil(rect.x());
+			while (g_x % xGrid) ++ g_x;
+			int g_y = (int)ceil(rect.y());
+			while (g_y % yGrid) ++ g_y;
+
+			QPolygon points;
+			for (int gx = g_x ; gx < limit_x ; gx += xGrid) {
+				for (int gy = g_y ; gy < limit_y ; gy += yGrid) {
+					points << QPoint(gx, gy);
+				}
 			}
+			p -> drawPoints(points);
 		}
-		pen.setWidth(settings.value(QStringLiteral("diagrameditor/grid_pointsize"), 1).toInt());
-		p -> setPen(pen);
-		p -> drawPoints(points);
 	}
 
 	if (use_border_) border_and_titleblock.draw(p);
 	p -> restore();
 }
 
+/**
+	@brief Diagram::gridTile
+	@param width : width of the tile in pixels
+	@param height : height of the tile in pixels
+	@param point_size : size of a point of the grid in pixels
+	@param color : color of the points
+	@return a tile of one step of the grid, with a point
+	at the top left corner wrapped around the edges of the tile.
+	The last built tile is kept and only built again when
+	one of the parameters change.
+*/
+const QPixmap &Diagram::gridTile(int width,
+				 int height,
+				 int point_size,
+				 const QColor &color)
+{
+	static QPixmap tile;
+	static int tile_point_size = 0;
+	static QColor tile_color;
+
+	if (tile.isNull()
+			|| tile.width() != width
+			|| tile.height() != height
+			|| tile_point_size != point_size
+			|| tile_color != color)
+	{
+		tile = QPixmap(width, height);
+		tile.fill(Qt::transparent);
+		tile_point_size = point_size;
+		tile_color = color;
+
+		const int w = qMin(qMax(point_size, 1), width);
+		const int h = qMin(qMax(point_size, 1), height);
+		const int x = w == width  ? 0 : -(point_size / 2);
+		const int y = h == height ? 0 : -(point_size / 2);
+
+		QPainter painter(&tile);
+		for (const int dx : {0, width}) {
+			for (const int dy : {0, height}) {
+				painter.fillRect(QRect(x + dx, y + dy, w, h), color);
+			}
+		}
+	}
+	return tile;
+}
+
 /**
 	@brief Diagram::mouseDoubleClickEvent
 	This event is managed by diagram event interface if any.
@@ -596,6 +677,17 @@ QString Diagram::conductorsAutonumName() const
 */
 void Diagram::setConductorsAutonumName(const QString &name) {
 	m_conductors_autonum_name= name;
+	emit diagramPropertiesChanged();
+}
+
+/**
+	@brief Diagram::setDefaultConductorProperties
+	@param properties : properties of the new conductors of this diagram
+*/
+void Diagram::setDefaultConductorProperties(const ConductorProperties &properties)
+{
+	defaultConductorProperties = properties;
+	emit diagramPropertiesChanged();
 }
 
 /**
@@ -705,7 +797,7 @@ QSize Diagram::imageSize() const
 */
 bool Diagram::isEmpty() const
 {
-	return(!items().count());
+	return(!items().count() && isMaterialized());
 }
 
 /**
@@ -875,6 +967,27 @@ QDomDocument Diagram::toXml(bool whole_content) {
 	}
 	document.appendChild(dom_root);
 
+		//The content was never loaded in the scene,
+		//write it back as it was read.
+	if (!isMaterialized())
+	{
+		if (whole_content)
+		{
+			QDomDocument pending;
+			pending.setContent(m_pending_xml);
+			const QStringList content_tags = contentXmlTagNames();
+			for (auto child = pending.documentElement().firstChildElement() ;
+				 !child.isNull() ;
+				 child = child.nextSiblingElement())
+			{
+				if (content_tags.contains(child.tagName())) {
+					dom_root.appendChild(document.importNode(child, true));
+				}
+			}
+		}
+		return(document);
+	}
+
 	if (items().isEmpty())
 		return(document);
 
@@ -1124,72 +1237,6 @@ bool Diagram::initFromXml(QDomElement &document,
 	return(from_xml);
 }
 
-/**
-	@brief findTerminal
-	Find terminal to which the conductor should be connected
-	@param conductor_index 1 or 2 depending on which terminal is searched
-	@param f Conductor xml element
-	@param table_adr_id Hash table to all terminal id assignement (legacy)
-	@param added_elements Elements found in the xml file
-	@return
-*/
-Terminal* findTerminal(int conductor_index,
-					   QDomElement& f,
-					   QHash<int,Terminal *>& table_adr_id,
-					   QList<Element *>& added_elements)
-{
-	assert(conductor_index == 1 || conductor_index == 2);
-
-	auto str_index = QString::number(conductor_index);
-	QString element_index  = QStringLiteral("element")  + str_index;
-	QString terminal_index = QStringLiteral("terminal") + str_index;
-
-	if (f.hasAttribute(element_index)) {
-		QUuid element_uuid = QUuid(f.attribute(element_index));
-		// element1 did not exist in the conductor part of the xml until prior 0.7
-		// It is used as an indicator that uuid's are used to identify terminals
-		bool element_found = false;
-		for (auto element: added_elements) {
-			if (element->uuid() != element_uuid)
-				continue;
-			element_found = true;
-			QUuid terminal_uuid = QUuid(f.attribute(terminal_index));
-			for (auto terminal: element->terminals()) {
-				if (terminal->uuid() != terminal_uuid)
-					continue;
-
-				return terminal;
-			}
-			qDebug() << "Diagram::fromXml() : "
-				 << terminal_index
-				 << ":"
-				 << terminal_uuid
-				 << "not found in "
-				 << element_index
-				 << ":"
-				 << element_uuid;
-			break;
-		}
-		if (!element_found)
-			qDebug() << "Diagram::fromXml() : "
-				 <<  element_index
-				  << ": "
-				  << element_uuid
-				  << "not found";
-	} else {
-		// Backward compatibility.
-		// Until version 0.7 a generated id is used to link the terminal.
-		int id_p1 = f.attribute(terminal_index).toInt();
-		if (!table_adr_id.contains(id_p1)) {
-			qDebug() << "Diagram::fromXml() : terminal id "
-				 << id_p1
-				 << " not found";
-		} else
-			return table_adr_id.value(id_p1);
-	}
-	return nullptr;
-}
-
 /**
 	@brief Diagram::fromXml
 	Imports the described schema in an XML element. If a position is
@@ -1330,16 +1377,31 @@ bool Diagram::fromXml(QDomElement &document,
 			}
 		}
 	}
-		//Load all elements from the XML
+	addContent(DiagramContentData::fromXml(root), position, content_ptr);
+	return(true);
+}
+
+/**
+	@brief Diagram::addContent
+	Build the graphics items described by content and add them to this diagram.
+	The content is decoded from xml by DiagramContentData::fromXml
+	which can be called by a worker thread, only the items are created here.
+	@param content : the content to add
+	@param position : if not null, the added items are positioned in such a way
+	that the upper left corner of their bounding rect is at this position.
+	@param content_ptr : if not null, it will be filled with the added content
+*/
+void Diagram::addContent(const DiagramContentData &content,
+			 QPointF position,
+			 DiagramContent *content_ptr)
+{
+		//Load all elements
 	QList<Element *> added_elements;
 	QHash<int, Terminal *> table_adr_id;
-	for (auto element_xml :
-		 QET::findInDomElement(root, QStringLiteral("elements"), QStringLiteral("element")))
+	for (const auto &element_data : content.elements)
 	{
-		if (!Element::valideXml(element_xml)) continue;
-
 		// cree un element dont le type correspond a l'id type
-		QString type_id = element_xml.attribute(QStringLiteral("type"));
+		const QString &type_id = element_data.type;
 		ElementsLocation element_location;
 		if (type_id.startsWith(QStringLiteral("embed://"))) {
 			element_location = ElementsLocation(type_id, m_project);
@@ -1366,7 +1428,7 @@ bool Diagram::fromXml(QDomElement &document,
 
 		addItem(nvel_elmt);
 		//Loading fail, remove item from the diagram
-		if (!nvel_elmt->fromXml(element_xml, table_adr_id))
+		if (!nvel_elmt->fromContentData(element_data, table_adr_id))
 		{
 			removeItem(nvel_elmt);
 			delete nvel_elmt;
@@ -1378,9 +1440,7 @@ bool Diagram::fromXml(QDomElement &document,
 
 		// Load text
 	QList<IndependentTextItem *> added_texts;
-	for (auto text_xml : QET::findInDomElement(root,
-											   QStringLiteral("inputs"),
-											   QStringLiteral("input"))) {
+	for (const auto &text_xml : content.texts) {
 		IndependentTextItem *iti = new IndependentTextItem();
 		iti -> fromXml(text_xml);
 		addItem(iti);
@@ -1389,9 +1449,7 @@ bool Diagram::fromXml(QDomElement &document,
 
 		// Load image
 	QList<DiagramImageItem *> added_images;
-	for (auto image_xml : QET::findInDomElement(root,
-												QStringLiteral("images"),
-												QStringLiteral("image"))) {
+	for (const auto &image_xml : content.images) {
 		DiagramImageItem *dii = new DiagramImageItem ();
 		dii -> fromXml(image_xml);
 		addItem(dii);
@@ -1400,9 +1458,7 @@ bool Diagram::fromXml(QDomElement &document,
 
 		// Load shape
 	QList<QetShapeItem *> added_shapes;
-	for (auto shape_xml : QET::findInDomElement(root,
-												QStringLiteral("shapes"),
-												QStringLiteral("shape"))) {
+	for (const auto &shape_xml : content.shapes) {
 		QetShapeItem *dii = new QetShapeItem (QPointF(0,0));
 		dii -> fromXml(shape_xml);
 		addItem(dii);
@@ -1410,17 +1466,14 @@ bool Diagram::fromXml(QDomElement &document,
 	}
 
 		// Load conductor
+	const TerminalIndex terminal_index(added_elements, table_adr_id);
 	QList<Conductor *> added_conductors;
-	for (auto f : QET::findInDomElement(root,
-										QStringLiteral("conductors"),
-										QStringLiteral("conductor")))
+	for (const auto &f : content.conductors)
 	{
-		if (!Conductor::valideXml(f)) continue;
-
 		//Check if terminal that conductor must be linked is know
 
-		Terminal* p1 = findTerminal(1, f, table_adr_id, added_elements);
-		Terminal* p2 = findTerminal(2, f, table_adr_id, added_elements);
+		Terminal* p1 = terminal_index.conductorTerminal(1, f);
+		Terminal* p2 = terminal_index.conductorTerminal(2, f);
 
 		if (p1 && p2 && p1 != p2)
 		{
@@ -1428,7 +1481,7 @@ bool Diagram::fromXml(QDomElement &document,
 			if (c->isValid())
 			{
 				addItem(c);
-				c -> fromXml(f);
+				c -> fromContentData(f);
 				added_conductors << c;
 			}
 			else
@@ -1438,9 +1491,7 @@ bool Diagram::fromXml(QDomElement &document,
 
 		//Load tables
 	QVector<QetGraphicsTableItem *> added_tables;
-	for (const auto &dom_table : QETXML::subChild(root,
-												  QStringLiteral("tables"),
-												  QetGraphicsTableItem::xmlTagName()))
+	for (const auto &dom_table : content.tables)
 	{
 		auto table = new QetGraphicsTableItem();
 		addItem(table);
@@ -1449,7 +1500,7 @@ bool Diagram::fromXml(QDomElement &document,
 	}
 
 		//Load terminal strip item
-	QVector<TerminalStripItem *> added_strips { TerminalStripItemXml::fromXml(this, root) };
+	QVector<TerminalStripItem *> added_strips { TerminalStripItemXml::fromXml(this, content.xml) };
 
 	//Translate items if a new position was given in parameter
 	if (position != QPointF())
@@ -1508,7 +1559,6 @@ bool Diagram::fromXml(QDomElement &document,
 	}
 
 	adjustSceneRect();
-	return(true);
 }
 
 /**
@@ -1548,6 +1598,101 @@ void Diagram::folioSequentialsFromXml(const QDomElement &root,
 	}
 }
 
+/**
+	@brief Diagram::isMaterialized
+	@return false if the content of this diagram
+	was not yet loaded in the scene.
+	@see materialize()
+*/
+bool Diagram::isMaterialized() const
+{
+	return m_pending_xml.isEmpty();
+}
+
+/**
+	@brief Diagram::materialize
+	Load in the scene the content given to setPendingXml().
+	The links between elements are not done here,
+	use QETProject::materializeDiagram to also load the linked diagrams
+	and init the links.
+	@return true if the content is successfully loaded
+	or if the diagram is already materialized.
+*/
+bool Diagram::materialize()
+{
+	if (isMaterialized()) {
+		return true;
+	}
+
+	QDomDocument document;
+	if (!document.setContent(m_pending_xml)) {
+		return false;
+	}
+
+		//Clear before load, fromXml add items and this
+		//diagram must be considered as materialized from now.
+	m_pending_xml.clear();
+	m_pending_content = DiagramContentData();
+
+		//The content was already in the project when it was opened,
+		//it's loaded even if the project is read only.
+	m_materializing = true;
+	QDomElement root = document.documentElement();
+	const bool loaded = fromXml(root, QPointF(), false);
+	m_materializing = false;
+	return loaded;
+}
+
+/**
+	@brief Diagram::setPendingXml
+	Keep the xml description of the content of this diagram
+	without build the graphics items.
+	The properties of the diagram must be already loaded with initFromXml.
+	The content will be loaded in the scene by materialize().
+	@param xml : the whole xml description of the diagram, UTF-8 encoded
+	@param content : the description of the elements and tables
+	of the diagram, see DiagramContentData::fromXml(const pugi::xml_node &)
+*/
+void Diagram::setPendingXml(const QByteArray &xml,
+			    const DiagramContentData &content)
+{
+	m_pending_xml = xml;
+	m_pending_content = content;
+}
+
+/**
+	@brief Diagram::pendingContent
+	@return the description of the elements and tables
+	of this diagram while it is not materialized,
+	an empty description once materialized.
+	Used by the features which only need to know what the diagram
+	contains (project database, search...) to not materialize it.
+*/
+const DiagramContentData &Diagram::pendingContent() const
+{
+	return m_pending_content;
+}
+
+/**
+	@brief Diagram::contentXmlTagNames
+	@return the tag names of the xml children of a diagram
+	which describe the graphics items (and not the properties)
+	of a diagram.
+*/
+QStringList Diagram::contentXmlTagNames()
+{
+	static const QStringList names {
+		QStringLiteral("elements"),
+		QStringLiteral("conductors"),
+		QStringLiteral("inputs"),
+		QStringLiteral("images"),
+		QStringLiteral("shapes"),
+		QStringLiteral("tables"),
+		QStringLiteral("terminal_strip_items")
+	};
+	return names;
+}
+
 /**
 	@brief Diagram::refreshContents
 	refresh all content of diagram.
@@ -1587,7 +1732,7 @@ void Diagram::refreshContents()
 */
 void Diagram::addItem(QGraphicsItem *item)
 {
-	if (!item || isReadOnly() || item->scene() == this) return;
+	if (!item || (isReadOnly() && !m_materializing) || item->scene() == this) return;
 	QGraphicsScene::addItem(item);
 
 	switch (item->type())
@@ -1596,6 +1741,8 @@ void Diagram::addItem(QGraphicsItem *item)
 		{
 			m_project->dataBase()->addElement(
 						static_cast<Element *>(item));
+			m_project->elementRegistry()->addElement(
+						static_cast<Element *>(item), this);
 			break;
 		}
 		case Conductor::Type:
@@ -1627,6 +1774,7 @@ void Diagram::removeItem(QGraphicsItem *item)
 			auto elmt = static_cast<Element*>(item);
 			elmt->unlinkAllElements();
 			m_project->dataBase()->removeElement(elmt);
+			m_project->elementRegistry()->removeElement(elmt);
 			break;
 		}
 		case Conductor::Type:
@@ -2132,6 +2280,17 @@ ElementTextsMover &Diagram::elementTextsMover()
 */
 bool Diagram::usesElement(const ElementsLocation &location)
 {
+	QSet<QString> pending_types;
+	for (const auto &data : qAsConst(m_pending_content.elements))
+	{
+		if (pending_types.contains(data.type)) {
+			continue;
+		}
+		pending_types.insert(data.type);
+		if (data.location(m_project) == location) {
+			return(true);
+		}
+	}
 	for(Element *element : elements()) {
 		if (element -> location() == location) {
 			return(true);
@@ -2158,6 +2317,7 @@ void Diagram::freezeElements(bool freeze) {
 	foreach (Element *elmt, elements()) {
 		elmt->freezeLabel(freeze);
 	}
+	emit diagramPropertiesChanged();
 }
 
 /**
@@ -2169,6 +2329,7 @@ void Diagram::unfreezeElements()
 	foreach (Element *elmt, elements()) {
 		elmt->freezeLabel(false);
 	}
+	emit diagramPropertiesChanged();
 }
 
 /**
@@ -2177,6 +2338,7 @@ void Diagram::unfreezeElements()
 */
 void Diagram::setFreezeNewElements(bool b) {
 	m_freeze_new_elements = b;
+	emit diagramPropertiesChanged();
 }
 
 /**
@@ -2196,6 +2358,7 @@ void Diagram::freezeConductors(bool freeze) {
 	foreach (Conductor *cnd, conductors()) {
 		cnd->setFreezeLabel(freeze);
 	}
+	emit diagramPropertiesChanged();
 }
 
 /**
@@ -2204,6 +2367,7 @@ void Diagram::freezeConductors(bool freeze) {
 */
 void Diagram::setFreezeNewConductors(bool b) {
 	m_freeze_new_conductors_ = b;
+	emit diagramPropertiesChanged();
 }
 
 /**
@@ -2295,11 +2459,8 @@ DiagramPosition Diagram::convertPosition(const QPointF &pos) {
 */
 QPointF Diagram::snapToGrid(const QPointF &p)
 {
-	QSettings settings;
-	int xGrid = settings.value(QStringLiteral("diagrameditor/Xgrid"),
-							   Diagram::xGrid).toInt();
-	int yGrid = settings.value(QStringLiteral("diagrameditor/Ygrid"),
-							   Diagram::yGrid).toInt();
+	int xGrid = QetSettings::diagramEditorXGrid();
+	int yGrid = QetSettings::diagramEditorYGrid();
 
 	//Return a point rounded to the nearest pixel
 	if (QApplication::keyboardModifiers().testFlag(Qt::ControlModifier))
@@ -2386,6 +2547,18 @@ QETProject *Diagram::project() const
 	return(m_project);
 }
 
+/**
+	@brief Diagram::undoStack
+	The next command done in the stack is associated with this diagram,
+	to know which folios changed since the last save.
+	@return the diagram undo stack
+*/
+QUndoStack &Diagram::undoStack()
+{
+	m_project->xmlCache()->addCommandDiagram(this);
+	return *(m_project->undoStack());
+}
+
 /**
 	@brief Diagram::folioIndex
 	@return the folio number of this diagram within its parent project,
@@ -23,6 +23,7 @@
 #include "elementsmover.h"
 #include "elementtextsmover.h"
 #include "exportproperties.h"
+#include "project/diagramcontentdata.h"
 #include "properties/xrefproperties.h"
 #include "qetproject.h"
 #include "qgimanager.h"
@@ -128,8 +129,20 @@ class Diagram : public QGraphicsScene
 		bool m_freeze_new_elements;
 		bool m_freeze_new_conductors_;
 		QUuid m_uuid = QUuid::createUuid();
+
+			/// Content not yet loaded in the scene, see materialize()
+		QByteArray m_pending_xml;
+		DiagramContentData m_pending_content;
+			/// True while materialize() load the content
+		bool m_materializing = false;
 	
 	// METHODS
+	private:
+		static const QPixmap &gridTile(int width,
+					       int height,
+					       int point_size,
+					       const QColor &color);
+
 	protected:
 		void drawBackground(QPainter *, const QRectF &) override;
 
@@ -151,6 +164,7 @@ class Diagram : public QGraphicsScene
 		//methods related to autonum
 		QString conductorsAutonumName() const;
 		void setConductorsAutonumName(const QString &name);
+		void setDefaultConductorProperties(const ConductorProperties &properties);
 
 		static bool clipboardMayContainDiagram();
 	
@@ -180,6 +194,15 @@ class Diagram : public QGraphicsScene
 			     QPointF = QPointF(),
 			     bool = true,
 			     DiagramContent * = nullptr);
+		void addContent(const DiagramContentData &content,
+				QPointF position = QPointF(),
+				DiagramContent *content_ptr = nullptr);
+		bool isMaterialized() const;
+		bool materialize();
+		void setPendingXml(const QByteArray &xml,
+				   const DiagramContentData &content);
+		const DiagramContentData &pendingContent() const;
+		static QStringList contentXmlTagNames();
 		void folioSequentialsToXml(QHash<QString,
 					   QStringList>*,
 					   QDomElement *,
@@ -283,6 +306,9 @@ class Diagram : public QGraphicsScene
 
 		void diagramActivated();
 		void diagramInformationChanged();
+		/// Signal emitted when a property of the diagram saved in the project
+		/// changed without undo command
+		void diagramPropertiesChanged();
 };
 Q_DECLARE_METATYPE(Diagram *)
 
@@ -386,14 +412,6 @@ inline Diagram::BorderOptions Diagram::borderOptions() {
 	return(options);
 }
 
-/**
-	@brief Diagram::undoStack
-	@return the diagram undo stack
-*/
-inline QUndoStack &Diagram::undoStack() {
-	return *(project()->undoStack());
-}
-
 /**
 	@brief Diagram::qgiManager
 	@return the diagram graphics item manager
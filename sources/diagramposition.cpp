@@ -17,6 +17,7 @@
 */
 #include "diagramposition.h"
 #include "qetapp.h"
+#include "utils/qetsettings.h"
 
 /**
 	Constructeur
@@ -63,9 +64,7 @@ QString DiagramPosition::toString()
 	if (isOutOfBounds()) {
 		return("-");
 	}
-	QSettings settings;
-
-	if (settings.value("border-columns_0", true).toBool()){
+	if (QetSettings::borderColumnsStartAtZero()){
 	return(QString("%1%2").arg(letter_).arg(number_ - 1));
 	}else{
 	return(QString("%1%2").arg(letter_).arg(number_));
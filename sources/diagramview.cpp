@@ -32,6 +32,7 @@
 #include "ui/multipastedialog.h"
 #include "undocommand/changetitleblockcommand.h"
 #include "utils/conductorcreator.h"
+#include "utils/qetsettings.h"
 #include "undocommand/addgraphicsobjectcommand.h"
 #include "diagram.h"
 
@@ -95,6 +96,8 @@ DiagramView::DiagramView(Diagram *diagram, QWidget *parent) :
 	connect(m_diagram, SIGNAL(sceneRectChanged(QRectF)), this, SLOT(adjustSceneRect()));
 	connect(&(m_diagram -> border_and_titleblock), SIGNAL(diagramTitleChanged(const QString &)), this, SLOT(updateWindowTitle()));
 	connect(diagram, SIGNAL(findElementRequired(ElementsLocation)), this, SIGNAL(findElementRequired(ElementsLocation)));
+		//Grid and column numbers are read from the settings snapshot
+	connect(QetSettings::notifier(), &QetSettings::Notifier::snapshotChanged, this, [this]() {viewport()->update();});
 
 	QShortcut *edit_conductor_color_shortcut = new QShortcut(QKeySequence(Qt::Key_F2), this);
 	connect(edit_conductor_color_shortcut, &QShortcut::activated, [this]()
@@ -332,8 +335,7 @@ void DiagramView::zoom(const qreal zoom_factor)
 	}
 	else
 	{
-		QSettings settings;
-		if (settings.value("diagrameditor/zoom-out-beyond-of-folio", false).toBool() ||
+		if (QetSettings::zoomOutBeyondOfFolio() ||
 			(horizontalScrollBar()->maximum() || verticalScrollBar()->maximum()) )
 			if (zoom_factor >= 0){
 				scale(zoom_factor, zoom_factor);
@@ -917,8 +919,7 @@ void DiagramView::adjustSceneRect()
 	QRectF scene_rect = m_diagram->sceneRect();
 	scene_rect.adjust(-Diagram::margin, -Diagram::margin, Diagram::margin, Diagram::margin);
 
-	QSettings settings;
-	if (settings.value("diagrameditor/zoom-out-beyond-of-folio", false).toBool())
+	if (QetSettings::zoomOutBeyondOfFolio())
 	{
 			//When zoom out beyond of folio is active,
 			//we always adjust the scene rect to be 1/3 bigger than the wiewport
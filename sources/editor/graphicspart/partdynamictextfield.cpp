@@ -19,6 +19,7 @@
 
 #include "../../QPropertyUndoCommand/qpropertyundocommand.h"
 #include "../../qetapp.h"
+#include "../../utils/qetsettings.h"
 #include "../elementscene.h"
 
 #include <QColor>
@@ -32,9 +33,8 @@ PartDynamicTextField::PartDynamicTextField(QETElementEditor *editor, QGraphicsIt
 {
 	setDefaultTextColor(Qt::black);
 	setFont(QETApp::dynamicTextsItemFont());
-	QSettings settings;
-	QGraphicsObject::setRotation(QET::correctAngle(settings.value("diagrameditor/dynamic_text_rotation", 0).toInt()));
-	setTextWidth(settings.value("diagrameditor/dynamic_text_width", -1).toInt());
+	QGraphicsObject::setRotation(QET::correctAngle(QetSettings::elementEditorDynamicTextRotation()));
+	setTextWidth(QetSettings::elementEditorDynamicTextWidth());
 	setText("_");
 	setTextFrom(DynamicElementTextItem::UserText);
 	setFlags(
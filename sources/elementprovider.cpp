@@ -25,12 +25,16 @@
 
 #include <QAbstractItemModel>
 
+#include <algorithm>
+
 /**
 	@brief ElementProvider::ElementProvider Constructor
 	@param prj the project where we must find element
 	@param diagram the diagram to exclude from the search
 */
-ElementProvider::ElementProvider(QETProject *prj, Diagram *diagram)
+ElementProvider::ElementProvider(QETProject *prj, Diagram *diagram) :
+	m_project(prj),
+	m_excluded_diagram(diagram)
 {
 	m_diagram_list = prj->diagrams();
 	m_diagram_list.removeOne(diagram);
@@ -40,7 +44,10 @@ ElementProvider::ElementProvider(QETProject *prj, Diagram *diagram)
 	@brief ElementProvider::ElementProvider Constructor
 	@param diag Diagram to search
 */
-ElementProvider::ElementProvider(Diagram *diag) {
+ElementProvider::ElementProvider(Diagram *diag) :
+	m_project(diag->project()),
+	m_only_diagram(diag)
+{
 	m_diagram_list << diag;
 }
 
@@ -56,25 +63,18 @@ ElementProvider::ElementProvider(Diagram *diag) {
 QVector <QPointer<Element>> ElementProvider::freeElement(ElementData::Types filter) const
 {
 	QVector<QPointer<Element>> free_elmt;
-	QList<Element *> elmt_list;
+	if (!m_project) {
+		return free_elmt;
+	}
 
-		//search in all diagram
-	for (const auto &diagram_ : qAsConst(m_diagram_list))
+	for (const auto &elmt_ : m_project->elementRegistry()->freeElements(filter))
 	{
-			//get all element in diagram d
-		elmt_list = diagram_->elements();
-		for (const auto &elmt_ : qAsConst(elmt_list))
-		{
-			if (filter & elmt_->elementData().m_type &&
-				elmt_->isFree())
-			{
-				free_elmt << elmt_;
-			}
+		if (accept(elmt_)) {
+			free_elmt << elmt_;
 		}
-			//Clear for next loop
-		elmt_list.clear();
 	}
 
+	sortByFolio(free_elmt);
 	return free_elmt;
 }
 /**
@@ -85,13 +85,14 @@ QVector <QPointer<Element>> ElementProvider::freeElement(ElementData::Types filt
 QList <Element *> ElementProvider::fromUuids(QList<QUuid> uuid_list) const
 {
 	QList <Element *> found_element;
+	if (!m_project) {
+		return found_element;
+	}
 
-	foreach (Diagram *d, m_diagram_list) {
-		foreach(Element *elmt, d->elements()) {
-			if (uuid_list.contains(elmt->uuid())) {
-				found_element << elmt;
-				uuid_list.removeAll(elmt->uuid());
-			}
+	for (const auto &elmt : m_project->elementRegistry()->elements(uuid_list))
+	{
+		if (accept(elmt)) {
+			found_element << elmt;
 		}
 	}
 	return found_element;
@@ -106,17 +107,18 @@ QList <Element *> ElementProvider::fromUuids(QList<QUuid> uuid_list) const
 QVector<QPointer<Element>> ElementProvider::find(ElementData::Types elmt_type) const
 {
 	QVector<QPointer<Element>> returned_vector;
-	for (const auto &diagram_ : qAsConst(m_diagram_list))
+	if (!m_project) {
+		return returned_vector;
+	}
+
+	for (const auto &elmt_ : m_project->elementRegistry()->elements(elmt_type))
 	{
-		const auto elmt_list = diagram_->elements();
-		for (const auto &elmt_ : elmt_list)
-		{
-			if (elmt_type & elmt_->elementData().m_type) {
-				returned_vector << QPointer<Element>(elmt_);
-			}
+		if (accept(elmt_)) {
+			returned_vector << QPointer<Element>(elmt_);
 		}
 	}
 
+	sortByFolio(returned_vector);
 	return returned_vector;
 }
 
@@ -198,21 +200,53 @@ QVector<TerminalElement *> ElementProvider::freeTerminal() const
 {
 	QVector<TerminalElement *> vector_;
 
-	for (const auto &diagram : qAsConst(m_diagram_list))
+	for (const auto &element : find(ElementData::Terminal))
 	{
-		const auto elmt_list{diagram->elements()};
-
-		for (const auto element : elmt_list)
-		{
-			if (element->elementData().m_type == ElementData::Terminal)
-			{
-				const auto te{static_cast<TerminalElement *>(element)};
-				if (!te->parentTerminalStrip()) {
-					vector_.append(te);
-				}
-			}
+		const auto te{static_cast<TerminalElement *>(element.data())};
+		if (te && !te->parentTerminalStrip()) {
+			vector_.append(te);
 		}
 	}
 
 	return vector_;
 }
+
+/**
+	@brief ElementProvider::accept
+	@param element
+	@return true if element belong to the diagrams searched by this provider
+*/
+bool ElementProvider::accept(Element *element) const
+{
+	const auto diagram_ = m_project->elementRegistry()->diagram(element);
+	if (!diagram_) {
+		return false;
+	}
+	if (m_only_diagram) {
+		return diagram_ == m_only_diagram;
+	}
+	return diagram_ != m_excluded_diagram;
+}
+
+/**
+	@brief ElementProvider::sortByFolio
+	Sort elements by the folio order of their diagram,
+	like if the diagrams was walked one after another
+	@param elements
+*/
+void ElementProvider::sortByFolio(QVector<QPointer<Element>> &elements) const
+{
+	QHash<Diagram *, int> folio_index;
+	for (int i = 0 ; i < m_diagram_list.size() ; ++i) {
+		folio_index.insert(m_diagram_list.at(i), i);
+	}
+
+	const auto registry = m_project->elementRegistry();
+	std::stable_sort(elements.begin(), elements.end(),
+			 [&folio_index, registry](const QPointer<Element> &a,
+						  const QPointer<Element> &b)
+	{
+		return folio_index.value(registry->diagram(a.data()))
+				< folio_index.value(registry->diagram(b.data()));
+	});
+}
@@ -34,6 +34,7 @@ class TerminalElement;
   this class can search in the given diagram or project some kind of element
   like 'folio report' or 'master' and return it.
   We can get element element with specific status like 'free'.
+  Elements are searched in the ElementRegistry of the project.
 */
 
 class ElementProvider
@@ -49,7 +50,13 @@ class ElementProvider
 		QVector<TerminalElement *> freeTerminal() const;
 
 	private:
+		bool accept(Element *element) const;
+		void sortByFolio(QVector<QPointer<Element>> &elements) const;
+
 		QList <Diagram *> m_diagram_list;
+		QETProject *m_project = nullptr;
+		Diagram *m_excluded_diagram = nullptr;
+		Diagram *m_only_diagram = nullptr;
 };
 
 #endif // ELEMENTPROVIDER_H
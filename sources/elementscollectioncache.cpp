@@ -21,10 +21,18 @@
 #include "qet.h"
 #include "qetgraphicsitem/element.h"
 
+#include <QFileInfo>
 #include <QImageWriter>
 #include <QSqlError>
 #include <QSqlQuery>
 
+namespace {
+		//Increase when the tables change, old tables are dropped
+	const int cache_schema_version = 2;
+		//Max number of writes in a single transaction
+	const int max_pending_writes = 500;
+}
+
 /**
 	Construct a cache for elements collections.
 	@param database_path Path of the SQLite database to open.
@@ -52,36 +60,33 @@ ElementsCollectionCache::ElementsCollectionCache(const QString &database_path, Q
 		cache_db_.exec("PRAGMA locking_mode = EXCLUSIVE");
 		cache_db_.exec("PRAGMA synchronous = OFF");
 
-#if TODO_LIST
-#pragma message("@TODO the tables could already exist, handle that case.")
-#endif
-			//@TODO the tables could already exist, handle that case.
-		cache_db_.exec("CREATE TABLE names"
-					   "("
-					   "path VARCHAR(512) NOT NULL,"
-					   "locale VARCHAR(2) NOT NULL,"
-					   "uuid VARCHAR(512) NOT NULL,"
-					   "name VARCHAR(128),"
-					   "PRIMARY KEY(path, locale)"
-					   ");");
-
-		cache_db_.exec("CREATE TABLE pixmaps"
-					   "("
-					   "path VARCHAR(512) NOT NULL UNIQUE,"
-					   "uuid VARCHAR(512) NOT NULL,"
-					   "pixmap BLOB, PRIMARY KEY(path),"
-					   "FOREIGN KEY(path) REFERENCES names (path) ON DELETE CASCADE);");
+		createTables();
 
 			// prepare queries
-		select_name_   = new QSqlQuery(cache_db_);
-		select_pixmap_ = new QSqlQuery(cache_db_);
-		insert_name_   = new QSqlQuery(cache_db_);
-		insert_pixmap_ = new QSqlQuery(cache_db_);
-		select_name_   -> prepare("SELECT name FROM names WHERE path = :path AND locale = :locale AND uuid = :uuid");
-		select_pixmap_ -> prepare("SELECT pixmap FROM pixmaps WHERE path = :path AND uuid = :uuid");
-		insert_name_   -> prepare("REPLACE INTO names (path, locale, uuid, name) VALUES (:path, :locale, :uuid, :name)");
-		insert_pixmap_ -> prepare("REPLACE INTO pixmaps (path, uuid, pixmap) VALUES (:path, :uuid, :pixmap)");
+		select_name_        = new QSqlQuery(cache_db_);
+		select_pixmap_      = new QSqlQuery(cache_db_);
+		select_name_uuid_   = new QSqlQuery(cache_db_);
+		select_pixmap_uuid_ = new QSqlQuery(cache_db_);
+		insert_name_        = new QSqlQuery(cache_db_);
+		insert_pixmap_      = new QSqlQuery(cache_db_);
+		update_name_        = new QSqlQuery(cache_db_);
+		update_pixmap_      = new QSqlQuery(cache_db_);
+		select_name_        -> prepare("SELECT name FROM names WHERE path = :path AND locale = :locale AND mtime = :mtime AND size = :size");
+		select_pixmap_      -> prepare("SELECT pixmap FROM pixmaps WHERE path = :path AND mtime = :mtime AND size = :size");
+		select_name_uuid_   -> prepare("SELECT name FROM names WHERE path = :path AND locale = :locale AND uuid = :uuid");
+		select_pixmap_uuid_ -> prepare("SELECT pixmap FROM pixmaps WHERE path = :path AND uuid = :uuid");
+		insert_name_        -> prepare("REPLACE INTO names (path, locale, mtime, size, uuid, name) VALUES (:path, :locale, :mtime, :size, :uuid, :name)");
+		insert_pixmap_      -> prepare("REPLACE INTO pixmaps (path, mtime, size, uuid, pixmap) VALUES (:path, :mtime, :size, :uuid, :pixmap)");
+		update_name_        -> prepare("UPDATE names SET mtime = :mtime, size = :size WHERE path = :path");
+		update_pixmap_      -> prepare("UPDATE pixmaps SET mtime = :mtime, size = :size WHERE path = :path");
 	}
+
+		// the pending writes are committed when the event loop is back,
+		// so the elements fetched in a row share the same transaction
+	commit_timer_.setSingleShot(true);
+	commit_timer_.setInterval(0);
+	connect(&commit_timer_, &QTimer::timeout,
+		this, &ElementsCollectionCache::commitWrites);
 }
 
 /**
@@ -89,10 +94,15 @@ ElementsCollectionCache::ElementsCollectionCache(const QString &database_path, Q
 */
 ElementsCollectionCache::~ElementsCollectionCache()
 {
+	commitWrites();
 	delete select_name_;
 	delete select_pixmap_;
+	delete select_name_uuid_;
+	delete select_pixmap_uuid_;
 	delete insert_name_;
 	delete insert_pixmap_;
+	delete update_name_;
+	delete update_pixmap_;
 	cache_db_.close();
 }
 
@@ -139,6 +149,10 @@ QString ElementsCollectionCache::pixmapStorageFormat() const
 	@brief ElementsCollectionCache::fetchElement
 	Retrieve the data for a given element, using the cache if available,
 	filling it otherwise. Data are then available through pixmap() and name() methods.
+	The cached data are found with the modification date and the size
+	of the element file, so the file is not read when the cache is up to date.
+	If the file changed, the data are still used if the uuid of the element
+	is the same.
 	@param location The definition of an element.
 	@see pixmap()
 	@see name()
@@ -155,19 +169,27 @@ bool ElementsCollectionCache::fetchElement(ElementsLocation &location)
 	}
 	else
 	{
-		auto uuid = location.uuid();
 		QString element_path = location.toString();
-		bool got_name   = fetchNameFromCache(element_path, uuid);
-		bool got_pixmap = fetchPixmapFromCache(element_path, uuid);
+		const QFileInfo file_info(location.fileSystemPath());
 
-		if (got_name && got_pixmap) {
+		if (fetchNameFromCache(element_path, file_info)
+				&& fetchPixmapFromCache(element_path, file_info)) {
+			return(true);
+		}
+
+			// the file changed, check if the element changed
+		auto uuid = location.uuid();
+		if (fetchNameFromCache(element_path, uuid)
+				&& fetchPixmapFromCache(element_path, uuid))
+		{
+			updateFileInfo(element_path, file_info);
 			return(true);
 		}
 
 		if (fetchData(location))
 		{
-			cacheName(element_path, uuid);
-			cachePixmap(element_path, uuid);
+			cacheName(element_path, uuid, file_info);
+			cachePixmap(element_path, uuid, file_info);
 		}
 		return(true);
 	}
@@ -214,26 +236,31 @@ bool ElementsCollectionCache::fetchData(const ElementsLocation &location) {
 
 /**
 	@brief ElementsCollectionCache::fetchNameFromCache
-	Retrieve the name for an element, given its path and uuid
-	The value is then available through the name() method.
+	Retrieve the name for an element, given its path and the informations
+	of its file. The value is then available through the name() method.
 	@param path : Element path (as obtained using ElementsLocation::toString())
-	@param uuid : Element uuid
+	@param file_info : the file of the element
 	@return True if the retrieval succeeded, false otherwise.
 */
 bool ElementsCollectionCache::fetchNameFromCache(const QString &path,
-						 const QUuid &uuid)
+						 const QFileInfo &file_info)
 {
+	if (!file_info.exists()) {
+		return(false);
+	}
+
 	select_name_ -> bindValue(":path", path);
 	select_name_ -> bindValue(":locale", locale_);
-	select_name_ -> bindValue(":uuid", uuid.toString());
+	select_name_ -> bindValue(":mtime", file_info.lastModified().toMSecsSinceEpoch());
+	select_name_ -> bindValue(":size", file_info.size());
 	if (select_name_ -> exec())
 	{
-		if (select_name_ -> first())
-		{
+		bool found = select_name_ -> first();
+		if (found) {
 			current_name_ = select_name_ -> value(0).toString();
-			select_name_ -> finish();
-			return(true);
 		}
+		select_name_ -> finish();
+		return(found);
 	}
 	else
 		qDebug() << "select_name_->exec() failed";
@@ -243,28 +270,34 @@ bool ElementsCollectionCache::fetchNameFromCache(const QString &path,
 
 /**
 	@brief ElementsCollectionCache::fetchPixmapFromCache
-	Retrieve the pixmap for an element, given its path and uuid.
-	It is then available through the pixmap() method.
+	Retrieve the pixmap for an element, given its path and the informations
+	of its file. It is then available through the pixmap() method.
 	@param path : Element path (as obtained using ElementsLocation::toString())
-	@param uuid : Element uuid
+	@param file_info : the file of the element
 	@return True if the retrieval succeeded, false otherwise.
 */
 bool ElementsCollectionCache::fetchPixmapFromCache(const QString &path,
-						   const QUuid &uuid)
+						   const QFileInfo &file_info)
 {
+	if (!file_info.exists()) {
+		return(false);
+	}
+
 	select_pixmap_ -> bindValue(":path", path);
-	select_pixmap_ -> bindValue(":uuid", uuid.toString());
+	select_pixmap_ -> bindValue(":mtime", file_info.lastModified().toMSecsSinceEpoch());
+	select_pixmap_ -> bindValue(":size", file_info.size());
 	if (select_pixmap_ -> exec())
 	{
-		if (select_pixmap_ -> first())
+		bool found = select_pixmap_ -> first();
+		if (found)
 		{
 			QByteArray ba = select_pixmap_ -> value(0).toByteArray();
 			// avoid returning always the same pixmap (i.e. same cacheKey())
 			current_pixmap_.detach();
 			current_pixmap_.loadFromData(ba, qPrintable(pixmap_storage_format_));
-			select_pixmap_ -> finish();
 		}
-		return(true);
+		select_pixmap_ -> finish();
+		return(found);
 	}
 	else
 		qDebug() << "select_pixmap_->exec() failed";
@@ -272,20 +305,86 @@ bool ElementsCollectionCache::fetchPixmapFromCache(const QString &path,
 	return(false);
 }
 
+/**
+	@brief ElementsCollectionCache::fetchNameFromCache
+	Retrieve the name for an element, given its path and uuid
+	The value is then available through the name() method.
+	@param path : Element path (as obtained using ElementsLocation::toString())
+	@param uuid : Element uuid
+	@return True if the retrieval succeeded, false otherwise.
+*/
+bool ElementsCollectionCache::fetchNameFromCache(const QString &path,
+						 const QUuid &uuid)
+{
+	select_name_uuid_ -> bindValue(":path", path);
+	select_name_uuid_ -> bindValue(":locale", locale_);
+	select_name_uuid_ -> bindValue(":uuid", uuid.toString());
+	if (select_name_uuid_ -> exec())
+	{
+		bool found = select_name_uuid_ -> first();
+		if (found) {
+			current_name_ = select_name_uuid_ -> value(0).toString();
+		}
+		select_name_uuid_ -> finish();
+		return(found);
+	}
+	else
+		qDebug() << "select_name_uuid_->exec() failed";
+
+	return(false);
+}
+
+/**
+	@brief ElementsCollectionCache::fetchPixmapFromCache
+	Retrieve the pixmap for an element, given its path and uuid.
+	It is then available through the pixmap() method.
+	@param path : Element path (as obtained using ElementsLocation::toString())
+	@param uuid : Element uuid
+	@return True if the retrieval succeeded, false otherwise.
+*/
+bool ElementsCollectionCache::fetchPixmapFromCache(const QString &path,
+						   const QUuid &uuid)
+{
+	select_pixmap_uuid_ -> bindValue(":path", path);
+	select_pixmap_uuid_ -> bindValue(":uuid", uuid.toString());
+	if (select_pixmap_uuid_ -> exec())
+	{
+		bool found = select_pixmap_uuid_ -> first();
+		if (found)
+		{
+			QByteArray ba = select_pixmap_uuid_ -> value(0).toByteArray();
+			// avoid returning always the same pixmap (i.e. same cacheKey())
+			current_pixmap_.detach();
+			current_pixmap_.loadFromData(ba, qPrintable(pixmap_storage_format_));
+		}
+		select_pixmap_uuid_ -> finish();
+		return(found);
+	}
+	else
+		qDebug() << "select_pixmap_uuid_->exec() failed";
+
+	return(false);
+}
+
 /**
 	@brief ElementsCollectionCache::cacheName
 	Cache the current (i.e. last retrieved) name The cache entry will use the locale set via setLocale().
 	@param path : Element path (as obtained using ElementsLocation::toString())
 	@param uuid :Element uuid
+	@param file_info : the file of the element
 	@return True if the caching succeeded, false otherwise.
 	@see name()
 */
 bool ElementsCollectionCache::cacheName(const QString &path,
-					const QUuid &uuid)
+					const QUuid &uuid,
+					const QFileInfo &file_info)
 {
+	beginWrite();
 	insert_name_ -> bindValue(":path",   path);
 	insert_name_ -> bindValue(":locale", locale_);
-	insert_name_ -> bindValue(":uuid",  uuid.toString());
+	insert_name_ -> bindValue(":mtime",  file_info.lastModified().toMSecsSinceEpoch());
+	insert_name_ -> bindValue(":size",   file_info.size());
+	insert_name_ -> bindValue(":uuid",   uuid.toString());
 	insert_name_ -> bindValue(":name",   current_name_);
 	if (!insert_name_ -> exec())
 	{
@@ -300,18 +399,23 @@ bool ElementsCollectionCache::cacheName(const QString &path,
 	Cache the current (i.e. last retrieved) pixmap
 	@param path : Element path (as obtained using ElementsLocation::toString())
 	@param uuid : Element uuid
+	@param file_info : the file of the element
 	@return True if the caching succeeded, false otherwise.
 	@see pixmap()
 */
 bool ElementsCollectionCache::cachePixmap(const QString &path,
-					  const QUuid &uuid)
+					  const QUuid &uuid,
+					  const QFileInfo &file_info)
 {
 	QByteArray ba;
 	QBuffer buffer(&ba);
 	buffer.open(QIODevice::WriteOnly);
 	current_pixmap_.save(&buffer, qPrintable(pixmap_storage_format_));
-	insert_pixmap_ -> bindValue(":path", path);
-	insert_pixmap_ -> bindValue(":uuid", uuid.toString());
+	beginWrite();
+	insert_pixmap_ -> bindValue(":path",   path);
+	insert_pixmap_ -> bindValue(":mtime",  file_info.lastModified().toMSecsSinceEpoch());
+	insert_pixmap_ -> bindValue(":size",   file_info.size());
+	insert_pixmap_ -> bindValue(":uuid",   uuid.toString());
 	insert_pixmap_ -> bindValue(":pixmap", QVariant(ba));
 	if (!insert_pixmap_->exec())
 	{
@@ -320,3 +424,168 @@ bool ElementsCollectionCache::cachePixmap(const QString &path,
 	}
 	return(true);
 }
+
+/**
+	@brief ElementsCollectionCache::updateFileInfo
+	Store new informations for the file of the element at path,
+	when the file changed but not the element (same uuid).
+	@param path : Element path (as obtained using ElementsLocation::toString())
+	@param file_info : the file of the element
+	@return True if the update succeeded, false otherwise.
+*/
+bool ElementsCollectionCache::updateFileInfo(const QString &path,
+					     const QFileInfo &file_info)
+{
+	beginWrite();
+	for (auto query : {update_name_, update_pixmap_})
+	{
+		query -> bindValue(":mtime", file_info.lastModified().toMSecsSinceEpoch());
+		query -> bindValue(":size",  file_info.size());
+		query -> bindValue(":path",  path);
+		if (!query -> exec())
+		{
+			qDebug() << cache_db_.lastError();
+			return(false);
+		}
+	}
+	return(true);
+}
+
+/**
+	@brief ElementsCollectionCache::validateAll
+	Check all the cached elements at once with the informations of their files,
+	without reading the files.
+	The entries of the removed files are removed from the cache.
+	The entries of the changed files are kept,
+	they are checked with the uuid of the element when fetched.
+	@return the number of cached elements which are up to date
+	or -1 if the cache can't be read.
+*/
+int ElementsCollectionCache::validateAll()
+{
+	if (!cache_db_.isOpen()) {
+		return(-1);
+	}
+
+	QSqlQuery select_all(cache_db_);
+	if (!select_all.exec("SELECT path, mtime, size FROM pixmaps "
+			     "UNION SELECT path, mtime, size FROM names"))
+	{
+		qDebug() << cache_db_.lastError();
+		return(-1);
+	}
+
+	int up_to_date = 0;
+	QStringList removed_paths;
+	while (select_all.next())
+	{
+		const QString path = select_all.value(0).toString();
+		const QFileInfo file_info(ElementsLocation(path).fileSystemPath());
+		if (!file_info.exists()) {
+			removed_paths << path;
+		} else if (file_info.lastModified().toMSecsSinceEpoch() == select_all.value(1).toLongLong()
+			   && file_info.size() == select_all.value(2).toLongLong()) {
+			++up_to_date;
+		}
+	}
+	select_all.finish();
+
+	if (!removed_paths.isEmpty())
+	{
+		removed_paths.removeDuplicates();
+		QSqlQuery delete_name(cache_db_);
+		QSqlQuery delete_pixmap(cache_db_);
+		delete_name.prepare("DELETE FROM names WHERE path = :path");
+		delete_pixmap.prepare("DELETE FROM pixmaps WHERE path = :path");
+		for (const auto &path : qAsConst(removed_paths))
+		{
+			beginWrite();
+			delete_name.bindValue(":path", path);
+			delete_pixmap.bindValue(":path", path);
+			delete_name.exec();
+			delete_pixmap.exec();
+		}
+		commitWrites();
+	}
+
+	return(up_to_date);
+}
+
+/**
+	@brief ElementsCollectionCache::commitWrites
+	Commit the writes made since the last commit.
+	Writes are grouped in a transaction because
+	a commit for each element is very slow.
+*/
+void ElementsCollectionCache::commitWrites()
+{
+	commit_timer_.stop();
+	if (in_transaction_)
+	{
+		if (!cache_db_.commit()) {
+			qDebug() << cache_db_.lastError();
+		}
+		in_transaction_ = false;
+		pending_writes_ = 0;
+	}
+}
+
+/**
+	@brief ElementsCollectionCache::createTables
+	Create the tables of the cache if they don't exist.
+	Tables written by an older version are dropped and created again.
+*/
+void ElementsCollectionCache::createTables()
+{
+	QSqlQuery version_query = cache_db_.exec("PRAGMA user_version");
+	int version = version_query.next() ? version_query.value(0).toInt() : 0;
+	version_query.finish();
+
+	if (version != cache_schema_version)
+	{
+		cache_db_.exec("DROP TABLE IF EXISTS pixmaps");
+		cache_db_.exec("DROP TABLE IF EXISTS names");
+		cache_db_.exec(QString("PRAGMA user_version = %1").arg(cache_schema_version));
+	}
+
+	cache_db_.exec("CREATE TABLE IF NOT EXISTS names"
+		       "("
+		       "path VARCHAR(512) NOT NULL,"
+		       "locale VARCHAR(2) NOT NULL,"
+		       "mtime INTEGER NOT NULL,"
+		       "size INTEGER NOT NULL,"
+		       "uuid VARCHAR(512) NOT NULL,"
+		       "name VARCHAR(128),"
+		       "PRIMARY KEY(path, locale)"
+		       ");");
+
+	cache_db_.exec("CREATE TABLE IF NOT EXISTS pixmaps"
+		       "("
+		       "path VARCHAR(512) NOT NULL UNIQUE,"
+		       "mtime INTEGER NOT NULL,"
+		       "size INTEGER NOT NULL,"
+		       "uuid VARCHAR(512) NOT NULL,"
+		       "pixmap BLOB, PRIMARY KEY(path),"
+		       "FOREIGN KEY(path) REFERENCES names (path) ON DELETE CASCADE);");
+}
+
+/**
+	@brief ElementsCollectionCache::beginWrite
+	Open a transaction if needed before a write.
+	The transaction is committed when the event loop is back
+	or when it contains too many writes.
+*/
+void ElementsCollectionCache::beginWrite()
+{
+	if (pending_writes_ >= max_pending_writes) {
+		commitWrites();
+	}
+
+	if (!in_transaction_) {
+		in_transaction_ = cache_db_.transaction();
+	}
+	if (in_transaction_) {
+		++pending_writes_;
+		commit_timer_.start();
+	}
+}
@@ -21,6 +21,9 @@
 #include "ElementsCollection/elementslocation.h"
 
 #include <QSqlDatabase>
+#include <QTimer>
+
+class QFileInfo;
 
 /**
 	This class implements a SQLite cache for data related to elements
@@ -46,23 +49,41 @@ class ElementsCollectionCache : public QObject
 	QString name() const;
 	QPixmap pixmap() const;
 	bool fetchData(const ElementsLocation &);
+	bool fetchNameFromCache(const QString &path, const QFileInfo &file_info);
+	bool fetchPixmapFromCache(const QString &path, const QFileInfo &file_info);
 	bool fetchNameFromCache(const QString &path, const QUuid &uuid);
 	bool fetchPixmapFromCache(const QString &path, const QUuid &uuid);
 	bool cacheName(const QString &path,
-		       const QUuid &uuid = QUuid::createUuid());
+		       const QUuid &uuid,
+		       const QFileInfo &file_info);
 	bool cachePixmap(const QString &path,
-			 const QUuid &uuid = QUuid::createUuid());
+			 const QUuid &uuid,
+			 const QFileInfo &file_info);
+	bool updateFileInfo(const QString &path, const QFileInfo &file_info);
+	int validateAll();
+	void commitWrites();
+	
+	private:
+	void createTables();
+	void beginWrite();
 	
 	// attributes
 	private:
-	QSqlDatabase cache_db_;         ///< Object providing access to the SQLite database this cache relies on
-	QSqlQuery *select_name_;        ///< Prepared statement to fetch names from the cache
-	QSqlQuery *select_pixmap_;      ///< Prepared statement to fetch pixmaps from the cache
-	QSqlQuery *insert_name_;        ///< Prepared statement to insert names into the cache
-	QSqlQuery *insert_pixmap_;      ///< Prepared statement to insert pixmaps into the cache
-	QString locale_;                ///< Locale to be used when dealing with names
-	QString pixmap_storage_format_; ///< Storage format for cached pixmaps
-	QString current_name_;          ///< Last name fetched
-	QPixmap current_pixmap_;        ///< Last pixmap fetched
+	QSqlDatabase cache_db_;                   ///< Object providing access to the SQLite database this cache relies on
+	QSqlQuery *select_name_ = nullptr;        ///< Prepared statement to fetch names from the cache, by file modification date and size
+	QSqlQuery *select_pixmap_ = nullptr;      ///< Prepared statement to fetch pixmaps from the cache, by file modification date and size
+	QSqlQuery *select_name_uuid_ = nullptr;   ///< Prepared statement to fetch names from the cache, by uuid
+	QSqlQuery *select_pixmap_uuid_ = nullptr; ///< Prepared statement to fetch pixmaps from the cache, by uuid
+	QSqlQuery *insert_name_ = nullptr;        ///< Prepared statement to insert names into the cache
+	QSqlQuery *insert_pixmap_ = nullptr;      ///< Prepared statement to insert pixmaps into the cache
+	QSqlQuery *update_name_ = nullptr;        ///< Prepared statement to update the file informations of names
+	QSqlQuery *update_pixmap_ = nullptr;      ///< Prepared statement to update the file informations of pixmaps
+	QTimer commit_timer_;                     ///< Commit the pending writes when the event loop is back
+	bool in_transaction_ = false;             ///< True while writes are pending in a transaction
+	int pending_writes_ = 0;                  ///< Number of writes in the current transaction
+	QString locale_;                          ///< Locale to be used when dealing with names
+	QString pixmap_storage_format_;           ///< Storage format for cached pixmaps
+	QString current_name_;                    ///< Last name fetched
+	QPixmap current_pixmap_;                  ///< Last pixmap fetched
 };
 #endif
@@ -37,6 +37,7 @@
 #include <QGraphicsSimpleTextItem>
 #include <QSvgGenerator>
 #include <QtXml>
+#include <QtConcurrentMap>
 #include <cmath>
 #include <utility>
 
@@ -228,6 +229,11 @@ qreal ExportDialog::diagramRatio(Diagram *diagram)
 */
 QSize ExportDialog::diagramSize(Diagram *diagram)
 {
+		//The size of the elements area need the content of the folio
+	if (epw -> exportProperties().exported_area != QET::BorderArea) {
+		project_ -> materializeDiagram(diagram);
+	}
+
 	// sauvegarde le parametre useBorder du schema
 	bool state_useBorder = diagram -> useBorder();
 	
@@ -375,6 +381,8 @@ void ExportDialog::saveReloadDiagramParameters(Diagram *diagram, bool save) {
 	static ExportProperties state_exportProperties;
 	
 	if (save) {
+		// charge le contenu du folio s'il n'est pas encore charge
+		project_ -> materializeDiagram(diagram);
 		// memorise les parametres relatifs au schema tout en appliquant les nouveaux
 		state_exportProperties = diagram -> applyProperties(epw -> exportProperties());
 	} else {
@@ -432,14 +440,49 @@ void ExportDialog::generateSvg(
 	@param width  Largeur de l'export DXF
 	@param height Hauteur de l'export DXF
 	@param file_path
+	@param properties : the export properties to apply to diagram
+	during the export.
+	This function is static to be used without dialog,
+	for example by the command line export.
 */
 void ExportDialog::generateDxf(
 		Diagram *diagram,
 					int width,
 					int height,
-		QString &file_path)
+		const QString &file_path,
+		const ExportProperties &properties)
 {
-	saveReloadDiagramParameters(diagram, true);
+	prepareDxf(diagram, width, height, file_path, properties)();
+}
+
+/**
+	@brief ExportDialog::prepareDxf
+	Begin the export of diagram in the DXF file file_path.
+	The border, the title block, the shapes and the tables are written
+	by the items themselves before this function return.
+	The elements, conductors and texts are only read and kept as values,
+	they are written by the returned function, which also close the file.
+	The returned function doesn't use any QGraphicsItem,
+	so it can be called from any thread, to write several folios
+	at the same time.
+	@param diagram : diagram to export
+	@param width : width of the export
+	@param height : height of the export
+	@param file_path
+	@param properties : the export properties to apply to diagram
+	during the export.
+	@return the function which finish the export
+*/
+std::function<void ()> ExportDialog::prepareDxf(
+		Diagram *diagram,
+		int width,
+		int height,
+		const QString &file_path,
+		const ExportProperties &properties)
+{
+	diagram->project()->materializeDiagram(diagram);
+	const ExportProperties diagram_properties =
+			diagram->applyProperties(properties);
 
 	width  -= 2*Diagram::margin;
 	height -= 2*Diagram::margin;
@@ -448,9 +491,11 @@ void ExportDialog::generateDxf(
 	Createdxf::yScale = Createdxf::sheetHeight / double(height);
 
 	Createdxf::dxfBegin(file_path);
+		//The primitives written by the returned function
+	QVector<std::function<void ()>> writes;
 
 	//Add project elements (lines, rectangles, circles, texts) to dxf file
-	if (epw -> exportProperties().draw_border) {
+	if (properties.draw_border) {
 		QRectF rect(Diagram::margin,Diagram::margin,width,height);
 		Createdxf::drawRectangle(file_path,rect,0);
 	}
@@ -527,7 +572,7 @@ void ExportDialog::generateDxf(
 			for (QString line : lines)
 			{
 				if (line.size() > 0 && line != "_" ) {
-					Createdxf::drawText(file_path, line, QPointF(x, y), fontSize, 360 - angle, 0, 0.72);
+					writes << [=]() {Createdxf::drawText(file_path, line, QPointF(x, y), fontSize, 360 - angle, 0, 0.72);};
 				}
 				x += offset * xdir;
 				y -= offset * ydir;
@@ -538,21 +583,21 @@ void ExportDialog::generateDxf(
 		{
 			QTransform t = QTransform().translate(elem_pos_x,elem_pos_y).rotate(rotation_angle);
 			QLineF l = t.map(line);
-			Createdxf::drawLine(file_path, l, 0);
+			writes << [=]() {Createdxf::drawLine(file_path, l, 0);};
 		}
 
 		for (QRectF rect : primitives.m_rectangles)
 		{
 			QTransform t = QTransform().translate(elem_pos_x,elem_pos_y).rotate(rotation_angle);
 			QRectF r = t.mapRect(rect);
-			Createdxf::drawRectangle(file_path,r,0);
+			writes << [=]() {Createdxf::drawRectangle(file_path,r,0);};
 		}
 
 		for (QRectF circle_rect : primitives.m_circles)
 		{
 			QTransform t = QTransform().translate(elem_pos_x,elem_pos_y).rotate(rotation_angle);
 			QPointF c = t.map(QPointF(circle_rect.center().x(),circle_rect.center().y()));
-			Createdxf::drawCircle(file_path,c,circle_rect.width()/2,0);
+			writes << [=]() {Createdxf::drawCircle(file_path,c,circle_rect.width()/2,0);};
 		}
 
 		for (QVector<QPointF> polygon : primitives.m_polygons)
@@ -562,9 +607,9 @@ void ExportDialog::generateDxf(
 			QTransform t = QTransform().translate(elem_pos_x,elem_pos_y).rotate(rotation_angle);
 			QPolygonF poly = t.map(polygon);
 			if(poly.isClosed())
-				Createdxf::drawPolygon(file_path,poly,0);
+				writes << [=]() {Createdxf::drawPolygon(file_path,poly,0);};
 			else
-				Createdxf::drawPolyline(file_path,poly,0);
+				writes << [=]() {Createdxf::drawPolyline(file_path,poly,0);};
 		}
 
 		// Draw arcs and ellipses
@@ -580,16 +625,16 @@ void ExportDialog::generateDxf(
 			qreal spanAngle = arc .at(5);
 			QRectF r(x,y,w,h);
 			QPointF hotspot(elem_pos_x,elem_pos_y);
-			Createdxf::drawArcEllipse(file_path, r, startAngle, spanAngle, hotspot, rotation_angle, 0);
+			writes << [=]() {Createdxf::drawArcEllipse(file_path, r, startAngle, spanAngle, hotspot, rotation_angle, 0);};
 		}
-		if (epw -> exportProperties().draw_terminals) {
+		if (properties.draw_terminals) {
 			// Draw terminals
 			QList<Terminal *> list_terminals = elmt->terminals();
 			QColor col("red");
 			QTransform t = QTransform().translate(elem_pos_x,elem_pos_y).rotate(rotation_angle);
 			foreach(Terminal *tp, list_terminals) {
 				QPointF c = t.map(QPointF(tp->dock_elmt_.x(),tp->dock_elmt_.y()));
-				Createdxf::drawCircle(file_path,c,3.0,Createdxf::dxfColor(col));
+				writes << [=]() {Createdxf::drawCircle(file_path,c,3.0,Createdxf::dxfColor(col));};
 			}
 		}
 	}
@@ -606,7 +651,7 @@ void ExportDialog::generateDxf(
 			}
 			poly << cond->pos()+segment->secondPoint();
 		}
-		Createdxf::drawPolyline(file_path,poly,0);
+		writes << [=]() {Createdxf::drawPolyline(file_path,poly,0);};
 		//Draw conductor text item
 		ConductorTextItem *textItem = cond -> textItem();
 
@@ -629,7 +674,7 @@ void ExportDialog::generateDxf(
 			qreal offset = fontSize * 1.6;
 			foreach (QString line, lines) {
 				if (line.size() > 0 && line != "_" )
-					Createdxf::drawText(file_path, line, QPointF(x, y), fontSize, 360-angle, 0, 0.72 );
+					writes << [=]() {Createdxf::drawText(file_path, line, QPointF(x, y), fontSize, 360-angle, 0, 0.72 );};
 				x += offset * xdir;
 				y -= offset * ydir;
 			}
@@ -639,7 +684,8 @@ void ExportDialog::generateDxf(
 		QList<QPointF> junctions_list = cond->junctions();
 		if (!junctions_list.isEmpty()) {
 			foreach(QPointF point, junctions_list) {
-				Createdxf::drawEllipse(file_path,QRectF(cond->pos().x() + point.x() - 1.5, cond->pos().y() + point.y() - 1.5, 3.0, 3.0),0);
+				const QRectF r(cond->pos().x() + point.x() - 1.5, cond->pos().y() + point.y() - 1.5, 3.0, 3.0);
+				writes << [=]() {Createdxf::drawEllipse(file_path,r,0);};
 			}
 		}
 	}
@@ -669,17 +715,29 @@ void ExportDialog::generateDxf(
 				- xdir * fontSize * 0.9;
 		QStringList lines = dti -> toPlainText().split('\n');
 		qreal offset = fontSize * 1.6;
+		const int color = Createdxf::dxfColor(dti->color());
 		foreach (QString line, lines) {
 			if (line.size() > 0 && line != "_" )
-				Createdxf::drawText(file_path, line, QPointF(x, y), fontSize, 360-angle, Createdxf::dxfColor(dti->color()), 0.72 );
+				writes << [=]() {Createdxf::drawText(file_path, line, QPointF(x, y), fontSize, 360-angle, color, 0.72 );};
 			x += offset * xdir;
 			y -= offset * ydir;
 		}
 	}
 
-	Createdxf::dxfEnd(file_path);
+	diagram->applyProperties(diagram_properties);
 
-	saveReloadDiagramParameters(diagram, false);
+	const double x_scale = Createdxf::xScale;
+	const double y_scale = Createdxf::yScale;
+	return [file_path, x_scale, y_scale, writes]()
+	{
+			//The scale is kept by thread
+		Createdxf::xScale = x_scale;
+		Createdxf::yScale = y_scale;
+		for (const auto &write : writes) {
+			write();
+		}
+		Createdxf::dxfEnd(file_path);
+	};
 }
 
 QPointF ExportDialog::rotation_transformed(qreal px,
@@ -752,9 +810,15 @@ void ExportDialog::slot_export()
 	}
 	
 	// exporte chaque schema a exporter
+	QList<std::function<void ()>> dxf_writes;
 	foreach(ExportDiagramLine *diagram_line, diagrams_to_export) {
-		exportDiagram(diagram_line);
+		exportDiagram(diagram_line, &dxf_writes);
 	}
+		//The DXF files are read folio by folio in this thread,
+		//then written concurrently.
+	QtConcurrent::blockingMap(dxf_writes, [](std::function<void ()> &write) {
+		write();
+	});
 	
 	// fermeture du dialogue
 	accept();
@@ -764,8 +828,11 @@ void ExportDialog::slot_export()
 	Exporte un schema
 	@param diagram_line La ligne decrivant le schema a exporter et la maniere
 	de l'exporter
+	@param dxf_writes : for the DXF format, the function which finish the
+	export of the folio (see prepareDxf) is appended to this list
 */
-void ExportDialog::exportDiagram(ExportDiagramLine *diagram_line) {
+void ExportDialog::exportDiagram(ExportDiagramLine *diagram_line,
+				 QList<std::function<void ()>> *dxf_writes) {
 	ExportProperties export_properties(epw -> exportProperties());
 	
 	// recupere le format a utiliser (acronyme et extension)
@@ -812,11 +879,12 @@ void ExportDialog::exportDiagram(ExportDiagramLine *diagram_line) {
 			target_file
 		);
 	} else if (format_acronym == "DXF") {
-		generateDxf(
+		*dxf_writes << prepareDxf(
 			diagram_line -> diagram,
 			diagram_line -> width  -> value(),
 			diagram_line -> height -> value(),
-			diagram_path
+			diagram_path,
+			epw -> exportProperties()
 		);
 	} else {
 		QImage image = generateImage(
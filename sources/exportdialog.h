@@ -18,7 +18,9 @@
 #ifndef EXPORTDIALOG_H
 #define EXPORTDIALOG_H
 #include <QtWidgets>
+#include <functional>
 #include "diagram.h"
+#include "exportproperties.h"
 #include "qetproject.h"
 class QSvgGenerator;
 class ExportPropertiesWidget;
@@ -38,6 +40,11 @@ class ExportDialog : public QDialog {
 	// methods
 	int diagramsToExportCount() const;
 	static QPointF rotation_transformed(qreal, qreal, qreal, qreal, qreal);
+	static void generateDxf(Diagram *, int, int, const QString &,
+				const ExportProperties &);
+	static std::function<void ()> prepareDxf(Diagram *, int, int,
+						 const QString &,
+						 const ExportProperties &);
 
 	private:
 	ExportDialog(const ExportDialog &);
@@ -91,9 +98,9 @@ class ExportDialog : public QDialog {
 	QWidget *initDiagramsListPart();
 	void saveReloadDiagramParameters(Diagram *, bool = true);
 	void generateSvg(Diagram *, int, int, bool, QIODevice &);
-	void generateDxf(Diagram *, int, int, QString &);
 	QImage generateImage(Diagram *, int, int, bool);
-	void exportDiagram(ExportDiagramLine *);
+	void exportDiagram(ExportDiagramLine *,
+			   QList<std::function<void ()>> *dxf_writes);
 	qreal diagramRatio(Diagram *);
 	QSize diagramSize(Diagram *);
 
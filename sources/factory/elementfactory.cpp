@@ -17,6 +17,7 @@
 */
 #include "elementfactory.h"
 
+#include "../ElementsCollection/elementdefinitioncache.h"
 #include "../qetgraphicsitem/masterelement.h"
 #include "../qetgraphicsitem/reportelement.h"
 #include "../qetgraphicsitem/simpleelement.h"
@@ -42,10 +43,10 @@ Element * ElementFactory::createElement(const ElementsLocation &location, QGraph
 		return nullptr;
 	}
 
-	auto doc = location.pugiXml();
-	if (doc.document_element().attribute("link_type"))
+	const auto definition = location.definition();
+	if (definition && !definition->linkType().isEmpty())
 	{
-		QString link_type(doc.document_element().attribute("link_type").as_string());
+		const QString link_type(definition->linkType());
 		if (link_type == QLatin1String("next_report") || link_type == QLatin1String("previous_report"))
 			return (new ReportElement(location, link_type, qgi, state));
 		if (link_type == QLatin1String("master"))
@@ -17,6 +17,7 @@
 */
 #include "elementpicturefactory.h"
 
+#include "../ElementsCollection/elementdefinitioncache.h"
 #include "../ElementsCollection/elementslocation.h"
 #include "../editor/graphicspart/partline.h"
 #include "../qetapp.h"
@@ -54,7 +55,7 @@ void ElementPictureFactory::getPictures(const ElementsLocation &location, QPictu
 		return;
 	}
 
-	if(m_pictures_H.keys().contains(uuid))
+	if(m_pictures_H.contains(uuid))
 	{
 		picture = m_pictures_H.value(uuid);
 		low_picture = m_low_pictures_H.value(uuid);
@@ -83,17 +84,17 @@ QPixmap ElementPictureFactory::pixmap(const ElementsLocation &location)
 		return m_pixmap_H.value(uuid);
 	}
 
-	if(build(location))
+	const auto definition = location.definition();
+	if(definition && build(location))
 	{
-		auto doc = location.pugiXml();
 			//size
-		int w = doc.document_element().attribute("width").as_int();
-		int h = doc.document_element().attribute("height").as_int();
+		int w = definition->size().width();
+		int h = definition->size().height();
 		while (w % 10) ++ w;
 		while (h % 10) ++ h;
 			//hotspot
-		int hsx = qMin(doc.document_element().attribute("hotspot_x").as_int(), w);
-		int hsy = qMin(doc.document_element().attribute("hotspot_y").as_int(), h);
+		int hsx = qMin(definition->hotspot().x(), w);
+		int hsy = qMin(definition->hotspot().y(), h);
 
 		QPixmap pix(w, h);
 		pix.fill(QColor(255, 255, 255, 0));
@@ -151,7 +152,11 @@ bool ElementPictureFactory::build(const ElementsLocation &location,
 				  QPicture *picture,
 				  QPicture *low_picture)
 {
-	QDomElement dom = location.xml();
+	const auto definition = location.definition();
+	if (!definition) {
+		return false;
+	}
+	const QDomElement dom = definition->xml();
 
 		//Check if the current version can read the xml description
 	const auto elmt_version = QetVersion::fromXmlAttribute(dom);
@@ -234,7 +239,7 @@ bool ElementPictureFactory::build(const ElementsLocation &location,
 	painter.end();
 	low_painter.end();
 
-	const auto uuid_ = location.uuid();
+	const auto uuid_ = definition->uuid();
 	if (!picture) {
 		m_pictures_H.insert(uuid_, pic);
 		m_primitives_H.insert(uuid_, primitives_);
@@ -190,6 +190,23 @@ QGuiApplication::setHighDpiScaleFactorRoundingPolicy(QetSettings::hdpiScaleFacto
 #endif
 
 
+	QStringList arguments;
+	for (int i = 1 ; i < argc ; ++i) {
+		arguments << QString::fromLocal8Bit(argv[i]);
+	}
+	if (QETArguments(arguments).exportRequested())
+	{
+		//The command line export doesn't need a display
+		//nor to be the single instance of QElectroTech
+		if (qEnvironmentVariableIsEmpty("QT_QPA_PLATFORM")) {
+			qputenv("QT_QPA_PLATFORM", "offscreen");
+		}
+		QApplication export_app(argc, argv);
+		//QETApp run the export in its constructor
+		QETApp qetapp;
+		return qetapp.exportResult();
+	}
+
 	SingleApplication app(argc, argv, true);
 #ifdef Q_OS_MACOS
 	//Handle the opening of QET when user double click on a .qet .elmt .tbt file
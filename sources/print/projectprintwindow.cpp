@@ -232,6 +232,8 @@ void ProjectPrintWindow::requestPaint()
  */
 void ProjectPrintWindow::printDiagram(Diagram *diagram, bool fit_page, QPainter *painter, QPrinter *printer)
 {
+		//Only the printed folios are loaded
+	m_project->materializeDiagram(diagram);
 
 	////Prepare the print////
 		//Deselect all
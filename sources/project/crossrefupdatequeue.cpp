@@ -0,0 +1,64 @@
+/*
+	Copyright 2006-2025 The QElectroTech Team
+	This file is part of QElectroTech.
+	
+	QElectroTech is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 2 of the License, or
+	(at your option) any later version.
+	
+	QElectroTech is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+	
+	You should have received a copy of the GNU General Public License
+	along with QElectroTech.  If not, see <http://www.gnu.org/licenses/>.
+*/
+#include "crossrefupdatequeue.h"
+
+#include "../qetgraphicsitem/crossrefitem.h"
+
+/**
+	@brief CrossRefUpdateQueue::CrossRefUpdateQueue
+	@param parent
+*/
+CrossRefUpdateQueue::CrossRefUpdateQueue(QObject *parent) :
+	QObject(parent)
+{
+	m_timer.setSingleShot(true);
+	m_timer.setInterval(0);
+	connect(&m_timer, &QTimer::timeout,
+		this, &CrossRefUpdateQueue::flush);
+}
+
+/**
+	@brief CrossRefUpdateQueue::invalidate
+	Queue xref, a cross reference queued several times
+	before the queue is processed is only checked once.
+	@param xref
+*/
+void CrossRefUpdateQueue::invalidate(CrossRefItem *xref)
+{
+	m_invalid_xrefs.insert(xref, xref);
+	if (!m_timer.isActive()) {
+		m_timer.start();
+	}
+}
+
+/**
+	@brief CrossRefUpdateQueue::flush
+	Draw again the queued cross references which changed.
+*/
+void CrossRefUpdateQueue::flush()
+{
+	m_timer.stop();
+	const auto xrefs = m_invalid_xrefs;
+	m_invalid_xrefs.clear();
+
+	for (const auto &xref : xrefs) {
+		if (xref) {
+			xref->updateIfChanged();
+		}
+	}
+}
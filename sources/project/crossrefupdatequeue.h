@@ -0,0 +1,54 @@
+/*
+	Copyright 2006-2025 The QElectroTech Team
+	This file is part of QElectroTech.
+	
+	QElectroTech is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 2 of the License, or
+	(at your option) any later version.
+	
+	QElectroTech is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+	
+	You should have received a copy of the GNU General Public License
+	along with QElectroTech.  If not, see <http://www.gnu.org/licenses/>.
+*/
+#ifndef CROSSREFUPDATEQUEUE_H
+#define CROSSREFUPDATEQUEUE_H
+
+#include <QHash>
+#include <QObject>
+#include <QPointer>
+#include <QTimer>
+
+class CrossRefItem;
+
+/**
+	@brief The CrossRefUpdateQueue class
+	Queue of the cross references of a project which may need to be drawn
+	again. A cross reference is queued each time something it displays
+	may have changed (order of the folios, position of a slave...),
+	the queue is processed once at the next turn of the event loop,
+	and each queued cross reference is drawn again only if the text
+	it displays really changed.
+*/
+class CrossRefUpdateQueue : public QObject
+{
+		Q_OBJECT
+
+	public:
+		CrossRefUpdateQueue(QObject *parent = nullptr);
+
+		void invalidate(CrossRefItem *xref);
+
+	public slots:
+		void flush();
+
+	private:
+		QHash<CrossRefItem *, QPointer<CrossRefItem>> m_invalid_xrefs;
+		QTimer m_timer;
+};
+
+#endif // CROSSREFUPDATEQUEUE_H
@@ -0,0 +1,413 @@
+/*
+	Copyright 2006-2025 The QElectroTech Team
+	This file is part of QElectroTech.
+
+	QElectroTech is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 2 of the License, or
+	(at your option) any later version.
+
+	QElectroTech is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with QElectroTech.  If not, see <http://www.gnu.org/licenses/>.
+*/
+#include "diagramcontentdata.h"
+
+#include "../ElementsCollection/elementslocation.h"
+#include "../qet.h"
+#include "../qetgraphicsitem/ViewItem/qetgraphicstableitem.h"
+#include "../qetgraphicsitem/conductor.h"
+#include "../qetgraphicsitem/dynamicelementtextitem.h"
+#include "../qetgraphicsitem/element.h"
+#include "../qetgraphicsitem/elementtextitemgroup.h"
+#include "../qetgraphicsitem/terminal.h"
+#include "../qetxml.h"
+#include "pugixml/src/pugixml.hpp"
+
+namespace {
+/**
+	@brief pugiString
+	@param value : an UTF-8 encoded text read by pugixml
+	@return value as QString
+*/
+QString pugiString(const char *value)
+{
+	return QString::fromUtf8(value);
+}
+}
+
+/**
+	@brief TerminalContentData::fromXml
+	@param xml : a valid terminal xml element (see Terminal::valideXml)
+	@return the description of the terminal
+*/
+TerminalContentData TerminalContentData::fromXml(const QDomElement &xml)
+{
+	TerminalContentData data;
+	data.id = xml.attribute(QStringLiteral("id")).toInt();
+	data.pos = QPointF(xml.attribute(QStringLiteral("x")).toDouble(),
+			   xml.attribute(QStringLiteral("y")).toDouble());
+	data.orientation = xml.attribute(QStringLiteral("orientation")).toInt();
+	return data;
+}
+
+/**
+	@brief ElementTextContentData::fromXml
+	@param xml : a dynamic element text xml element
+	@return the description of the text
+*/
+ElementTextContentData ElementTextContentData::fromXml(const QDomElement &xml)
+{
+	ElementTextContentData data;
+	data.uuid = QUuid(xml.attribute(QStringLiteral("uuid")));
+	data.text_from = xml.attribute(QStringLiteral("text_from"));
+	data.text = xml.firstChildElement(QStringLiteral("text")).text();
+	data.info_name = xml.firstChildElement(QStringLiteral("info_name")).text();
+	data.composite_text = xml.firstChildElement(QStringLiteral("composite_text")).text();
+	data.xml = xml;
+	return data;
+}
+
+/**
+	@brief ElementContentData::userTexts
+	@return the text of the texts written by the user
+	and the name of the text groups.
+	The texts from the informations or composed of the informations
+	are not returned, see informations.
+*/
+QStringList ElementContentData::userTexts() const
+{
+	QStringList list;
+	for (const auto &text : texts) {
+		if (text.text_from == QLatin1String("UserText")) {
+			list << text.text;
+		}
+	}
+	list << text_group_names;
+	return list;
+}
+
+/**
+	@brief ElementContentData::location
+	@param project : the project of the folio of the element,
+	used to find an element embedded in the project
+	@return the location of the definition of the element
+*/
+ElementsLocation ElementContentData::location(QETProject *project) const
+{
+	return type.startsWith(QStringLiteral("embed://"))
+			? ElementsLocation(type, project)
+			: ElementsLocation(type);
+}
+
+/**
+	@brief ElementContentData::fromXml
+	@param xml : a valid element xml element (see Element::valideXml)
+	@return the description of the element
+*/
+ElementContentData ElementContentData::fromXml(const QDomElement &xml)
+{
+	ElementContentData data;
+	data.type = xml.attribute(QStringLiteral("type"));
+	data.uuid = QUuid(xml.attribute(QStringLiteral("uuid"),
+					QUuid::createUuid().toString()));
+	data.pos = QPointF(xml.attribute(QStringLiteral("x")).toDouble(),
+			   xml.attribute(QStringLiteral("y")).toDouble());
+	data.z = xml.attribute(QStringLiteral("z")).toDouble(&data.has_z);
+
+	bool conv_ok;
+	data.orientation = xml.attribute(QStringLiteral("orientation")).toInt(&conv_ok);
+	if (!conv_ok || data.orientation < 0 || data.orientation > 3) {
+		data.orientation = 0;
+	}
+
+	data.prefix = xml.attribute(QStringLiteral("prefix"));
+	data.freeze_label = xml.attribute(QStringLiteral("freezeLabel"),
+					  QStringLiteral("false")) != QLatin1String("false");
+
+	data.informations.fromXml(xml.firstChildElement(QStringLiteral("elementInformations")),
+				  QStringLiteral("elementInformation"));
+
+	for (const auto &link : QET::findInDomElement(xml,
+						      QStringLiteral("links_uuids"),
+						      QStringLiteral("link_uuid"))) {
+		data.links << QUuid(link.attribute(QStringLiteral("uuid")));
+	}
+
+	for (auto terminal : QET::findInDomElement(xml,
+						   QStringLiteral("terminals"),
+						   QStringLiteral("terminal"))) {
+		if (Terminal::valideXml(terminal)) {
+			data.terminals << TerminalContentData::fromXml(terminal);
+		}
+	}
+
+	for (const auto &text : QET::findInDomElement(xml,
+						      QStringLiteral("dynamic_texts"),
+						      DynamicElementTextItem::xmlTagName())) {
+		data.texts << ElementTextContentData::fromXml(text);
+	}
+
+	for (const auto &group : QET::findInDomElement(xml,
+						       QStringLiteral("texts_groups"),
+						       ElementTextItemGroup::xmlTaggName()))
+	{
+		data.text_group_names << group.attribute(QStringLiteral("name"),
+							 QStringLiteral("no name"));
+		data.text_groups << group;
+	}
+
+	data.xml = xml;
+	return data;
+}
+
+/**
+	@brief ElementContentData::fromXml
+	Decode the description of an element of a folio not yet materialized :
+	the terminals and the xml of the element are not decoded.
+	Unlike the QDom version, an element without uuid get a null uuid.
+	@param xml : an element xml node
+	@return the description of the element
+*/
+ElementContentData ElementContentData::fromXml(const pugi::xml_node &xml)
+{
+	ElementContentData data;
+	data.type = pugiString(xml.attribute("type").value());
+	data.uuid = QUuid(pugiString(xml.attribute("uuid").value()));
+	data.pos = QPointF(xml.attribute("x").as_double(),
+			   xml.attribute("y").as_double());
+	data.has_z = !xml.attribute("z").empty();
+	data.z = xml.attribute("z").as_double();
+
+	data.orientation = xml.attribute("orientation").as_int();
+	if (data.orientation < 0 || data.orientation > 3) {
+		data.orientation = 0;
+	}
+
+	data.prefix = pugiString(xml.attribute("prefix").value());
+	data.freeze_label = QLatin1String(xml.attribute("freezeLabel").as_string("false"))
+			    != QLatin1String("false");
+
+	data.informations.fromXml(xml.child("elementInformations"),
+				  QStringLiteral("elementInformation"));
+
+	for (const auto &link : xml.child("links_uuids").children("link_uuid")) {
+		data.links << QUuid(pugiString(link.attribute("uuid").value()));
+	}
+
+	const auto text_tag = DynamicElementTextItem::xmlTagName().toUtf8();
+	for (const auto &text_node : xml.child("dynamic_texts").children(text_tag.constData()))
+	{
+		ElementTextContentData text;
+		text.uuid = QUuid(pugiString(text_node.attribute("uuid").value()));
+		text.text_from = pugiString(text_node.attribute("text_from").value());
+		text.text = pugiString(text_node.child("text").text().get());
+		text.info_name = pugiString(text_node.child("info_name").text().get());
+		text.composite_text = pugiString(text_node.child("composite_text").text().get());
+		data.texts << text;
+	}
+
+	const auto group_tag = ElementTextItemGroup::xmlTaggName().toUtf8();
+	for (const auto &group : xml.child("texts_groups").children(group_tag.constData())) {
+		data.text_group_names << pugiString(group.attribute("name").as_string("no name"));
+	}
+
+	return data;
+}
+
+/**
+	@brief ConductorContentData::fromXml
+	@param xml : a valid conductor xml element (see Conductor::valideXml)
+	@return the description of the conductor
+*/
+ConductorContentData ConductorContentData::fromXml(const QDomElement &xml)
+{
+	ConductorContentData data;
+		// element1 did not exist in the conductor part of the xml until prior 0.7
+	data.legacy_terminals = !xml.hasAttribute(QStringLiteral("element1"));
+	if (data.legacy_terminals)
+	{
+		data.legacy_terminal1 = xml.attribute(QStringLiteral("terminal1")).toInt();
+		data.legacy_terminal2 = xml.attribute(QStringLiteral("terminal2")).toInt();
+	}
+	else
+	{
+		data.element1  = QUuid(xml.attribute(QStringLiteral("element1")));
+		data.terminal1 = QUuid(xml.attribute(QStringLiteral("terminal1")));
+		data.element2  = QUuid(xml.attribute(QStringLiteral("element2")));
+		data.terminal2 = QUuid(xml.attribute(QStringLiteral("terminal2")));
+	}
+
+	data.pos = QPointF(xml.attribute(QStringLiteral("x")).toDouble(),
+			   xml.attribute(QStringLiteral("y")).toDouble());
+
+		//The invalid segments are ignored
+	for (auto segment = xml.firstChildElement(QStringLiteral("segment")) ;
+	     !segment.isNull() ;
+	     segment = segment.nextSiblingElement(QStringLiteral("segment")))
+	{
+		if (!segment.hasAttribute(QStringLiteral("length"))) {
+			continue;
+		}
+		bool ok;
+		const qreal length = segment.attribute(QStringLiteral("length")).toDouble(&ok);
+		if (!ok) {
+			continue;
+		}
+		if (segment.attribute(QStringLiteral("orientation")) == QLatin1String("horizontal")) {
+			data.segments << QPointF(length, 0.0);
+		} else {
+			data.segments << QPointF(0.0, length);
+		}
+	}
+
+	QDomElement properties_xml = xml;
+	data.properties.fromXml(properties_xml);
+	data.freeze_label = xml.attribute(QStringLiteral("freezeLabel")) == QLatin1String("true");
+	data.xml = xml;
+	return data;
+}
+
+/**
+	@brief ConductorContentData::fromXml
+	Decode the description of a conductor of a folio not yet materialized :
+	the segments, the xml and the properties which are not searched
+	are not decoded.
+	@param xml : a conductor xml node
+	@return the description of the conductor
+*/
+ConductorContentData ConductorContentData::fromXml(const pugi::xml_node &xml)
+{
+	ConductorContentData data;
+	data.legacy_terminals = xml.attribute("element1").empty();
+	if (data.legacy_terminals)
+	{
+		data.legacy_terminal1 = xml.attribute("terminal1").as_int();
+		data.legacy_terminal2 = xml.attribute("terminal2").as_int();
+	}
+	else
+	{
+		data.element1  = QUuid(pugiString(xml.attribute("element1").value()));
+		data.terminal1 = QUuid(pugiString(xml.attribute("terminal1").value()));
+		data.element2  = QUuid(pugiString(xml.attribute("element2").value()));
+		data.terminal2 = QUuid(pugiString(xml.attribute("terminal2").value()));
+	}
+
+	data.pos = QPointF(xml.attribute("x").as_double(),
+			   xml.attribute("y").as_double());
+
+	data.properties.text               = pugiString(xml.attribute("num").value());
+	data.properties.m_function         = pugiString(xml.attribute("function").value());
+	data.properties.m_tension_protocol = pugiString(xml.attribute("tension_protocol").value());
+	data.properties.m_wire_color       = pugiString(xml.attribute("conductor_color").value());
+	data.properties.m_wire_section     = pugiString(xml.attribute("conductor_section").value());
+	data.freeze_label = QLatin1String(xml.attribute("freezeLabel").value())
+			    == QLatin1String("true");
+	return data;
+}
+
+/**
+	@brief DiagramContentData::isEmpty
+	@return true if the folio have no content
+*/
+bool DiagramContentData::isEmpty() const
+{
+	return elements.isEmpty()
+			&& conductors.isEmpty()
+			&& texts.isEmpty()
+			&& images.isEmpty()
+			&& shapes.isEmpty()
+			&& tables.isEmpty()
+			&& xml.firstChildElement(QStringLiteral("terminal_strip_items")).isNull();
+}
+
+/**
+	@brief DiagramContentData::fromXml
+	Decode the content of a folio.
+	Don't create any graphics item and don't access to the project,
+	so this function can be called from any thread.
+	@param xml : the diagram xml element
+	@return the description of the content
+*/
+DiagramContentData DiagramContentData::fromXml(const QDomElement &xml)
+{
+	DiagramContentData data;
+	data.xml = xml;
+
+	for (auto element : QET::findInDomElement(xml,
+						  QStringLiteral("elements"),
+						  QStringLiteral("element"))) {
+		if (Element::valideXml(element)) {
+			data.elements << ElementContentData::fromXml(element);
+		}
+	}
+
+	for (auto conductor : QET::findInDomElement(xml,
+						    QStringLiteral("conductors"),
+						    QStringLiteral("conductor"))) {
+		if (Conductor::valideXml(conductor)) {
+			data.conductors << ConductorContentData::fromXml(conductor);
+		}
+	}
+
+	data.texts  = QET::findInDomElement(xml, QStringLiteral("inputs"), QStringLiteral("input"));
+	data.images = QET::findInDomElement(xml, QStringLiteral("images"), QStringLiteral("image"));
+	data.shapes = QET::findInDomElement(xml, QStringLiteral("shapes"), QStringLiteral("shape"));
+	for (const auto &table : QETXML::subChild(xml,
+						  QStringLiteral("tables"),
+						  QetGraphicsTableItem::xmlTagName())) {
+		data.tables << table;
+		data.table_uuids << QUuid(table.attribute(QStringLiteral("uuid")));
+	}
+
+	return data;
+}
+
+/**
+	@brief DiagramContentData::fromXml
+	Decode the description kept by a folio not yet materialized :
+	the elements (see ElementContentData::fromXml(const pugi::xml_node &)),
+	the conductors (see ConductorContentData::fromXml(const pugi::xml_node &)),
+	the html of the independent texts and the uuid of the tables.
+	Like the QDom version,
+	this function can be called from any thread.
+	@param xml : the diagram xml node
+	@return the description of the content
+*/
+DiagramContentData DiagramContentData::fromXml(const pugi::xml_node &xml)
+{
+	DiagramContentData data;
+	for (const auto &element : xml.child("elements").children("element"))
+	{
+		if (element.attribute("type").empty()
+			|| element.attribute("x").empty()
+			|| element.attribute("y").empty()) {
+			continue;
+		}
+		data.elements << ElementContentData::fromXml(element);
+	}
+
+	for (const auto &conductor : xml.child("conductors").children("conductor"))
+	{
+		if (conductor.attribute("terminal1").empty()
+			|| conductor.attribute("terminal2").empty()) {
+			continue;
+		}
+		data.conductors << ConductorContentData::fromXml(conductor);
+	}
+
+	for (const auto &text : xml.child("inputs").children("input")) {
+		data.texts_html << pugiString(text.attribute("text").value());
+	}
+
+	const auto table_tag = QetGraphicsTableItem::xmlTagName().toUtf8();
+	for (const auto &table : xml.child("tables").children(table_tag.constData())) {
+		data.table_uuids << QUuid(pugiString(table.attribute("uuid").value()));
+	}
+
+	return data;
+}
@@ -0,0 +1,154 @@
+/*
+	Copyright 2006-2025 The QElectroTech Team
+	This file is part of QElectroTech.
+
+	QElectroTech is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 2 of the License, or
+	(at your option) any later version.
+
+	QElectroTech is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with QElectroTech.  If not, see <http://www.gnu.org/licenses/>.
+*/
+#ifndef DIAGRAMCONTENTDATA_H
+#define DIAGRAMCONTENTDATA_H
+
+#include "../conductorproperties.h"
+#include "../diagramcontext.h"
+
+#include <QDomElement>
+#include <QList>
+#include <QPointF>
+#include <QStringList>
+#include <QUuid>
+
+class ElementsLocation;
+class QETProject;
+
+/**
+	@brief The TerminalContentData struct
+	Plain description of a terminal of an element of a folio.
+*/
+struct TerminalContentData
+{
+	int id = 0;
+	QPointF pos;
+	int orientation = 0;
+
+	static TerminalContentData fromXml(const QDomElement &xml);
+};
+
+/**
+	@brief The ElementTextContentData struct
+	Plain description of a dynamic text of an element of a folio.
+	The font, color, frame and alignment of the text are not decoded,
+	the text item read them from xml.
+*/
+struct ElementTextContentData
+{
+	QUuid uuid;
+	QString text_from;
+	QString text;
+	QString info_name;
+	QString composite_text;
+	QDomElement xml;
+
+	static ElementTextContentData fromXml(const QDomElement &xml);
+};
+
+/**
+	@brief The ElementContentData struct
+	Plain description of an element of a folio.
+	The text groups and the sequential numbers keep their xml,
+	they are read by the items of the element.
+	When decoded from pugixml, only the data used while the folio
+	is not materialized are decoded (no terminals and no xml).
+*/
+struct ElementContentData
+{
+	QString type;
+	QUuid uuid;
+	QPointF pos;
+	bool has_z = false;
+	qreal z = 0;
+	int orientation = 0;
+	QString prefix;
+	bool freeze_label = false;
+	DiagramContext informations;
+	QList<QUuid> links;
+	QList<TerminalContentData> terminals;
+	QList<ElementTextContentData> texts;
+	QStringList text_group_names;
+	QList<QDomElement> text_groups;
+	QDomElement xml;
+
+	QStringList userTexts() const;
+	ElementsLocation location(QETProject *project) const;
+	static ElementContentData fromXml(const QDomElement &xml);
+	static ElementContentData fromXml(const pugi::xml_node &xml);
+};
+
+/**
+	@brief The ConductorContentData struct
+	Plain description of a conductor of a folio.
+	Until version 0.7 the terminals are identified by an id unique
+	in the folio, they are now identified by the uuid of their element
+	and their own uuid (see TerminalIndex).
+	When decoded from pugixml, only the terminals, the position
+	and the searchable properties (text, function, tension/protocol,
+	wire color and section) are decoded (no segments and no xml).
+*/
+struct ConductorContentData
+{
+	bool legacy_terminals = false;
+	QUuid element1, terminal1, element2, terminal2;
+	int legacy_terminal1 = -1, legacy_terminal2 = -1;
+	QPointF pos;
+		/// Horizontal and vertical length of each segment of the path
+	QList<QPointF> segments;
+	ConductorProperties properties;
+	bool freeze_label = false;
+	QDomElement xml;
+
+	static ConductorContentData fromXml(const QDomElement &xml);
+	static ConductorContentData fromXml(const pugi::xml_node &xml);
+};
+
+/**
+	@brief The DiagramContentData struct
+	Plain description of the content of a folio, decoded from its xml
+	without create any graphics item.
+	It can be decoded by a worker thread,
+	the items are then built in the GUI thread by Diagram::addContent.
+	The independent texts, images, shapes and tables are kept as xml,
+	their items read them.
+ *
+	The description decoded from pugixml is the one kept by a folio
+	not yet materialized (see Diagram::setPendingXml) : only the elements,
+	the conductors, the html of the independent texts and the uuid
+	of the tables are decoded, the other members are empty.
+*/
+struct DiagramContentData
+{
+	QList<ElementContentData> elements;
+	QList<ConductorContentData> conductors;
+	QList<QDomElement> texts;
+	QList<QDomElement> images;
+	QList<QDomElement> shapes;
+	QList<QDomElement> tables;
+	QList<QUuid> table_uuids;
+		/// Html of the independent texts, only decoded from pugixml
+	QStringList texts_html;
+	QDomElement xml;
+
+	bool isEmpty() const;
+	static DiagramContentData fromXml(const QDomElement &xml);
+	static DiagramContentData fromXml(const pugi::xml_node &xml);
+};
+
+#endif // DIAGRAMCONTENTDATA_H
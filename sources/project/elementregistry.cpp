@@ -0,0 +1,233 @@
+/*
+	Copyright 2006-2025 The QElectroTech Team
+	This file is part of QElectroTech.
+
+	QElectroTech is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 2 of the License, or
+	(at your option) any later version.
+
+	QElectroTech is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with QElectroTech.  If not, see <http://www.gnu.org/licenses/>.
+*/
+#include "elementregistry.h"
+
+#include "../qetgraphicsitem/element.h"
+
+/**
+	@brief ElementRegistry::ElementRegistry
+	@param parent
+*/
+ElementRegistry::ElementRegistry(QObject *parent) :
+	QObject(parent)
+{}
+
+/**
+	@brief ElementRegistry::addElement
+	Add element to the registry, element is owned by diagram.
+	If element is already registered, only his diagram is updated.
+	@param element
+	@param diagram
+*/
+void ElementRegistry::addElement(Element *element, Diagram *diagram)
+{
+	if (!element) {
+		return;
+	}
+
+	if (m_entries.contains(element)) {
+		m_entries[element].m_diagram = diagram;
+		return;
+	}
+
+	Entry entry;
+	entry.m_diagram = diagram;
+	entry.m_uuid = element->uuid();
+	entry.m_type = element->elementData().m_type;
+	m_entries.insert(element, entry);
+	m_by_uuid.insert(entry.m_uuid, element);
+	m_by_type[entry.m_type].insert(element);
+	if (element->isFree()) {
+		m_free_by_type[entry.m_type].insert(element);
+	}
+
+	connect(element, &Element::uuidChanged, this, [this, element]() {
+		updateUuid(element);
+	});
+	connect(element, &Element::linkedElementChanged, this, [this, element]() {
+		updateFreeState(element);
+	});
+		//Element is not dereferenced because when destroyed is emitted
+		//element is already partially destroyed
+	connect(element, &QObject::destroyed, this, [this, element]() {
+		removeElement(element);
+	});
+
+	emit elementAdded(element);
+}
+
+/**
+	@brief ElementRegistry::removeElement
+	Remove element from the registry.
+	This function never dereference element.
+	@param element
+*/
+void ElementRegistry::removeElement(Element *element)
+{
+	if (!m_entries.contains(element)) {
+		return;
+	}
+
+	const Entry entry = m_entries.take(element);
+	m_by_uuid.remove(entry.m_uuid, element);
+	m_by_type[entry.m_type].remove(element);
+	m_free_by_type[entry.m_type].remove(element);
+	disconnect(element, nullptr, this, nullptr);
+
+	emit elementRemoved(element);
+}
+
+/**
+	@brief ElementRegistry::removeDiagram
+	Remove every element of diagram from the registry
+	@param diagram
+*/
+void ElementRegistry::removeDiagram(Diagram *diagram)
+{
+	QList<Element *> to_remove;
+	for (auto it = m_entries.cbegin() ; it != m_entries.cend() ; ++it) {
+		if (it.value().m_diagram == diagram) {
+			to_remove << it.key();
+		}
+	}
+	for (const auto &element : qAsConst(to_remove)) {
+		removeElement(element);
+	}
+}
+
+/**
+	@brief ElementRegistry::element
+	@param uuid
+	@return the element with uuid uuid or nullptr
+*/
+Element *ElementRegistry::element(const QUuid &uuid) const
+{
+	return m_by_uuid.value(uuid, nullptr);
+}
+
+/**
+	@brief ElementRegistry::diagram
+	@param element
+	@return the diagram of element or nullptr if element isn't registered
+*/
+Diagram *ElementRegistry::diagram(Element *element) const
+{
+	return m_entries.value(element).m_diagram;
+}
+
+/**
+	@brief ElementRegistry::elements
+	@return every registered elements
+*/
+QList<Element *> ElementRegistry::elements() const
+{
+	return m_entries.keys();
+}
+
+/**
+	@brief ElementRegistry::elements
+	@param uuids
+	@return the elements with an uuid in uuids
+*/
+QList<Element *> ElementRegistry::elements(const QList<QUuid> &uuids) const
+{
+	QList<Element *> found_elements;
+	QSet<Element *> found_set;
+	for (const auto &uuid : uuids)
+	{
+		if (auto element_ = m_by_uuid.value(uuid, nullptr))
+		{
+			if (!found_set.contains(element_)) {
+				found_set.insert(element_);
+				found_elements << element_;
+			}
+		}
+	}
+	return found_elements;
+}
+
+/**
+	@brief ElementRegistry::elements
+	@param types
+	@return every elements with a type in types
+*/
+QList<Element *> ElementRegistry::elements(ElementData::Types types) const
+{
+	QList<Element *> found_elements;
+	for (auto it = m_by_type.cbegin() ; it != m_by_type.cend() ; ++it)
+	{
+		if (types.testFlag(static_cast<ElementData::Type>(it.key()))) {
+			found_elements.append(it.value().values());
+		}
+	}
+	return found_elements;
+}
+
+/**
+	@brief ElementRegistry::freeElements
+	@param types
+	@return every elements with a type in types
+	and not linked to another element.
+*/
+QList<Element *> ElementRegistry::freeElements(ElementData::Types types) const
+{
+	QList<Element *> found_elements;
+	for (auto it = m_free_by_type.cbegin() ; it != m_free_by_type.cend() ; ++it)
+	{
+		if (types.testFlag(static_cast<ElementData::Type>(it.key()))) {
+			found_elements.append(it.value().values());
+		}
+	}
+	return found_elements;
+}
+
+/**
+	@brief ElementRegistry::updateUuid
+	Update the uuid index when the uuid of element change
+	@param element
+*/
+void ElementRegistry::updateUuid(Element *element)
+{
+	if (!m_entries.contains(element)) {
+		return;
+	}
+
+	Entry &entry = m_entries[element];
+	m_by_uuid.remove(entry.m_uuid, element);
+	entry.m_uuid = element->uuid();
+	m_by_uuid.insert(entry.m_uuid, element);
+}
+
+/**
+	@brief ElementRegistry::updateFreeState
+	Update the set of free elements when the links of element change
+	@param element
+*/
+void ElementRegistry::updateFreeState(Element *element)
+{
+	if (!m_entries.contains(element)) {
+		return;
+	}
+
+	const auto type = m_entries.value(element).m_type;
+	if (element->isFree()) {
+		m_free_by_type[type].insert(element);
+	} else {
+		m_free_by_type[type].remove(element);
+	}
+}
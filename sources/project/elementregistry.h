@@ -0,0 +1,85 @@
+/*
+	Copyright 2006-2025 The QElectroTech Team
+	This file is part of QElectroTech.
+
+	QElectroTech is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 2 of the License, or
+	(at your option) any later version.
+
+	QElectroTech is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with QElectroTech.  If not, see <http://www.gnu.org/licenses/>.
+*/
+#ifndef ELEMENTREGISTRY_H
+#define ELEMENTREGISTRY_H
+
+#include "../properties/elementdata.h"
+
+#include <QHash>
+#include <QMultiHash>
+#include <QObject>
+#include <QSet>
+#include <QUuid>
+
+class Diagram;
+class Element;
+
+/**
+	@brief The ElementRegistry class
+	Live index of every element of a project.
+	Elements are added and removed by Diagram::addItem and
+	Diagram::removeItem, the registry follow the uuid changes of the elements
+	and forget an element when it is destroyed.
+	Elements can be found by uuid, by type and by free state
+	without walking the items of each diagram.
+*/
+class ElementRegistry : public QObject
+{
+		Q_OBJECT
+
+	signals:
+		void elementAdded(Element *element);
+			//element can be already destroyed, never dereference it
+		void elementRemoved(Element *element);
+
+	public:
+		ElementRegistry(QObject *parent = nullptr);
+
+		void addElement(Element *element, Diagram *diagram);
+		void removeElement(Element *element);
+		void removeDiagram(Diagram *diagram);
+
+		Element *element(const QUuid &uuid) const;
+		Diagram *diagram(Element *element) const;
+		QList<Element *> elements() const;
+		QList<Element *> elements(const QList<QUuid> &uuids) const;
+		QList<Element *> elements(ElementData::Types types) const;
+		QList<Element *> freeElements(ElementData::Types types) const;
+
+	private:
+		void updateUuid(Element *element);
+		void updateFreeState(Element *element);
+
+		struct Entry
+		{
+			Diagram *m_diagram = nullptr;
+			QUuid m_uuid;
+			ElementData::Type m_type = ElementData::Simple;
+		};
+
+		QHash<Element *, Entry> m_entries;
+			//Several elements can share an uuid for a short time,
+			//for example pasted elements before they get a new uuid.
+		QMultiHash<QUuid, Element *> m_by_uuid;
+		QHash<int, QSet<Element *>> m_by_type;
+			//Elements not linked to another element, by type,
+			//updated each time the links of an element change.
+		QHash<int, QSet<Element *>> m_free_by_type;
+};
+
+#endif // ELEMENTREGISTRY_H
@@ -0,0 +1,309 @@
+/*
+	Copyright 2006-2025 The QElectroTech Team
+	This file is part of QElectroTech.
+
+	QElectroTech is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 2 of the License, or
+	(at your option) any later version.
+
+	QElectroTech is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with QElectroTech.  If not, see <http://www.gnu.org/licenses/>.
+*/
+#include "potentialindex.h"
+
+#include "../qetgraphicsitem/conductor.h"
+#include "../qetgraphicsitem/element.h"
+#include "../qetgraphicsitem/terminal.h"
+#include "elementregistry.h"
+
+#include <utility>
+
+/**
+	@brief PotentialIndex::PotentialIndex
+	@param registry : the registry of the elements to index
+	@param parent
+*/
+PotentialIndex::PotentialIndex(ElementRegistry *registry, QObject *parent) :
+	QObject(parent),
+	m_registry(registry)
+{
+	connect(m_registry, &ElementRegistry::elementAdded,
+		this, &PotentialIndex::addElement);
+	connect(m_registry, &ElementRegistry::elementRemoved,
+		this, &PotentialIndex::invalidate);
+}
+
+/**
+	@brief PotentialIndex::potentialConductors
+	Get the conductors at the same potential of conductor.
+	@param conductor : the conductor to search from
+	@param all_diagram : if true the potential follow the folio reports,
+	else only the conductors of the same diagram are returned
+	@param conductors : filled with the conductors at the same potential
+	than conductor, conductor itself excluded.
+	@return false if conductor is unknown by the index,
+	conductors is then left untouched.
+*/
+bool PotentialIndex::potentialConductors(Conductor *conductor,
+					 bool all_diagram,
+					 QSet<Conductor *> &conductors)
+{
+	if (m_dirty) {
+		rebuild();
+	}
+
+	Potentials &potentials = all_diagram ? m_all_potentials
+					     : m_diagram_potentials;
+	if (!conductor || !potentials.contains(conductor)) {
+		return false;
+	}
+
+	const auto list_ = potentials.conductors(conductor);
+#if QT_VERSION < QT_VERSION_CHECK(5, 14, 0)	// ### Qt 6: remove
+	conductors = list_.toSet();
+#else
+	conductors = QSet<Conductor *>(list_.begin(), list_.end());
+#endif
+	conductors.remove(conductor);
+	return true;
+}
+
+/**
+	@brief PotentialIndex::invalidate
+	Mark the index as dirty, the index is rebuilt at the next request.
+*/
+void PotentialIndex::invalidate()
+{
+	if (m_dirty) {
+		return;
+	}
+	m_dirty = true;
+	m_diagram_potentials.clear();
+	m_all_potentials.clear();
+}
+
+/**
+	@brief PotentialIndex::addElement
+	Follow the changes of element and merge it in the index
+	@param element
+*/
+void PotentialIndex::addElement(Element *element)
+{
+	for (const auto &terminal : element->terminals())
+	{
+		connect(terminal, &Terminal::conductorWasAdded,
+			this, &PotentialIndex::addConductor,
+			Qt::UniqueConnection);
+		connect(terminal, &Terminal::conductorWasRemoved,
+			this, &PotentialIndex::invalidate,
+			Qt::UniqueConnection);
+	}
+	connect(element, &Element::linkedElementChanged,
+		this, &PotentialIndex::invalidate,
+		Qt::UniqueConnection);
+
+	if (!m_dirty) {
+		mergeElement(element);
+	}
+}
+
+/**
+	@brief PotentialIndex::addConductor
+	Slot called when a conductor is docked to a terminal of an indexed element
+	@param conductor
+*/
+void PotentialIndex::addConductor(Conductor *conductor)
+{
+	const auto terminal = qobject_cast<Terminal *>(sender());
+	if (m_dirty
+		|| !terminal
+		|| !m_registry->diagram(terminal->parentElement())) {
+		return;
+	}
+	mergeConductor(conductor);
+}
+
+/**
+	@brief PotentialIndex::rebuild
+	Build again the whole index from the elements of the registry
+*/
+void PotentialIndex::rebuild()
+{
+	m_diagram_potentials.clear();
+	m_all_potentials.clear();
+	m_dirty = false;
+
+	for (const auto &element : m_registry->elements()) {
+		mergeElement(element);
+	}
+}
+
+/**
+	@brief PotentialIndex::mergeElement
+	Merge the terminals, conductors and links of element in the index.
+	The rules are the same as relatedPotentialTerminal :
+	terminals of a terminal element share the same potential,
+	terminals of a folio report share the potential of the linked report.
+	@param element
+*/
+void PotentialIndex::mergeElement(Element *element)
+{
+	const auto terminals_ = element->terminals();
+	for (const auto &terminal : terminals_)
+	{
+		for (const auto &conductor : terminal->conductors()) {
+			mergeConductor(conductor);
+		}
+	}
+
+	if (terminals_.isEmpty()) {
+		return;
+	}
+
+	if (element->linkType() & Element::Terminale)
+	{
+		for (const auto &terminal : terminals_)
+		{
+			m_diagram_potentials.unite(terminals_.first(), terminal);
+			m_all_potentials.unite(terminals_.first(), terminal);
+		}
+	}
+	else if (element->linkType() & Element::AllReport)
+	{
+		const auto linked_ = element->linkedElements();
+		if (linked_.isEmpty()) {
+			return;
+		}
+		const auto other_terminals = linked_.first()->terminals();
+		for (const auto &terminal : terminals_) {
+			for (const auto &other_terminal : other_terminals) {
+				m_all_potentials.unite(terminal, other_terminal);
+			}
+		}
+	}
+}
+
+/**
+	@brief PotentialIndex::mergeConductor
+	Merge conductor and his two terminals in the index
+	@param conductor
+*/
+void PotentialIndex::mergeConductor(Conductor *conductor)
+{
+	if (!conductor->terminal1 || !conductor->terminal2) {
+		return;
+	}
+
+	for (auto potentials : {&m_diagram_potentials, &m_all_potentials})
+	{
+		potentials->addConductor(conductor);
+		potentials->unite(conductor, conductor->terminal1);
+		potentials->unite(conductor, conductor->terminal2);
+	}
+}
+
+/**
+	@brief PotentialIndex::Potentials::find
+	@param node
+	@return the root of the set of node
+*/
+QGraphicsObject *PotentialIndex::Potentials::find(QGraphicsObject *node)
+{
+	makeSet(node);
+	while (m_parent.value(node) != node)
+	{
+			//Path halving
+		QGraphicsObject *grand_parent = m_parent.value(m_parent.value(node));
+		m_parent.insert(node, grand_parent);
+		node = grand_parent;
+	}
+	return node;
+}
+
+/**
+	@brief PotentialIndex::Potentials::unite
+	Merge the sets of a and b. The conductors of the smallest set
+	are moved to the biggest.
+	@param a
+	@param b
+*/
+void PotentialIndex::Potentials::unite(QGraphicsObject *a, QGraphicsObject *b)
+{
+	QGraphicsObject *root_a = find(a);
+	QGraphicsObject *root_b = find(b);
+	if (root_a == root_b) {
+		return;
+	}
+
+	if (m_conductors.value(root_a).size() < m_conductors.value(root_b).size()) {
+		std::swap(root_a, root_b);
+	}
+
+	m_parent.insert(root_b, root_a);
+	const auto moved_ = m_conductors.take(root_b);
+	if (!moved_.isEmpty()) {
+		m_conductors[root_a].append(moved_);
+	}
+}
+
+/**
+	@brief PotentialIndex::Potentials::addConductor
+	Add conductor as a new set, do nothing if conductor is already known.
+	@param conductor
+*/
+void PotentialIndex::Potentials::addConductor(Conductor *conductor)
+{
+	if (m_parent.contains(conductor)) {
+		return;
+	}
+	makeSet(conductor);
+	m_conductors[conductor].append(conductor);
+}
+
+/**
+	@brief PotentialIndex::Potentials::contains
+	@param node
+	@return true if node is in a set
+*/
+bool PotentialIndex::Potentials::contains(QGraphicsObject *node) const
+{
+	return m_parent.contains(node);
+}
+
+/**
+	@brief PotentialIndex::Potentials::conductors
+	@param node
+	@return the conductors in the same set of node
+*/
+QList<Conductor *> PotentialIndex::Potentials::conductors(QGraphicsObject *node)
+{
+	return m_conductors.value(find(node));
+}
+
+/**
+	@brief PotentialIndex::Potentials::clear
+	Remove every sets
+*/
+void PotentialIndex::Potentials::clear()
+{
+	m_parent.clear();
+	m_conductors.clear();
+}
+
+/**
+	@brief PotentialIndex::Potentials::makeSet
+	Add node as a set of one node if node is not already known
+	@param node
+*/
+void PotentialIndex::Potentials::makeSet(QGraphicsObject *node)
+{
+	if (!m_parent.contains(node)) {
+		m_parent.insert(node, node);
+	}
+}
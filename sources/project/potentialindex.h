@@ -0,0 +1,94 @@
+/*
+	Copyright 2006-2025 The QElectroTech Team
+	This file is part of QElectroTech.
+
+	QElectroTech is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 2 of the License, or
+	(at your option) any later version.
+
+	QElectroTech is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with QElectroTech.  If not, see <http://www.gnu.org/licenses/>.
+*/
+#ifndef POTENTIALINDEX_H
+#define POTENTIALINDEX_H
+
+#include <QHash>
+#include <QList>
+#include <QObject>
+#include <QSet>
+
+class Conductor;
+class Element;
+class ElementRegistry;
+class QGraphicsObject;
+
+/**
+	@brief The PotentialIndex class
+	Index of the potentials (electrical nets) of a project.
+	Terminals and conductors of the elements of the registry are grouped
+	with a union-find structure, terminals of a terminal element share the
+	same potential and terminals of linked folio reports too.
+	Two groups are maintained : one follow the folio reports across the
+	diagrams, the other stay inside each diagram.
+	Added conductors and elements are merged incrementally,
+	any removal or change of the report links mark the index as dirty,
+	the index is then rebuilt at the next request.
+*/
+class PotentialIndex : public QObject
+{
+		Q_OBJECT
+
+	public:
+		PotentialIndex(ElementRegistry *registry, QObject *parent = nullptr);
+
+		bool potentialConductors(Conductor *conductor,
+					 bool all_diagram,
+					 QSet<Conductor *> &conductors);
+
+	public slots:
+		void invalidate();
+
+	private slots:
+		void addElement(Element *element);
+		void addConductor(Conductor *conductor);
+
+	private:
+		void rebuild();
+		void mergeElement(Element *element);
+		void mergeConductor(Conductor *conductor);
+
+		/**
+			@brief The Potentials class
+			Disjoint set of terminals and conductors,
+			each root know the conductors of his set.
+		*/
+		class Potentials
+		{
+			public:
+				QGraphicsObject *find(QGraphicsObject *node);
+				void unite(QGraphicsObject *a, QGraphicsObject *b);
+				void addConductor(Conductor *conductor);
+				bool contains(QGraphicsObject *node) const;
+				QList<Conductor *> conductors(QGraphicsObject *node);
+				void clear();
+
+			private:
+				void makeSet(QGraphicsObject *node);
+
+				QHash<QGraphicsObject *, QGraphicsObject *> m_parent;
+				QHash<QGraphicsObject *, QList<Conductor *>> m_conductors;
+		};
+
+		ElementRegistry *m_registry = nullptr;
+		Potentials m_diagram_potentials;
+		Potentials m_all_potentials;
+		bool m_dirty = false;
+};
+
+#endif // POTENTIALINDEX_H
@@ -0,0 +1,459 @@
+/*
+	Copyright 2006-2025 The QElectroTech Team
+	This file is part of QElectroTech.
+
+	QElectroTech is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 2 of the License, or
+	(at your option) any later version.
+
+	QElectroTech is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with QElectroTech.  If not, see <http://www.gnu.org/licenses/>.
+*/
+#include "projectxmlcache.h"
+
+#include "../ElementsCollection/xmlelementcollection.h"
+#include "../QPropertyUndoCommand/qpropertyundocommand.h"
+#include "../diagram.h"
+#include "../qetgraphicsitem/element.h"
+#include "../qetproject.h"
+#include "elementregistry.h"
+
+#include <QGraphicsObject>
+#include <QIODevice>
+#include <QMutexLocker>
+#include <QUndoStack>
+#include <QtConcurrentMap>
+
+namespace
+{
+		//Placeholder of the folios in the text of the project
+	const QString folios_tag_name = QStringLiteral("qet_project_xml_cache_folios");
+}
+
+/**
+	@brief ProjectXmlCache::ProjectXmlCache
+	@param project : the project to cache
+	@param registry : the registry of the elements of project
+	@param parent
+*/
+ProjectXmlCache::ProjectXmlCache(QETProject *project,
+				 ElementRegistry *registry,
+				 QObject *parent) :
+	QObject(parent),
+	m_project(project)
+{
+	connect(m_project, &QETProject::diagramAdded,
+		this, &ProjectXmlCache::addDiagram);
+	connect(m_project, &QETProject::diagramRemoved,
+		this, &ProjectXmlCache::removeDiagram);
+	connect(m_project, &QETProject::projectDiagramsOrderChanged,
+		this, &ProjectXmlCache::setAllDirty);
+	connect(m_project, &QETProject::projectInformationsChanged,
+		this, &ProjectXmlCache::setProjectDirty);
+	connect(m_project, &QETProject::projectTitleChanged,
+		this, &ProjectXmlCache::setProjectDirty);
+	connect(m_project, &QETProject::projectModified,
+		this, &ProjectXmlCache::setProjectDirty);
+	connect(registry, &ElementRegistry::elementAdded,
+		this, &ProjectXmlCache::addElement);
+}
+
+/**
+	@brief ProjectXmlCache::generation
+	@return the current generation of the project,
+	the generation increase each time the project change.
+*/
+quint64 ProjectXmlCache::generation()
+{
+	if (const auto collection = m_project->embeddedElementCollection())
+	{
+		if (collection->revision() != m_collection_revision)
+		{
+			m_collection_revision = collection->revision();
+			setProjectDirty();
+		}
+	}
+	return m_generation;
+}
+
+/**
+	@brief ProjectXmlCache::snapshot
+	Take a snapshot of the project.
+	The XML of a folio is built only if the folio changed since
+	the last time its text was made, else the text is shared.
+	Must be called from the thread of the project.
+	@return the snapshot, to give to toString()
+*/
+ProjectXmlCache::Snapshot ProjectXmlCache::snapshot()
+{
+	Snapshot snapshot_;
+	snapshot_.m_project = m_project->toXml(false);
+
+	int order = 1;
+	for (const auto &diagram : m_project->diagrams())
+	{
+		if (!m_diagram_generations.contains(diagram)) {
+			track(diagram);
+		}
+
+		Snapshot::Folio folio;
+		folio.m_diagram = diagram;
+		folio.m_generation = m_diagram_generations.value(diagram);
+		folio.m_order = order;
+		{
+			QMutexLocker locker(&m_mutex);
+			const auto fragment = m_fragments.value(diagram);
+			if (fragment.m_generation == folio.m_generation) {
+				folio.m_text = fragment.m_text;
+			}
+		}
+
+		if (folio.m_text.isNull()) {
+			folio.m_xml = diagram->toXml();
+		}
+		snapshot_.m_folios << folio;
+		++order;
+	}
+
+	snapshot_.m_generation = generation();
+	return snapshot_;
+}
+
+/**
+	@brief ProjectXmlCache::write
+	Write snapshot to device, as QETProject::toXml().toString(4)
+	encoded in UTF-8 without BOM.
+	The folios which changed are converted to text concurrently,
+	their text is kept to be used by the next snapshots.
+	This function can be called from any thread.
+	@param snapshot : the snapshot to write, the XML of the snapshot is
+	modified, the same snapshot can't be written twice.
+	@param device : opened device where the project is written
+	@return true if the whole project was written
+*/
+bool ProjectXmlCache::write(Snapshot snapshot, QIODevice *device)
+{
+	QtConcurrent::blockingMap(snapshot.m_folios, [this](Snapshot::Folio &folio)
+	{
+		if (!folio.m_xml.isNull()) {
+			folio.m_text = folioText(folio);
+			folio.m_xml.clear();
+		}
+	});
+
+	auto root = snapshot.m_project.documentElement();
+	root.insertAfter(snapshot.m_project.createElement(folios_tag_name),
+			 root.firstChildElement(QStringLiteral("newdiagrams")));
+
+	const QByteArray text = snapshot.m_project.toString(4).toUtf8();
+	const QByteArray folios_line = QByteArray("    <")
+				       + folios_tag_name.toUtf8()
+				       + QByteArray("/>\n");
+	const int folios_pos = text.indexOf(folios_line);
+	if (folios_pos < 0) {
+		return false;
+	}
+
+	if (device->write(text.constData(), folios_pos) != folios_pos) {
+		return false;
+	}
+	for (const auto &folio : qAsConst(snapshot.m_folios)) {
+		if (device->write(folio.m_text) != folio.m_text.size()) {
+			return false;
+		}
+	}
+	const auto tail = text.mid(folios_pos + folios_line.size());
+	return device->write(tail) == tail.size();
+}
+
+/**
+	@brief ProjectXmlCache::setProjectDirty
+	Increase the generation, without changing the folios.
+*/
+void ProjectXmlCache::setProjectDirty()
+{
+	++m_generation;
+}
+
+/**
+	@brief ProjectXmlCache::addCommandDiagram
+	diagram gave the undo stack of the project to a command,
+	the next command done is associated with diagram.
+	@param diagram
+*/
+void ProjectXmlCache::addCommandDiagram(Diagram *diagram)
+{
+	m_pending_diagrams.insert(diagram);
+}
+
+/**
+	@brief ProjectXmlCache::undoStackIndexChanged
+	Something was done or undone in the project.
+	The folios associated with the commands done or undone are marked as
+	changed, every folio is marked as changed if a command isn't associated
+	with a folio.
+	@param index : the new index of the undo stack
+*/
+void ProjectXmlCache::undoStackIndexChanged(int index)
+{
+	setProjectDirty();
+	const auto stack = m_project->undoStack();
+
+		//The stack was cleared, nothing changed in the folios
+	if (stack->count() == 0)
+	{
+		m_pending_diagrams.clear();
+		m_command_diagrams.clear();
+		m_undo_index = 0;
+		return;
+	}
+
+		//The commands between the two indexes were done or undone,
+		//if the index didn't changed the last command was merged.
+	int first = qMin(index, m_undo_index);
+	int last = qMax(index, m_undo_index);
+	if (first == last) {
+		first = qMax(0, index - 1);
+	}
+	m_undo_index = index;
+
+		//A command can change the items of other folios than the folio
+		//which gave the stack, through property commands (e.g. the conductors
+		//of a potential). If an item isn't in a folio, the command stay
+		//not associated and every folio is marked as changed.
+	if (index > 0 && !m_pending_diagrams.isEmpty())
+	{
+		const auto command = stack->command(index - 1);
+		if (commandDiagrams(command, m_pending_diagrams)) {
+			m_command_diagrams[command].unite(m_pending_diagrams);
+		} else {
+			m_command_diagrams.remove(command);
+		}
+	}
+	m_pending_diagrams.clear();
+
+	bool all_dirty = false;
+	for (int i = first ; i < last ; ++i)
+	{
+		const auto command = stack->command(i);
+		if (!m_command_diagrams.contains(command)) {
+			all_dirty = true;
+			break;
+		}
+		for (const auto &diagram : m_command_diagrams.value(command)) {
+			if (m_diagram_generations.contains(diagram)) {
+				setDirty(diagram);
+			}
+		}
+	}
+	if (all_dirty) {
+		setAllDirty();
+	}
+
+		//Forget the commands deleted by the stack
+	if (m_command_diagrams.size() > stack->count())
+	{
+		QSet<const QUndoCommand *> commands;
+		for (int i = 0 ; i < stack->count() ; ++i) {
+			commands.insert(stack->command(i));
+		}
+		for (auto it = m_command_diagrams.begin() ; it != m_command_diagrams.end() ;)
+		{
+			if (commands.contains(it.key())) {
+				++it;
+			} else {
+				it = m_command_diagrams.erase(it);
+			}
+		}
+	}
+}
+
+/**
+	@brief ProjectXmlCache::commandDiagrams
+	Add to diagrams the folios of the objects changed by the
+	property commands of command and its children.
+	@param command
+	@param diagrams
+	@return false if an object of a property command isn't in a folio
+*/
+bool ProjectXmlCache::commandDiagrams(const QUndoCommand *command,
+				      QSet<Diagram *> &diagrams) const
+{
+	if (const auto property_command = dynamic_cast<const QPropertyUndoCommand *>(command))
+	{
+		const auto object = property_command->object();
+		auto diagram = qobject_cast<Diagram *>(object);
+		if (!diagram)
+		{
+			const auto graphics_object = qobject_cast<QGraphicsObject *>(object);
+			if (graphics_object) {
+				diagram = qobject_cast<Diagram *>(graphics_object->scene());
+			}
+		}
+		if (!diagram) {
+			return false;
+		}
+		diagrams.insert(diagram);
+	}
+
+	for (int i = 0 ; i < command->childCount() ; ++i) {
+		if (!commandDiagrams(command->child(i), diagrams)) {
+			return false;
+		}
+	}
+	return true;
+}
+
+/**
+	@brief ProjectXmlCache::addDiagram
+	@param project
+	@param diagram
+*/
+void ProjectXmlCache::addDiagram(QETProject *project, Diagram *diagram)
+{
+	Q_UNUSED(project)
+	track(diagram);
+		//The order of the folios changed
+	setAllDirty();
+}
+
+/**
+	@brief ProjectXmlCache::removeDiagram
+	@param project
+	@param diagram
+*/
+void ProjectXmlCache::removeDiagram(QETProject *project, Diagram *diagram)
+{
+	Q_UNUSED(project)
+	m_diagram_generations.remove(diagram);
+	m_pending_diagrams.remove(diagram);
+	for (auto &diagrams : m_command_diagrams) {
+		diagrams.remove(diagram);
+	}
+	{
+		QMutexLocker locker(&m_mutex);
+		m_fragments.remove(diagram);
+	}
+	setAllDirty();
+}
+
+/**
+	@brief ProjectXmlCache::addElement
+	Follow the information and the links of element,
+	the information can change without any visual change,
+	and a link made from an element of another folio change the links
+	saved by element without any command done in its folio.
+	@param element
+*/
+void ProjectXmlCache::addElement(Element *element)
+{
+	connect(element, &Element::elementInfoChange,
+		this, &ProjectXmlCache::elementChanged,
+		Qt::UniqueConnection);
+	connect(element, &Element::linkedElementChanged,
+		this, &ProjectXmlCache::elementChanged,
+		Qt::UniqueConnection);
+}
+
+/**
+	@brief ProjectXmlCache::elementChanged
+	The information or the links of an element changed,
+	mark its folio as changed.
+*/
+void ProjectXmlCache::elementChanged()
+{
+	const auto element = qobject_cast<Element *>(sender());
+	if (element && element->diagram()) {
+		setDirty(element->diagram());
+	}
+}
+
+/**
+	@brief ProjectXmlCache::track
+	Start to follow the changes of diagram
+	@param diagram
+*/
+void ProjectXmlCache::track(Diagram *diagram)
+{
+	if (m_diagram_generations.contains(diagram)) {
+		return;
+	}
+
+	connect(diagram, &Diagram::diagramInformationChanged,
+		this, [this, diagram]() { setDirty(diagram); });
+	connect(diagram, &Diagram::diagramTitleChanged,
+		this, [this, diagram]() { setDirty(diagram); });
+	connect(diagram, &Diagram::usedTitleBlockTemplateChanged,
+		this, [this, diagram]() { setDirty(diagram); });
+	connect(diagram, &Diagram::diagramPropertiesChanged,
+		this, [this, diagram]() { setDirty(diagram); });
+	setDirty(diagram);
+}
+
+/**
+	@brief ProjectXmlCache::setDirty
+	Mark diagram as changed
+	@param diagram
+*/
+void ProjectXmlCache::setDirty(Diagram *diagram)
+{
+	m_diagram_generations.insert(diagram, ++m_generation);
+}
+
+/**
+	@brief ProjectXmlCache::setAllDirty
+	Mark each folio as changed
+*/
+void ProjectXmlCache::setAllDirty()
+{
+	for (const auto &diagram : m_project->diagrams()) {
+		if (m_diagram_generations.contains(diagram)) {
+			setDirty(diagram);
+		}
+	}
+	setProjectDirty();
+}
+
+/**
+	@brief ProjectXmlCache::folioText
+	@param folio
+	@return the text of folio in UTF-8, indented as a child of the project.
+	The text is kept for the next snapshots.
+*/
+QByteArray ProjectXmlCache::folioText(const Snapshot::Folio &folio)
+{
+	if (folio.m_xml.isNull()) {
+		return folio.m_text;
+	}
+
+		//Convert the folio as a child of a project
+		//to get the same indentation as in the whole project.
+	QDomDocument document;
+	auto root = document.createElement(QStringLiteral("project"));
+	document.appendChild(root);
+	root.appendChild(document.importNode(folio.m_xml.documentElement(), true))
+			.toElement().setAttribute(QStringLiteral("order"), folio.m_order);
+
+	const QByteArray open_tag("<project>\n");
+	const QByteArray close_tag("</project>\n");
+	QByteArray text = document.toString(4).toUtf8();
+	if (text.startsWith(open_tag) && text.endsWith(close_tag)) {
+		text = text.mid(open_tag.size(),
+				text.size() - open_tag.size() - close_tag.size());
+	}
+
+	QMutexLocker locker(&m_mutex);
+	auto &fragment = m_fragments[folio.m_diagram];
+	if (fragment.m_generation < folio.m_generation)
+	{
+		fragment.m_generation = folio.m_generation;
+		fragment.m_text = text;
+	}
+	return text;
+}
@@ -0,0 +1,137 @@
+/*
+	Copyright 2006-2025 The QElectroTech Team
+	This file is part of QElectroTech.
+
+	QElectroTech is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 2 of the License, or
+	(at your option) any later version.
+
+	QElectroTech is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with QElectroTech.  If not, see <http://www.gnu.org/licenses/>.
+*/
+#ifndef PROJECTXMLCACHE_H
+#define PROJECTXMLCACHE_H
+
+#include <QByteArray>
+#include <QDomDocument>
+#include <QHash>
+#include <QList>
+#include <QMutex>
+#include <QObject>
+#include <QSet>
+
+class Diagram;
+class Element;
+class ElementRegistry;
+class QETProject;
+class QIODevice;
+class QUndoCommand;
+
+/**
+	@brief The ProjectXmlCache class
+	Keep the XML text (UTF-8) of each folio of a project, the text of a folio
+	is built again only when the folio changed.
+	A change is detected through the information and properties signals
+	of the diagram, the information and links signals of its elements,
+	and through the undo stack of the project:
+	each command pushed in the stack is associated with the folios which
+	gave the stack to the command (see Diagram::undoStack()), those folios
+	are marked as changed each time the command is done or undone, with
+	the folios of the items changed by its property commands.
+	A command pushed directly in the stack of the project, or with a
+	property command on an item outside a folio, mark every folio
+	as changed.
+	The backups of the project are written from the same cache.
+	Each change increase the generation of the cache, a user of the cache
+	can compare the generation with the one of its last use to know if the
+	project changed in the meantime.
+
+	snapshot() must be called from the thread of the project,
+	it only build the XML of the changed folios and share the text of the
+	other folios. write() do the expensive part of the work (conversion
+	of the XML to text) and can be called from any thread, the written
+	document is the same as QETProject::toXml().toString(4) encoded in UTF-8.
+*/
+class ProjectXmlCache : public QObject
+{
+		Q_OBJECT
+
+	public:
+		/**
+			@brief The Snapshot struct
+			Content of a project at a given generation
+		*/
+		struct Snapshot
+		{
+			struct Folio
+			{
+					//Only used as key, never dereferenced
+				Diagram *m_diagram = nullptr;
+				quint64 m_generation = 0;
+				int m_order = 0;
+					//Text of the folio if it didn't changed, else m_xml is used
+				QByteArray m_text;
+				QDomDocument m_xml;
+			};
+
+				//The project without the folios
+			QDomDocument m_project;
+			QList<Folio> m_folios;
+			quint64 m_generation = 0;
+		};
+
+		ProjectXmlCache(QETProject *project,
+				ElementRegistry *registry,
+				QObject *parent = nullptr);
+
+		quint64 generation();
+		Snapshot snapshot();
+		bool write(Snapshot snapshot, QIODevice *device);
+		void addCommandDiagram(Diagram *diagram);
+
+	public slots:
+		void setProjectDirty();
+		void undoStackIndexChanged(int index);
+
+	private slots:
+		void addDiagram(QETProject *project, Diagram *diagram);
+		void removeDiagram(QETProject *project, Diagram *diagram);
+		void addElement(Element *element);
+		void elementChanged();
+
+	private:
+		void track(Diagram *diagram);
+		bool commandDiagrams(const QUndoCommand *command,
+				     QSet<Diagram *> &diagrams) const;
+		void setDirty(Diagram *diagram);
+		void setAllDirty();
+		QByteArray folioText(const Snapshot::Folio &folio);
+
+		QETProject *m_project = nullptr;
+		quint64 m_generation = 0;
+		quint64 m_collection_revision = 0;
+		QHash<Diagram *, quint64> m_diagram_generations;
+			//Folios which asked the undo stack since the last change of index,
+			//they are associated to the next command done.
+		QSet<Diagram *> m_pending_diagrams;
+			//Only used as key, never dereferenced
+		QHash<const QUndoCommand *, QSet<Diagram *>> m_command_diagrams;
+		int m_undo_index = 0;
+
+		struct Fragment
+		{
+			quint64 m_generation = 0;
+			QByteArray m_text;
+		};
+			//Accessed from several threads, protected by m_mutex
+		QHash<Diagram *, Fragment> m_fragments;
+		QMutex m_mutex;
+};
+
+#endif // PROJECTXMLCACHE_H
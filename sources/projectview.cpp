@@ -95,6 +95,8 @@ void ProjectView::setProject(QETProject *project)
 
 /**
 	@return la liste des schemas ouverts dans le projet
+	Note : the view of a folio is created when its tab is displayed
+	for the first time, the folios never displayed have no view.
 */
 QList<DiagramView *> ProjectView::diagram_views() const
 {
@@ -135,7 +137,7 @@ void ProjectView::changeTabDown()
 	DiagramView *nextDiagramView = this->nextDiagram();
 	if (nextDiagramView!=nullptr){
 		rebuildDiagramsMap();
-		m_tab -> setCurrentWidget(nextDiagramView);
+		m_tab -> setCurrentWidget(nextDiagramView -> parentWidget());
 	}
 }
 
@@ -146,8 +148,8 @@ DiagramView *ProjectView::nextDiagram()
 {
 	int current_tab_index = m_tab -> currentIndex();
 	int next_tab_index = current_tab_index + 1;	//get next tab index
-	if (next_tab_index<m_diagram_ids.count()) //if next tab index >= greatest tab the last tab is activated so no need to change tab.
-		return(m_diagram_ids[next_tab_index]);
+	if (next_tab_index<m_tab->count()) //if next tab index >= greatest tab the last tab is activated so no need to change tab.
+		return(diagramViewAt(next_tab_index));
 	else
 		return nullptr;
 }
@@ -160,7 +162,7 @@ void ProjectView::changeTabUp()
 	DiagramView *previousDiagramView = this->previousDiagram();
 	if (previousDiagramView!=nullptr){
 		rebuildDiagramsMap();
-		m_tab -> setCurrentWidget(previousDiagramView);
+		m_tab -> setCurrentWidget(previousDiagramView -> parentWidget());
 	}
 }
 
@@ -172,7 +174,7 @@ DiagramView *ProjectView::previousDiagram()
 	int current_tab_index = m_tab -> currentIndex();
 	int previous_tab_index = current_tab_index - 1;	//get previous tab index
 	if (previous_tab_index>=0) //if previous tab index = 0 then the first tab is activated so no need to change tab.
-		return(m_diagram_ids[previous_tab_index]);
+		return(diagramViewAt(previous_tab_index));
 	else
 		return nullptr;
 }
@@ -182,8 +184,9 @@ DiagramView *ProjectView::previousDiagram()
 */
 void ProjectView::changeLastTab()
 {
-	DiagramView *lastDiagramView = this->lastDiagram();
-	m_tab->setCurrentWidget(lastDiagramView);
+	if (m_tab->count()) {
+		m_tab->setCurrentIndex(m_tab->count() - 1);
+	}
 }
 
 /**
@@ -191,7 +194,7 @@ void ProjectView::changeLastTab()
 */
 DiagramView *ProjectView::lastDiagram()
 {
-	return(m_diagram_ids.last());
+	return(diagramViewAt(m_tab->count() - 1));
 }
 
 /**
@@ -199,8 +202,9 @@ DiagramView *ProjectView::lastDiagram()
 */
 void ProjectView::changeFirstTab()
 {
-	DiagramView *firstDiagramView = this->firstDiagram();
-	m_tab->setCurrentWidget(firstDiagramView);
+	if (m_tab->count()) {
+		m_tab->setCurrentIndex(0);
+	}
 }
 
 /**
@@ -208,7 +212,7 @@ void ProjectView::changeFirstTab()
 */
 DiagramView *ProjectView::firstDiagram()
 {
-	return(m_diagram_ids.first());
+	return(diagramViewAt(0));
 }
 
 
@@ -392,12 +396,14 @@ void ProjectView::removeDiagram(DiagramView *diagram_view)
 
 	//Remove the diagram view of the tabs widget
 	int index_to_remove = m_diagram_ids.key(diagram_view);
+	QWidget *page = m_tab->widget(index_to_remove);
 	m_tab->removeTab(index_to_remove);
+	m_tab_diagrams.remove(page);
 	m_diagram_view_list.removeAll(diagram_view);
 	rebuildDiagramsMap();
 
 	m_project -> removeDiagram(diagram_view -> diagram());
-	delete diagram_view;
+	delete page;
 
 	emit(diagramRemoved(diagram_view));
 	updateAllTabsTitle();
@@ -422,7 +428,7 @@ void ProjectView::removeDiagram(Diagram *diagram) {
 */
 void ProjectView::showDiagram(DiagramView *diagram) {
 	if (!diagram) return;
-	m_tab -> setCurrentWidget(diagram);
+	m_tab -> setCurrentWidget(diagram -> parentWidget());
 }
 
 /**
@@ -431,8 +437,9 @@ void ProjectView::showDiagram(DiagramView *diagram) {
 */
 void ProjectView::showDiagram(Diagram *diagram) {
 	if (!diagram) return;
-	if (DiagramView *diagram_view = findDiagram(diagram)) {
-		m_tab -> setCurrentWidget(diagram_view);
+	int tab_id = tabIndex(diagram);
+	if (tab_id != -1) {
+		m_tab -> setCurrentIndex(tab_id);
 	}
 }
 
@@ -717,10 +724,10 @@ void ProjectView::initActions()
 	connect(m_add_new_diagram, &QAction::triggered, [this](){this->m_project->addNewDiagram();});
 	
 	m_first_view = new QAction(QET::Icons::ArrowLeftDouble, tr("Revenir au debut du projet"),this);
-	connect(m_first_view, &QAction::triggered, [this](){this->m_tab->setCurrentWidget(firstDiagram());});
+	connect(m_first_view, &QAction::triggered, [this](){this->changeFirstTab();});
 	
 	m_end_view = new QAction(QET::Icons::ArrowRightDouble, tr("Aller à la fin du projet"),this);
-	connect(m_end_view, &QAction::triggered, [this](){this->m_tab->setCurrentWidget(lastDiagram());});
+	connect(m_end_view, &QAction::triggered, [this](){this->changeLastTab();});
 }
 
 /**
@@ -804,8 +811,9 @@ void ProjectView::initLayout()
 /**
 	@brief ProjectView::loadDiagrams
 	Load diagrams of project.
-	We create a diagram view for each diagram,
-	and add it to the project view.
+	We create a tab for each diagram, the diagram view
+	is created when the tab is displayed for the first time
+	(see diagramViewAt).
 */
 void ProjectView::loadDiagrams()
 {
@@ -822,6 +830,8 @@ void ProjectView::loadDiagrams()
 												"</p>"));
 	}
 
+		//The current tab is managed at the end
+	m_loading = true;
 	for(auto diagram : m_project->diagrams())
 	{
 		if(dialog)
@@ -829,24 +839,106 @@ void ProjectView::loadDiagrams()
 			dialog->setDetail(diagram->title());
 			dialog->setProgressBar(dialog->progressBarValue()+1);
 		}
+		addDiagramTab(diagram);
+	}
+	m_loading = false;
 
-		auto dv = new DiagramView(diagram);
-		dv->setFrameStyle(QFrame::Plain | QFrame::NoFrame);
+	rebuildDiagramsMap();
+	updateAllTabsTitle();
 
-		auto index = m_project->folioIndex(diagram);
-		m_tab->insertTab(index, dv, QET::Icons::Diagram, dv->title());
-		m_diagram_view_list.insert(index, dv);
+	if (m_tab->count())
+	{
+		m_tab->setCurrentIndex(0);
+		tabChanged(0);
+	}
+}
 
-		connect(dv, &DiagramView::showDiagram,         this, QOverload<Diagram*>::of(&ProjectView::showDiagram));
-		connect(dv, &DiagramView::titleChanged,        this, &ProjectView::updateTabTitle);
-		connect(dv, &DiagramView::findElementRequired, this, &ProjectView::findElementRequired);
-		connect(&dv->diagram()->border_and_titleblock , &BorderTitleBlock::titleBlockFolioChanged, [this, dv]() {this->updateTabTitle(dv);});
+/**
+	@brief ProjectView::addDiagramTab
+	Add the tab of diagram at the index of diagram in the project.
+	The tab contain an empty page, the diagram view
+	is added to the page by diagramViewAt.
+	@param diagram
+	@return the page of the tab
+*/
+QWidget *ProjectView::addDiagramTab(Diagram *diagram)
+{
+	auto page = new QWidget();
+	auto page_layout = new QVBoxLayout(page);
+	page_layout->setContentsMargins(0, 0, 0, 0);
+	page_layout->setSpacing(0);
+	m_tab_diagrams.insert(page, diagram);
+
+	m_tab->insertTab(m_project->folioIndex(diagram),
+			 page,
+			 QET::Icons::Diagram,
+			 diagram->title());
+
+	connect(&diagram->border_and_titleblock, &BorderTitleBlock::titleBlockFolioChanged,
+		this, [this, diagram]() {this->updateTabTitle(this->tabIndex(diagram));});
+	return page;
+}
+
+/**
+	@brief ProjectView::diagramViewAt
+	@param tab_id : index of a tab
+	@return the diagram view displayed by the tab tab_id, or nullptr if
+	tab_id is not a valid index. The view is created if it does not exist,
+	the content of the diagram is then loaded if it is not already done
+	(see QETProject::materializeDiagram).
+*/
+DiagramView *ProjectView::diagramViewAt(int tab_id)
+{
+	QWidget *page = m_tab->widget(tab_id);
+	Diagram *diagram = m_tab_diagrams.value(page);
+	if (!diagram) {
+		return(nullptr);
 	}
+	if (auto dv = page->findChild<DiagramView *>(QString(), Qt::FindDirectChildrenOnly)) {
+		return(dv);
+	}
+
+		//The content of a lazily loaded folio is built before its view
+	m_project->materializeDiagram(diagram);
 
+	auto dv = new DiagramView(diagram);
+	dv->setFrameStyle(QFrame::Plain | QFrame::NoFrame);
+	page->layout()->addWidget(dv);
+	m_diagram_view_list << dv;
 	rebuildDiagramsMap();
-	updateAllTabsTitle();
 
-	m_tab->setCurrentWidget(firstDiagram());
+	connect(dv, &DiagramView::showDiagram,         this, QOverload<Diagram*>::of(&ProjectView::showDiagram));
+	connect(dv, &DiagramView::titleChanged,        this, QOverload<DiagramView*>::of(&ProjectView::updateTabTitle));
+	connect(dv, &DiagramView::findElementRequired, this, &ProjectView::findElementRequired);
+
+	emit(diagramViewCreated(dv));
+	return(dv);
+}
+
+/**
+	@brief ProjectView::diagramAt
+	@param tab_id : index of a tab
+	@return the diagram displayed by the tab tab_id,
+	even if its view is not yet created, or nullptr.
+*/
+Diagram *ProjectView::diagramAt(int tab_id) const
+{
+	return(m_tab_diagrams.value(m_tab->widget(tab_id)));
+}
+
+/**
+	@brief ProjectView::tabIndex
+	@param diagram
+	@return the index of the tab of diagram, or -1
+*/
+int ProjectView::tabIndex(Diagram *diagram) const
+{
+	for (int i = 0 ; i < m_tab->count() ; ++i) {
+		if (diagramAt(i) == diagram) {
+			return(i);
+		}
+	}
+	return(-1);
 }
 
 /**
@@ -888,21 +980,14 @@ void ProjectView::adjustReadOnlyState()
 */
 void ProjectView::diagramAdded(Diagram *diagram)
 {
-	auto dv = new DiagramView(diagram);
-	auto index = m_project->folioIndex(diagram);
-	m_tab->insertTab(index, dv, QET::Icons::Diagram, dv->title());
-	dv->setFrameStyle(QFrame::Plain | QFrame::NoFrame);
-
-	m_diagram_view_list.insert(index, dv);
+	m_loading = true;
+	int tab_id = m_tab->indexOf(addDiagramTab(diagram));
+	m_loading = false;
 
 	rebuildDiagramsMap();
+	DiagramView *dv = diagramViewAt(tab_id);
 	updateAllTabsTitle();
 
-	connect(dv, &DiagramView::showDiagram,         this, QOverload<Diagram*>::of(&ProjectView::showDiagram));
-	connect(dv, &DiagramView::titleChanged,        this, &ProjectView::updateTabTitle);
-	connect(dv, &DiagramView::findElementRequired, this, &ProjectView::findElementRequired);
-	connect(&dv->diagram()->border_and_titleblock , &BorderTitleBlock::titleBlockFolioChanged, [this, dv]() {this->updateTabTitle(dv);});
-
 		// signal diagram view was added
 	emit(diagramAdded(dv));
 	m_project->setModified(true);
@@ -916,13 +1001,23 @@ void ProjectView::diagramAdded(Diagram *diagram)
 */
 void ProjectView::updateTabTitle(DiagramView *diagram_view)
 {
-	int diagram_tab_id = m_diagram_ids.key(diagram_view, -1);
+	updateTabTitle(m_diagram_ids.key(diagram_view, -1));
+}
+
+/**
+	@brief ProjectView::updateTabTitle
+	Update the title of the tab diagram_tab_id,
+	the view of the diagram of the tab can be not yet created.
+	@param diagram_tab_id : index of the tab
+*/
+void ProjectView::updateTabTitle(int diagram_tab_id)
+{
+	Diagram *diagram = diagramAt(diagram_tab_id);
 	
-	if (diagram_tab_id != -1)
+	if (diagram)
 	{
 		QSettings settings;
 		QString title;
-		Diagram *diagram = diagram_view->diagram();
 		
 		if (settings.value("genericpanel/folio", false).toBool())
 		{
@@ -948,8 +1043,8 @@ void ProjectView::updateTabTitle(DiagramView *diagram_view)
 */
 void ProjectView::updateAllTabsTitle()
 {
-	for (DiagramView *dv : m_diagram_ids.values())
-		updateTabTitle(dv);
+	for (int i = 0 ; i < m_tab->count() ; ++i)
+		updateTabTitle(i);
 }
 
 /**
@@ -967,8 +1062,7 @@ void ProjectView::tabMoved(int from, int to)
 		//Rebuild the title of each diagram in range from - to
 	for (int i= qMin(from,to) ; i< qMax(from,to)+1 ; ++i)
 	{
-		DiagramView *dv = m_diagram_ids.value(i);
-		updateTabTitle(dv);
+		updateTabTitle(i);
 	}
 }
 
@@ -983,7 +1077,8 @@ DiagramView *ProjectView::findDiagram(Diagram *diagram) {
 			return(diagram_view);
 		}
 	}
-	return(nullptr);
+		//The view of the diagram is not yet created
+	return(diagramViewAt(tabIndex(diagram)));
 }
 
 /**
@@ -995,7 +1090,7 @@ void ProjectView::rebuildDiagramsMap()
 	m_diagram_ids.clear();
 
 	foreach(DiagramView *diagram_view, m_diagram_view_list) {
-		int dv_idx = m_tab -> indexOf(diagram_view);
+		int dv_idx = m_tab -> indexOf(diagram_view -> parentWidget());
 		if (dv_idx == -1) continue;
 		m_diagram_ids.insert(dv_idx, diagram_view);
 	}
@@ -1014,15 +1109,24 @@ void ProjectView::tabChanged(int tab_id)
 		setDisplayFallbackWidget(true);
 	else if(m_tab->count() == 1)
 		setDisplayFallbackWidget(false);
+
+		//The tabs are not complete while they are added
+	if (m_loading)
+		return;
 	
-	emit(diagramActivated(m_diagram_ids[tab_id]));
+		//The view of a folio, and its content if the folio
+		//is lazily loaded, is built at the first display
+	DiagramView *diagram_view = diagramViewAt(tab_id);
+
+	emit(diagramActivated(diagram_view));
 	
-	if (m_diagram_ids[tab_id] != nullptr)
-		m_diagram_ids[tab_id]->diagram()->diagramActivated();
+	if (diagram_view != nullptr)
+		diagram_view->diagram()->diagramActivated();
 
 		//Clear the event interface of the previous diagram
-	if (DiagramView *dv = m_diagram_ids[m_previous_tab_index])
-		dv->diagram()->clearEventInterface();
+	DiagramView *previous_view = m_diagram_ids.value(m_previous_tab_index);
+	if (previous_view && previous_view != diagram_view)
+		previous_view->diagram()->clearEventInterface();
 	m_previous_tab_index = tab_id;
 }
 
@@ -1032,7 +1136,7 @@ void ProjectView::tabChanged(int tab_id)
 */
 void ProjectView::tabDoubleClicked(int tab_id) {
 	// repere le schema concerne
-	DiagramView *diagram_view = m_diagram_ids[tab_id];
+	DiagramView *diagram_view = diagramViewAt(tab_id);
 	if (!diagram_view) return;
 
 	diagram_view -> editDiagramProperties();
@@ -136,6 +136,7 @@ class ProjectView : public QWidget
 		void diagramAdded(DiagramView *);
 		void diagramRemoved(DiagramView *);
 		void diagramActivated(DiagramView *);
+		void diagramViewCreated(DiagramView *);
 		void projectClosed(ProjectView *);
 		void errorEncountered(const QString &);
 			// relayed signals
@@ -146,6 +147,11 @@ class ProjectView : public QWidget
 		void initWidgets();
 		void initLayout();
 		void loadDiagrams();
+		QWidget *addDiagramTab(Diagram *diagram);
+		DiagramView *diagramViewAt(int tab_id);
+		Diagram *diagramAt(int tab_id) const;
+		int tabIndex(Diagram *diagram) const;
+		void updateTabTitle(int diagram_tab_id);
 		DiagramView *findDiagram(Diagram *);
 		DiagramView *nextDiagram();
 		DiagramView *previousDiagram();
@@ -184,6 +190,10 @@ class ProjectView : public QWidget
 		QMap<int, DiagramView *> m_diagram_ids;
 		int m_previous_tab_index = -1;
 		QList<DiagramView *> m_diagram_view_list;
+			/// Diagram displayed by the page of each tab
+		QHash<QWidget *, Diagram *> m_tab_diagrams;
+			/// True while tabs are added, see tabChanged
+		bool m_loading = false;
 };
 
 
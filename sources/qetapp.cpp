@@ -17,6 +17,7 @@
 */
 #include "qetapp.h"
 
+#include "batchexporter.h"
 #include "configdialog.h"
 #include "ui/configpage/configpages.h"
 #include "editor/ui/qetelementeditor.h"
@@ -38,6 +39,7 @@
 #include "machine_info.h"
 #include "TerminalStrip/ui/terminalstripeditorwindow.h"
 #include "qetversion.h"
+#include "utils/qetsettings.h"
 
 #include <cstdlib>
 #include <iostream>
@@ -100,6 +102,7 @@ QString system_language = QString();
 	@brief QETApp::QETApp
 */
 QETApp::QETApp() :
+	m_qsti(nullptr),
 	m_splash_screen(nullptr),
 	non_interactive_execution_(false)
 {
@@ -110,6 +113,12 @@ QETApp::QETApp() :
 	}
 	initConfiguration();
 	initLanguage();
+	if (qet_arguments_.exportRequested()) {
+			//Nothing else is initialized, the caller must
+			//quit with exportResult() after the construction.
+		m_export_result = BatchExporter(qet_arguments_).exec();
+		return;
+	}
 	QET::Icons::initIcons();
 	initStyle();
 	initSplashScreen();
@@ -129,6 +138,9 @@ QETApp::QETApp() :
 
 		collections_cache_ = new ElementsCollectionCache(cache_path, this);
 		collections_cache_->setLocale(langFromSetting());
+			//Drop the cached elements removed since the last start,
+			//only the file informations are read.
+		collections_cache_->validateAll();
 	}
 
 	if (qet_arguments_.files().isEmpty())
@@ -156,8 +168,10 @@ QETApp::QETApp() :
 */
 QETApp::~QETApp()
 {
-	m_elements_recent_files->save();
-	m_projects_recent_files->save();
+	if (m_elements_recent_files)
+		m_elements_recent_files->save();
+	if (m_projects_recent_files)
+		m_projects_recent_files->save();
 
 	delete m_splash_screen;
 	delete m_elements_recent_files;
@@ -178,6 +192,17 @@ QETApp::~QETApp()
 }
 
 
+/**
+	@brief QETApp::exportResult
+	@return the exit code of the command line export
+	(EXIT_SUCCESS or EXIT_FAILURE), only meaningful when
+	the export was asked on the command line.
+*/
+int QETApp::exportResult() const
+{
+	return m_export_result;
+}
+
 /**
 	@brief QETApp::instance
 	\~ @return the instance of the QETApp
@@ -1240,20 +1265,13 @@ bool QETApp::closeEveryEditor()
 */
 QFont QETApp::diagramTextsFont(qreal size)
 {
-	QSettings settings;
-
-	//Font to use
-	QString diagram_texts_family = settings.value("diagramfont",
-							  "Sans Serif").toString();
-	qreal diagram_texts_size     = settings.value("diagramsize",
-							  9.0).toDouble();
+		//Font to use, read once in the settings snapshot
+	QFont diagram_texts_font = QetSettings::diagramTextsFont();
 
 	if (size != -1.0) {
-		diagram_texts_size = size;
+		diagram_texts_font.setPointSizeF(size);
 	}
-	QFont diagram_texts_font = QFont(diagram_texts_family);
-	diagram_texts_font.setPointSizeF(diagram_texts_size);
-	if (diagram_texts_size <= 4.0) {
+	if (diagram_texts_font.pointSizeF() <= 4.0) {
 		diagram_texts_font.setWeight(QFont::Light);
 	}
 	return(diagram_texts_font);
@@ -1266,27 +1284,13 @@ QFont QETApp::diagramTextsFont(qreal size)
 */
 QFont QETApp::diagramTextsItemFont(qreal size)
 {
-	QSettings settings;
-
-	//Font to use
-	QString diagram_texts_item_family = settings.value("diagramitemfont",
-							   "Sans Serif").toString();
-	qreal diagram_texts_item_size     = settings.value("diagramitemsize",
-							   9.0).toDouble();
-	auto diagram_texts_item_weight =
-			static_cast<QFont::Weight>(
-				settings.value("diagramitemweight", QFont::Normal).toInt());
-	QString diagram_texts_item_style  = settings.value("diagramitemstyle",
-							   "normal").toString();
+		//Font to use, read once in the settings snapshot
+	QFont diagram_texts_item_font = QetSettings::diagramTextsItemFont();
 
 	if (size != -1.0) {
-		diagram_texts_item_size = size;
+		diagram_texts_item_font.setPointSizeF(size);
 	}
-	QFont diagram_texts_item_font = QFont(diagram_texts_item_family);
-	diagram_texts_item_font.setPointSizeF(diagram_texts_item_size);
-	diagram_texts_item_font.setWeight(diagram_texts_item_weight);
-	diagram_texts_item_font.setStyleName(diagram_texts_item_style);
-	if (diagram_texts_item_size <= 4.0) {
+	if (diagram_texts_item_font.pointSizeF() <= 4.0) {
 		diagram_texts_item_font.setWeight(QFont::Light);
 	}
 	return(diagram_texts_item_font);
@@ -1299,14 +1303,7 @@ QFont QETApp::diagramTextsItemFont(qreal size)
 */
  QFont QETApp::dynamicTextsItemFont(qreal size)
 {
-	QSettings settings;
-	//Font to use
-	QFont font_ = diagramTextsItemFont();
-	if (settings.contains("diagrameditor/dynamic_text_font")) {
-		font_.fromString(settings.value(
-					 "diagrameditor/dynamic_text_font"
-						).toString());
-	}
+	QFont font_ = QetSettings::dynamicTextsItemFont();
 	if (size > 0) {
 		font_.setPointSizeF(size);
 	}
@@ -1323,14 +1320,7 @@ QFont QETApp::diagramTextsItemFont(qreal size)
 */
 QFont QETApp::indiTextsItemFont(qreal size)
 {
-	QSettings settings;
-	//Font to use
-	QFont font_ = diagramTextsItemFont();
-	if (settings.contains("diagrameditor/independent_text_font")) {
-		font_.fromString(settings.value(
-					 "diagrameditor/independent_text_font"
-					 ).toString());
-	}
+	QFont font_ = QetSettings::independentTextsItemFont();
 	if (size > 0) {
 		font_.setPointSizeF(size);
 	}
@@ -2540,6 +2530,11 @@ void QETApp::printHelp()
 		+ tr("  --data-dir=DIR                Definir le dossier de data\n")
 #endif
 		+ tr("  --lang-dir=DIR                Definir le dossier contenant les fichiers de langue\n")
+		+ tr("  --export=FORMAT               Exporter les folios des projets sans interface graphique\n"
+		"                                (PDF, SVG, PNG, JPG, BMP ou DXF) puis quitter\n"
+		"  --export-dir=DIR              Definir le dossier des fichiers exportes\n"
+		"  --export-folios=LISTE         Definir les folios a exporter, par exemple 1,3-5\n"
+		"  --export-scale=FACTEUR        Definir l'echelle des folios exportes\n")
 	);
 	std::cout << qPrintable(help) << std::endl;
 }
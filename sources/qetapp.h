@@ -72,6 +72,7 @@ class QETApp : public QObject
 		static void printHelp();
 		static void printVersion();
 		static void printLicense();
+		int exportResult() const;
 		
 		static ElementsCollectionCache *collectionCache();
 		
@@ -219,6 +220,8 @@ class QETApp : public QObject
 			without any user interaction
 		 */
 		bool non_interactive_execution_;
+			///Exit code of the command line export, see exportResult()
+		int m_export_result = EXIT_SUCCESS;
 		QPalette initial_palette_;   ///< System color palette
 		
 		static TitleBlockTemplatesFilesCollection *m_common_tbt_collection;
@@ -24,6 +24,7 @@
 */
 QETArguments::QETArguments(QObject *parent) :
 	QObject(parent),
+	export_scale_(1.0),
 	print_help_(false),
 	print_license_(false),
 	print_version_(false)
@@ -37,6 +38,7 @@ QETArguments::QETArguments(QObject *parent) :
 */
 QETArguments::QETArguments(const QList<QString> &args, QObject *parent) :
 	QObject(parent),
+	export_scale_(1.0),
 	print_help_(false),
 	print_license_(false),
 	print_version_(false)
@@ -68,6 +70,10 @@ common_tbt_dir_(qet_arguments.common_tbt_dir_),
 	data_dir_(qet_arguments.data_dir_),
 #endif
 	lang_dir_(qet_arguments.lang_dir_),
+	export_format_(qet_arguments.export_format_),
+	export_dir_(qet_arguments.export_dir_),
+	export_folios_(qet_arguments.export_folios_),
+	export_scale_(qet_arguments.export_scale_),
 	print_help_(qet_arguments.print_help_),
 	print_license_(qet_arguments.print_license_),
 	print_version_(qet_arguments.print_version_)
@@ -97,6 +103,10 @@ QETArguments &QETArguments::operator=(const QETArguments &qet_arguments) {
 	data_dir_ = qet_arguments.data_dir_;
 #endif
 	lang_dir_        = qet_arguments.lang_dir_;
+	export_format_   = qet_arguments.export_format_;
+	export_dir_      = qet_arguments.export_dir_;
+	export_folios_   = qet_arguments.export_folios_;
+	export_scale_    = qet_arguments.export_scale_;
 	print_help_      = qet_arguments.print_help_;
 	print_license_   = qet_arguments.print_license_;
 	print_version_   = qet_arguments.print_version_;
@@ -199,6 +209,10 @@ void QETArguments::clear()
 #ifdef QET_ALLOW_OVERRIDE_DD_OPTION
 	data_dir_.clear();
 #endif
+	export_format_.clear();
+	export_dir_.clear();
+	export_folios_.clear();
+	export_scale_ = 1.0;
 }
 
 /**
@@ -250,6 +264,10 @@ void QETArguments::handleFileArgument(const QString &file) {
 	  * --config-dir=
 	  * --data-dir=
 	  * --lang-dir=
+	  * --export=
+	  * --export-dir=
+	  * --export-folios=
+	  * --export-scale=
 	  * --help
 	  * --version
 	  * -v
@@ -304,6 +322,35 @@ void QETArguments::handleOptionArgument(const QString &option) {
 		lang_dir_ = option.mid(ld_arg.length());
 		return;
 	}
+
+	QString ed_arg("--export-dir=");
+	if (option.startsWith(ed_arg)) {
+		export_dir_ = option.mid(ed_arg.length());
+		return;
+	}
+
+	QString ef_arg("--export-folios=");
+	if (option.startsWith(ef_arg)) {
+		export_folios_ = option.mid(ef_arg.length());
+		return;
+	}
+
+	QString es_arg("--export-scale=");
+	if (option.startsWith(es_arg)) {
+		bool ok = false;
+		qreal scale = option.mid(es_arg.length()).toDouble(&ok);
+		if (ok && scale > 0) {
+			export_scale_ = scale;
+			return;
+		}
+	}
+
+	QString e_arg("--export=");
+	if (option.startsWith(e_arg)) {
+		export_format_ = option.mid(e_arg.length()).toUpper();
+		options_ << option;
+		return;
+	}
 	
 	// a ce stade, l'option est inconnue
 	unknown_options_ << option;
@@ -430,3 +477,75 @@ bool QETArguments::printVersionRequested() const
 {
 	return(print_version_);
 }
+
+/**
+	@brief QETArguments::exportRequested
+	@return true if the user asked to export the project files
+	from the command line, without the graphical interface.
+*/
+bool QETArguments::exportRequested() const
+{
+	return(!export_format_.isEmpty());
+}
+
+/**
+	@brief QETArguments::exportFormat
+	@return the format of the command line export in upper case
+	(PDF, SVG, PNG, JPG, BMP or DXF)
+*/
+QString QETArguments::exportFormat() const
+{
+	return(export_format_);
+}
+
+/**
+	@brief QETArguments::exportDir
+	@return the directory where the exported files are written,
+	an empty string if the user didn't specify it.
+*/
+QString QETArguments::exportDir() const
+{
+	return(export_dir_);
+}
+
+/**
+	@brief QETArguments::exportFolios
+	The folios are given as a list of numbers and ranges
+	separated by commas, for example : 1,3-5
+	@return the numbers (starting at 1) of the folios to export,
+	an empty list means every folios.
+*/
+QList<int> QETArguments::exportFolios() const
+{
+	QList<int> folios;
+#if QT_VERSION < QT_VERSION_CHECK(5, 14, 0)	// ### Qt 6: remove
+	const QStringList parts = export_folios_.split(',', QString::SkipEmptyParts);
+#else
+	const QStringList parts = export_folios_.split(',', Qt::SkipEmptyParts);
+#endif
+	for (const QString &part : parts)
+	{
+		const QStringList range = part.split('-');
+		bool ok_first = false, ok_last = false;
+		const int first = range.first().trimmed().toInt(&ok_first);
+		const int last  = range.last().trimmed().toInt(&ok_last);
+		if (!ok_first || !ok_last || range.size() > 2) {
+			continue;
+		}
+		for (int i = first ; i <= last ; ++i) {
+			if (!folios.contains(i)) {
+				folios << i;
+			}
+		}
+	}
+	return(folios);
+}
+
+/**
+	@brief QETArguments::exportScale
+	@return the scale factor applied to the size of the exported folios
+*/
+qreal QETArguments::exportScale() const
+{
+	return(export_scale_);
+}
@@ -63,6 +63,11 @@ class QETArguments : public QObject {
 	virtual bool printHelpRequested() const;
 	virtual bool printLicenseRequested() const;
 	virtual bool printVersionRequested() const;
+	virtual bool exportRequested() const;
+	virtual QString exportFormat() const;
+	virtual QString exportDir() const;
+	virtual QList<int> exportFolios() const;
+	virtual qreal exportScale() const;
 	virtual QList<QString> options() const;
 	virtual QList<QString> unknownOptions() const;
 	
@@ -92,6 +97,10 @@ class QETArguments : public QObject {
 	QString data_dir_;
 #endif
 	QString lang_dir_;
+	QString export_format_;
+	QString export_dir_;
+	QString export_folios_;
+	qreal export_scale_;
 	bool print_help_;
 	bool print_license_;
 	bool print_version_;
@@ -1286,14 +1286,10 @@ ProjectView *QETDiagramEditor::findProject(DiagramView *diagram_view) const
 */
 ProjectView *QETDiagramEditor::findProject(Diagram *diagram) const
 {
-	foreach(ProjectView *project_view, openedProjects()) {
-		foreach(DiagramView *diagram_view, project_view -> diagram_views()) {
-			if (diagram_view -> diagram() == diagram) {
-				return(project_view);
-			}
-		}
-	}
-	return(nullptr);
+		//The view of a diagram is created when it is displayed
+		//for the first time, the project of diagram is searched instead.
+	if (!diagram) return(nullptr);
+	return(findProject(diagram -> project()));
 }
 
 /**
@@ -1806,6 +1802,9 @@ void QETDiagramEditor::addProjectView(ProjectView *project_view)
 	//Manage the adding  of diagram
 	connect(project_view, SIGNAL(diagramAdded(DiagramView *)),
 		this, SLOT(diagramWasAdded(DiagramView *)));
+	//Manage the view of a diagram created when it is displayed
+	connect(project_view, SIGNAL(diagramViewCreated(DiagramView *)),
+		this, SLOT(diagramWasAdded(DiagramView *)));
 
 	if (QETProject *project = project_view -> project())
 		connect(project, SIGNAL(readOnlyChanged(QETProject *, bool)),
@@ -2277,15 +2276,17 @@ void QETDiagramEditor::removeDiagramFromProject()
 */
 void QETDiagramEditor::diagramWasAdded(DiagramView *dv)
 {
+		//A new folio is notified when its view is created and when it is added
 	connect(dv->diagram(),
 		&QGraphicsScene::selectionChanged,
 		this,
 		&QETDiagramEditor::selectionChanged,
-		Qt::DirectConnection);
+		Qt::ConnectionType(Qt::DirectConnection | Qt::UniqueConnection));
 	connect(dv,
 		SIGNAL(modeChanged()),
 		this,
-		SLOT(slot_updateModeActions()));
+		SLOT(slot_updateModeActions()),
+		Qt::UniqueConnection);
 }
 
 /**
@@ -23,7 +23,6 @@
 #include "../../qetproject.h"
 #include "../../qetxml.h"
 
-#include <QSqlError>
 #include <QSqlRecord>
 
 /**
@@ -310,28 +309,94 @@ void ProjectDBModel::setIdentifier(const QString &identifier) {
 
 /**
 	@brief ProjectDBModel::dataBaseUpdated
-	slot called when the project database is updated
+	slot called when the project database is updated.
+	The new rows are compared to the current rows :
+	the rows at the begin and at the end which are the same are kept,
+	the rows between are changed, inserted or removed,
+	so the views only update the rows which really changed.
 */
 void ProjectDBModel::dataBaseUpdated()
 {
-	auto original_record = m_record;
-	fillValue();
-	auto new_record = m_record;
-	m_record = original_record;
-	
-	if (new_record.size() != m_record.size())
+	if (!m_project) {
+		return;
+	}
+
+	const auto new_record = m_project->dataBase()->records(m_query);
+	const auto generation = m_project->dataBase()->generation();
+	if (generation == m_db_generation) {
+		return;
+	}
+	m_db_generation = generation;
+
+	if (new_record == m_record) {
+		return;
+	}
+
+	const auto old_column_count = m_record.isEmpty() ? 0 : m_record.first().count();
+	const auto new_column_count = new_record.isEmpty() ? 0 : new_record.first().count();
+	if (old_column_count != new_column_count)
 	{
 		emit beginResetModel();
 		m_record = new_record;
 		emit endResetModel();
+		return;
+	}
+
+	const int old_size = m_record.size();
+	const int new_size = new_record.size();
+	const int min_size = std::min(old_size, new_size);
+
+	int prefix = 0;
+	while (prefix < min_size && m_record.at(prefix) == new_record.at(prefix)) {
+		++prefix;
+	}
+	int suffix = 0;
+	while (suffix < min_size - prefix
+		   && m_record.at(old_size - 1 - suffix) == new_record.at(new_size - 1 - suffix)) {
+		++suffix;
 	}
-	else
+
+	const int old_middle = old_size - prefix - suffix;
+	const int new_middle = new_size - prefix - suffix;
+	const int changed = std::min(old_middle, new_middle);
+
+		//Rows changed in place, one signal for each range of changed rows
+	int first_changed = -1;
+	for (int row = prefix ; row <= prefix + changed ; ++row)
 	{
-		m_record = new_record;
-		auto row = m_record.size();
-		auto col = row ? m_record.first().count() : 1;
-		
-		emit dataChanged(this->index(0,0), this->index(row-1, col-1), QVector<int>(Qt::DisplayRole));
+		if (row < prefix + changed && m_record.at(row) != new_record.at(row))
+		{
+			m_record[row] = new_record.at(row);
+			if (first_changed < 0) {
+				first_changed = row;
+			}
+		}
+		else if (first_changed >= 0)
+		{
+			emit dataChanged(index(first_changed, 0),
+					 index(row - 1, new_column_count - 1),
+					 QVector<int>{Qt::DisplayRole});
+			first_changed = -1;
+		}
+	}
+
+	if (new_middle > old_middle)
+	{
+		const int first = prefix + changed;
+		const int last = prefix + new_middle - 1;
+		beginInsertRows(QModelIndex(), first, last);
+		for (int row = first ; row <= last ; ++row) {
+			m_record.insert(row, new_record.at(row));
+		}
+		endInsertRows();
+	}
+	else if (old_middle > new_middle)
+	{
+		const int first = prefix + changed;
+		const int last = prefix + old_middle - 1;
+		beginRemoveRows(QModelIndex(), first, last);
+		m_record.remove(first, last - first + 1);
+		endRemoveRows();
 	}
 }
 
@@ -361,28 +426,8 @@ void ProjectDBModel::setHeaderString()
 
 void ProjectDBModel::fillValue()
 {
-	m_record.clear();
-	
-	auto query_ = m_project->dataBase()->newQuery(m_query);
-	if (!query_.exec()) {
-		qDebug() << "Query error : " << query_.lastError();
-	}
-	
-	while (query_.next())
-	{
-		QStringList record_;
-		auto i=0;
-		while (query_.value(i).isValid())
-		{
-			auto date = query_.value(i).toDate();
-			if (!date.isNull()) {
-				record_ << QLocale::system().toString(query_.value(i).toDate(), QLocale::ShortFormat);
-			} else {
-				record_ << query_.value(i).toString();
-			}
-			++i;
-		}
-		m_record << record_;
-	}
+		//The result is shared with the others models which use the same query
+	m_record = m_project->dataBase()->records(m_query);
+	m_db_generation = m_project->dataBase()->generation();
 }
 
@@ -81,6 +81,8 @@ class ProjectDBModel : public QAbstractTableModel
 		QPointer<QETProject> m_project;
 		QString m_query;
 		QVector<QStringList> m_record;
+			//Generation of the data base when m_record was filled
+		quint64 m_db_generation = 0;
 		//First int = section, second int = Qt::role, QVariant = value
 		QHash<int, QHash<int, QVariant>> m_header_data;
 		QHash<int, QVariant> m_index_0_0_data;
@@ -184,6 +184,10 @@ void QetGraphicsTableItem::setModel(QAbstractItemModel *model)
 			   this, &QetGraphicsTableItem::dataChanged);
 		disconnect(m_model, &QAbstractItemModel::modelReset,
 			   this, &QetGraphicsTableItem::modelReseted);
+		disconnect(m_model, &QAbstractItemModel::rowsInserted,
+			   this, &QetGraphicsTableItem::modelReseted);
+		disconnect(m_model, &QAbstractItemModel::rowsRemoved,
+			   this, &QetGraphicsTableItem::modelReseted);
 	}
 	m_model = model;
 	m_header_item->setModel(m_model);
@@ -198,6 +202,10 @@ void QetGraphicsTableItem::setModel(QAbstractItemModel *model)
 			this, &QetGraphicsTableItem::dataChanged);
 		connect(m_model, &QAbstractItemModel::modelReset,
 			this, &QetGraphicsTableItem::modelReseted);
+		connect(m_model, &QAbstractItemModel::rowsInserted,
+			this, &QetGraphicsTableItem::modelReseted);
+		connect(m_model, &QAbstractItemModel::rowsRemoved,
+			this, &QetGraphicsTableItem::modelReseted);
 	}
 
 	if (m_next_table) {
@@ -861,13 +869,19 @@ void QetGraphicsTableItem::modelReseted()
 	@brief QetGraphicsTableItem::setUpColumnAndRowMinimumSize
 	Calculate the minimum row height and the minimum column width for each columns
 	this function doesn't change the geometry of the table.
+	The width of the text of each cell is kept, only the rows
+	from first_row to last_row are measured again.
+	If last_row is negative or the number of rows changed, all rows are measured.
+	@param first_row
+	@param last_row
 */
-void QetGraphicsTableItem::setUpColumnAndRowMinimumSize()
+void QetGraphicsTableItem::setUpColumnAndRowMinimumSize(int first_row, int last_row)
 {
 	if (!m_model)
 	{
 		m_minimum_row_height = no_model_height;
 		m_minimum_column_width = m_header_item->minimumSectionWidth();
+		m_cell_text_width.clear();
 		return;
 	}
 
@@ -878,18 +892,35 @@ void QetGraphicsTableItem::setUpColumnAndRowMinimumSize()
 
 	m_minimum_column_width = m_header_item->minimumSectionWidth();
 
+	const auto row_count = m_model->rowCount();
+	const auto column_count = m_model->columnCount();
+	if (last_row < 0 || m_cell_text_width.size() != row_count)
+	{
+		first_row = 0;
+		last_row = row_count - 1;
+		m_cell_text_width.resize(row_count);
+	}
+
+		//Measure the text of the rows to update
+	for (auto row = first_row ; row <= last_row ; ++row)
+	{
+		auto &widths = m_cell_text_width[row];
+		widths.resize(column_count);
+		for(auto col= 0 ; col<column_count ; ++col) {
+			widths[col] = metrics.boundingRect(m_model->index(row, col).data().toString()).width();
+		}
+	}
+
 		//Get the maximum width of each columns
-	for (auto row= 0 ; row<m_model->rowCount() ; ++row)
+	for (const auto &widths : qAsConst(m_cell_text_width))
 	{
-		for(auto col= 0 ; col<m_model->columnCount() ; ++col)
+		for(auto col= 0 ; col<std::min<int>(column_count, widths.size()) ; ++col)
 		{
-			auto index = m_model->index(row, col);
-			auto width = metrics.boundingRect(index.data().toString()).width();
 			m_minimum_column_width.replace(
 						col,
 						std::max(
 							m_minimum_column_width.at(col),
-							width + margin_.left() + margin_.right()));
+							widths.at(col) + margin_.left() + margin_.right()));
 		}
 	}
 }
@@ -1031,15 +1062,55 @@ void QetGraphicsTableItem::dataChanged(
 		const QModelIndex &bottomRight,
 		const QVector<int> &roles)
 {
-	Q_UNUSED(topLeft)
-	Q_UNUSED(bottomRight)
-	Q_UNUSED(roles)
+		//Only the text of some rows changed :
+		//if the columns keep the same width, only these rows are repainted
+	if (roles.size() == 1 && roles.first() == Qt::DisplayRole
+		&& topLeft.isValid() && bottomRight.isValid())
+	{
+		const auto column_width = m_minimum_column_width;
+		setUpColumnAndRowMinimumSize(topLeft.row(), bottomRight.row());
+		if (m_minimum_column_width == column_width)
+		{
+			updateRows(topLeft.row(), bottomRight.row());
+			return;
+		}
+	}
+	else {
+		setUpColumnAndRowMinimumSize();
+	}
 
-	setUpColumnAndRowMinimumSize();
 	adjustSize();
 	update();
 }
 
+/**
+	@brief QetGraphicsTableItem::updateRows
+	Repaint the rows first to last of the model,
+	if they are displayed by this table.
+	@param first
+	@param last
+*/
+void QetGraphicsTableItem::updateRows(int first, int last)
+{
+	const auto row_count = displayedRowCount();
+	if (row_count <= 0) {
+		return;
+	}
+
+	const auto offset = m_previous_table ? m_previous_table->displayNRowOffset() : 0;
+	first = std::max(first, offset) - offset;
+	last = std::min(last, offset + row_count - 1) - offset;
+	if (first > last) {
+		return;
+	}
+
+	const auto cell_height = static_cast<double>(m_current_size.height())/static_cast<double>(row_count);
+	update(QRectF(0,
+		      cell_height*first,
+		      m_header_item->rect().width(),
+		      cell_height*(last - first + 1)));
+}
+
 /**
 	@brief QetGraphicsTableItem::adjustSize
 	If needed, this function resize the current height and width of table and/or the size of columns.
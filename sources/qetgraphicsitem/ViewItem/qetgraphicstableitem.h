@@ -106,7 +106,7 @@ class QetGraphicsTableItem : public QetGraphicsItem
 
 	private:
 		void modelReseted();
-		void setUpColumnAndRowMinimumSize();
+		void setUpColumnAndRowMinimumSize(int first_row = 0, int last_row = -1);
 		void setUpBoundingRect();
 		void adjustHandlerPos();
 		void setUpHandler();
@@ -118,6 +118,7 @@ class QetGraphicsTableItem : public QetGraphicsItem
 				const QModelIndex &topLeft,
 				const QModelIndex &bottomRight,
 				const QVector<int> &roles);
+		void updateRows(int first, int last);
 		void headerSectionResized();
 		void adjustSize();
 		void previousTableDisplayRowChanged();
@@ -126,6 +127,8 @@ class QetGraphicsTableItem : public QetGraphicsItem
 		QPointer<QAbstractItemModel> m_model;
 
 		QVector<int> m_minimum_column_width;
+			//Width of the text of each cell, by row
+		QVector<QVector<int>> m_cell_text_width;
 		int
 		m_minimum_row_height,
 		m_number_of_row_to_display = 0,
@@ -21,6 +21,7 @@
 #include "../../../diagram.h"
 #include "../../../elementprovider.h"
 #include "../../../factory/propertieseditorfactory.h"
+#include "../../../qetproject.h"
 #include "../../../undocommand/itemmodelcommand.h"
 #include "../../../utils/qetutils.h"
 #include "../qetgraphicsheaderitem.h"
@@ -337,6 +338,7 @@ void GraphicsTablePropertiesEditor::updateUi()
 						m_other_table_vector.indexOf(item_)));
 	}
 
+	m_table_item->diagram()->project()->materializeTableDiagrams();
 	ElementProvider ep(m_table_item->diagram()->project());
 	for (auto item_ : ep.table(m_table_item, m_table_item->model())) //Add available tables
 	{
@@ -24,7 +24,9 @@
 #include "../conductorsegmentprofile.h"
 #include "../diagram.h"
 #include "../diagramcommands.h"
+#include "../project/diagramcontentdata.h"
 #include "../qetdiagrameditor.h"
+#include "../qetproject.h"
 #include "../qetgraphicsitem/terminal.h"
 #include "../ui/conductorpropertiesdialog.h"
 #include "conductortextitem.h"
@@ -661,6 +663,8 @@ void Conductor::mouseReleaseEvent(QGraphicsSceneMouseEvent *event)
 */
 void Conductor::hoverEnterEvent(QGraphicsSceneHoverEvent *event) {
 	Q_UNUSED(event);
+		//The shape is bigger when hovered
+	prepareGeometryChange();
 	m_mouse_over = true;
 	update();
 }
@@ -672,6 +676,7 @@ void Conductor::hoverEnterEvent(QGraphicsSceneHoverEvent *event) {
 */
 void Conductor::hoverLeaveEvent(QGraphicsSceneHoverEvent *event) {
 	Q_UNUSED(event);
+	prepareGeometryChange();
 	update();
 	m_mouse_over = false;
 }
@@ -713,6 +718,10 @@ QVariant Conductor::itemChange(GraphicsItemChange change, const QVariant &value)
 	else if (change == QGraphicsItem::ItemPositionHasChanged && isSelected()) {
 		adjustHandlerPos();
 	}
+	else if (change == QGraphicsItem::ItemScenePositionHasChanged) {
+		m_junctions_valid = false;
+		invalidateRelatedJunctions();
+	}
 
 	return(QGraphicsObject::itemChange(change, value));
 }
@@ -990,27 +999,38 @@ void Conductor::pointsToSegments(const QList<QPointF>& points_list) {
 	Load the conductor and her information from xml element
 	@param dom_element
 	@return true is loading success else return false
+	@see Conductor::fromContentData
 */
 bool Conductor::fromXml(QDomElement &dom_element)
 {
-	setPos(dom_element.attribute("x", nullptr).toDouble(),
-		   dom_element.attribute("y", nullptr).toDouble());
+	return fromContentData(ConductorContentData::fromXml(dom_element));
+}
+
+/**
+	@brief Conductor::fromContentData
+	Load the conductor and her information from the description
+	of the conductor decoded from xml (see ConductorContentData::fromXml)
+	@param data
+	@return true is loading success else return false
+*/
+bool Conductor::fromContentData(const ConductorContentData &data)
+{
+	setPos(data.pos);
 
-	bool return_ = pathFromXml(dom_element);
+	bool return_ = pathFromSegments(data.segments);
 
-	m_text_item -> fromXml(dom_element);
-	ConductorProperties pr;
-	pr.fromXml(dom_element);
+	m_text_item -> fromXml(data.xml);
 
 		//Load Sequential Values
+	const QDomElement &dom_element = data.xml;
 	if (dom_element.hasAttribute("sequ_1") || dom_element.hasAttribute("sequf_1") || dom_element.hasAttribute("seqt_1") || dom_element.hasAttribute("seqtf_1") || dom_element.hasAttribute("seqh_1") || dom_element.hasAttribute("sequf_1"))
 		ConductorXmlRetroCompatibility::loadSequential(dom_element, this);
 	else
 		m_autoNum_seq.fromXml(dom_element.firstChildElement("sequentialNumbers"));
 
-	m_freeze_label = dom_element.attribute("freezeLabel") == "true"? true : false;
+	m_freeze_label = data.freeze_label;
 
-	setProperties(pr);
+	setProperties(data.properties);
 
 	return return_;
 }
@@ -1100,36 +1120,17 @@ QDomElement Conductor::toXml(QDomDocument &dom_document,
 }
 
 /**
-	@brief Conductor::pathFromXml
-	Generate the path (of the line) from xml file by checking the segments in the xml
-	file
-	@param e
+	@brief Conductor::pathFromSegments
+	Generate the path (of the line) from the segments read in the xml
+	file (see ConductorContentData::fromXml)
+	@param segments : horizontal and vertical length of each segment
 	@return true if generate path success else return false
 */
-bool Conductor::pathFromXml(const QDomElement &e) {
-	// parcourt les elements XML "segment" et en extrait deux listes de longueurs
-	// les segments non valides sont ignores
+bool Conductor::pathFromSegments(const QList<QPointF> &segments) {
 	QList<qreal> segments_x, segments_y;
-	for (QDomNode node = e.firstChild() ; !node.isNull() ; node = node.nextSibling()) {
-		// on s'interesse aux elements XML "segment"
-		QDomElement current_segment = node.toElement();
-		if (current_segment.isNull() || current_segment.tagName() != "segment") continue;
-
-		// le segment doit avoir une longueur
-		if (!current_segment.hasAttribute("length")) continue;
-
-		// cette longueur doit etre un reel
-		bool ok;
-		qreal segment_length = current_segment.attribute("length").toDouble(&ok);
-		if (!ok) continue;
-
-		if (current_segment.attribute("orientation") == "horizontal") {
-			segments_x << segment_length;
-			segments_y << 0.0;
-		} else {
-			segments_x << 0.0;
-			segments_y << segment_length;
-		}
+	for (const auto &segment : segments) {
+		segments_x << segment.x();
+		segments_y << segment.y();
 	}
 
 	//If there isn't segment we generate automatic path and return true
@@ -1522,6 +1523,8 @@ void Conductor::setPath(const QPainterPath &path)
 
 	prepareGeometryChange();
 	m_path = path;
+	m_junctions_valid = false;
+	invalidateRelatedJunctions();
 	update();
 }
 
@@ -1684,6 +1687,17 @@ void Conductor::displayedTextChanged()
 */
 QSet<Conductor *> Conductor::relatedPotentialConductors(const bool all_diagram, QList <Terminal *> *t_list)
 {
+		//Use the potential index of the project when this conductor is known by it,
+		//else walk the terminals.
+	if (t_list == nullptr && diagram() && diagram()->project())
+	{
+		QSet <Conductor *> indexed_conductors;
+		if (diagram()->project()->potentialIndex()->potentialConductors(
+				this, all_diagram, indexed_conductors)) {
+			return indexed_conductors;
+		}
+	}
+
 	bool declar_t_list = false;
 	if (t_list == nullptr)
 	{
@@ -1814,9 +1828,55 @@ bool isContained(const QPointF &a, const QPointF &b, const QPointF &c) {
 }
 
 /**
+	@brief Conductor::junctions
+	The junctions are computed only when the path of this conductor
+	or of a related conductor changed since the last call.
 	@return la liste des positions des jonctions avec d'autres conducteurs
 */
 QList<QPointF> Conductor::junctions() const
+{
+	if (!m_junctions_valid)
+	{
+		m_junctions = computeJunctions();
+		m_junctions_valid = true;
+	}
+	return m_junctions;
+}
+
+/**
+	@brief Conductor::invalidateJunctions
+	The junctions will be computed again at the next paint
+*/
+void Conductor::invalidateJunctions()
+{
+	if (!m_junctions_valid) {
+		return;
+	}
+	m_junctions_valid = false;
+	update();
+}
+
+/**
+	@brief Conductor::invalidateRelatedJunctions
+	Invalidate the junctions of the conductors which share
+	a terminal with this conductor,
+	because their junctions depend of the path of this conductor.
+*/
+void Conductor::invalidateRelatedJunctions()
+{
+	if (!terminal1 || !terminal2) {
+		return;
+	}
+	for (const auto &conductor : relatedConductors(this)) {
+		conductor->invalidateJunctions();
+	}
+}
+
+/**
+	@brief Conductor::computeJunctions
+	@return la liste des positions des jonctions avec d'autres conducteurs
+*/
+QList<QPointF> Conductor::computeJunctions() const
 {
 	QList<QPointF> junctions_list;
 
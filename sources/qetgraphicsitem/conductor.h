@@ -28,6 +28,7 @@ class Diagram;
 class Terminal;
 class ConductorSegment;
 class ConductorTextItem;
+struct ConductorContentData;
 class Element;
 class QETDiagramEditor;
 class NumerotationContext;
@@ -101,12 +102,13 @@ class Conductor : public QGraphicsObject
 	public:
 		static bool valideXml (QDomElement &);
 		bool fromXml (QDomElement &);
+		bool fromContentData(const ConductorContentData &data);
 		QDomElement toXml (
 				QDomDocument &,
 				QHash<Terminal *,
 				int> &) const;
 	private:
-		bool pathFromXml(const QDomElement &);
+		bool pathFromSegments(const QList<QPointF> &segments);
 
 	public:
 		QVector <QPointF> handlerPoints() const;
@@ -138,6 +140,7 @@ class Conductor : public QGraphicsObject
 		void setSequenceNum(const autonum::sequentialNumbers& sn);
 
 		QList<QPointF> junctions() const;
+		void invalidateJunctions();
 
 	private:
 		void setUpConnectionForFormula(
@@ -211,6 +214,10 @@ class Conductor : public QGraphicsObject
 		static QBrush conductor_brush;
 		static bool pen_and_brush_initialized;
 		QPainterPath m_path;
+			/// Junctions are computed at the first paint after a change
+			/// of the path of this conductor or of a related conductor
+		mutable QList<QPointF> m_junctions;
+		mutable bool m_junctions_valid = false;
 	
 	private:
 		void segmentsToPath();
@@ -220,6 +227,8 @@ class Conductor : public QGraphicsObject
 		uint segmentsCount(QET::ConductorSegmentType = QET::Both) const;
 		QList<QPointF> segmentsToPoints() const;
 		QList<ConductorBend> bends() const;
+		QList<QPointF> computeJunctions() const;
+		void invalidateRelatedJunctions();
 
 		void pointsToSegments(const QList<QPointF>&);
 		Qt::Corner currentPathType() const;
@@ -21,6 +21,7 @@
 #include "../diagram.h"
 #include "../diagramposition.h"
 #include "../qetapp.h"
+#include "../qetproject.h"
 #include "dynamicelementtextitem.h"
 #include "element.h"
 #include "elementtextitemgroup.h"
@@ -121,10 +122,10 @@ void CrossRefItem::setUpConnection()
 		m_update_connection
 				<< connect(project,
 					       &QETProject::projectDiagramsOrderChanged,
-					       this, &CrossRefItem::updateLabel);
+					       this, &CrossRefItem::invalidate);
 		m_update_connection << connect(project,
 					       &QETProject::diagramRemoved,
-					       this, &CrossRefItem::updateLabel);
+					       this, &CrossRefItem::invalidate);
 		m_update_connection << connect(m_element,
 					       &Element::linkedElementChanged,
 					       this, &CrossRefItem::linkedChanged);
@@ -135,7 +136,7 @@ void CrossRefItem::setUpConnection()
 			formula_.contains("%F"))
 		{
 			m_update_connection << connect(diagram_ , &Diagram::diagramInformationChanged,
-										   this, &CrossRefItem::updateLabel);
+										   this, &CrossRefItem::invalidate);
 		}
 		linkedChanged();
 		updateLabel();
@@ -210,12 +211,56 @@ void CrossRefItem::updateProperties()
 	}
 }
 
+/**
+	@brief CrossRefItem::invalidate
+	The content of this item may have changed,
+	queue this item to be checked at the next turn of the event loop.
+	@see CrossRefUpdateQueue
+*/
+void CrossRefItem::invalidate()
+{
+	if (m_element->diagram()) {
+		m_element->diagram()->project()->xrefUpdateQueue()->invalidate(this);
+	} else {
+		updateLabel();
+	}
+}
+
+/**
+	@brief CrossRefItem::updateIfChanged
+	Update the content of the item,
+	only if the position of a displayed slave changed
+	since the last update.
+*/
+void CrossRefItem::updateIfChanged()
+{
+	if (positionTexts() != m_position_texts) {
+		updateLabel();
+	}
+}
+
+/**
+	@brief CrossRefItem::positionTexts
+	@return the position text of each linked element,
+	in the same order as Element::linkedElements.
+*/
+QStringList CrossRefItem::positionTexts() const
+{
+	QStringList texts;
+	for (const auto &elmt : m_element->linkedElements()) {
+		texts << elementPositionText(elmt, true);
+	}
+	return texts;
+}
+
 /**
 	@brief CrossRefItem::updateLabel
 	Update the content of the item
 */
 void CrossRefItem::updateLabel()
 {
+	m_position_texts = positionTexts();
+
 		//init the shape and bounding rect
 	m_shape_path    = QPainterPath();
 	prepareGeometryChange();
@@ -437,11 +482,11 @@ void CrossRefItem::linkedChanged()
 		m_slave_connection << connect(elmt,
 					      &Element::xChanged,
 					      this,
-					      &CrossRefItem::updateLabel);
+					      &CrossRefItem::invalidate);
 		m_slave_connection << connect(elmt,
 					      &Element::yChanged,
 					      this,
-					      &CrossRefItem::updateLabel);
+					      &CrossRefItem::invalidate);
 	}
 
 	updateLabel();
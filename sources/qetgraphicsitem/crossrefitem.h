@@ -23,6 +23,7 @@
 #include <QGraphicsObject>
 #include <QMultiMap>
 #include <QPicture>
+#include <QStringList>
 
 class Element;
 class DynamicElementTextItem;
@@ -37,7 +38,10 @@ class ElementTextItemGroup;
 	when folio position change in the project.
 	It's the responsibility of the master element
 	to inform displayed slave are moved,
-	by calling the slot updateLabel
+	by calling the slot updateLabel.
+	Moves of the slaves and changes of the folios only invalidate
+	the Xref, it is then drawn again at the next turn of the event loop
+	if the position of a slave really changed (see CrossRefUpdateQueue).
 	By default master element is the parent graphics item of this Xref,
 	but if the Xref must be snap to the label of master,
 	the label become the parent of this Xref.
@@ -85,10 +89,13 @@ class CrossRefItem : public QGraphicsObject
 				const Element *elmt,
 				const bool &add_prefix = false) const;
 
+		void updateIfChanged();
+
 	public slots:
 		void updateProperties();
 		void updateLabel();
 		void autoPos();
+		void invalidate();
 
 	protected:
 		bool sceneEvent(QEvent *event) override;
@@ -112,6 +119,7 @@ class CrossRefItem : public QGraphicsObject
 		void AddExtraInfo(QPainter &painter, const QString&);
 		QList<Element *> NOElements() const;
 		QList<Element *> NCElements() const;
+		QStringList positionTexts() const;
 
 		//Attributes
 	private:
@@ -127,6 +135,8 @@ class CrossRefItem : public QGraphicsObject
 		ElementTextItemGroup *m_group = nullptr;
 		QList <QMetaObject::Connection> m_slave_connection;
 		QList <QMetaObject::Connection> m_update_connection;
+			//Position texts of the linked elements at the last update
+		QStringList m_position_texts;
 };
 
 #endif // CROSSREFITEM_H
@@ -98,6 +98,7 @@ void DiagramImageItem::editProperty()
 	@param pixmap the new pixmap
 */
 void DiagramImageItem::setPixmap(const QPixmap &pixmap) {
+	prepareGeometryChange();
 	pixmap_ = pixmap;
 	setTransformOriginPoint(boundingRect().center());
 }
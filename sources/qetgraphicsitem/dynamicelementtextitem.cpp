@@ -23,6 +23,7 @@
 #include "../qetgraphicsitem/conductor.h"
 #include "../qetgraphicsitem/terminal.h"
 #include "../qetinformation.h"
+#include "../utils/qetsettings.h"
 #include "crossrefitem.h"
 #include "element.h"
 #include "elementtextitemgroup.h"
@@ -43,10 +44,9 @@ DynamicElementTextItem::DynamicElementTextItem(Element *parent_element) :
 	setFont(QETApp::dynamicTextsItemFont());
 	setText(tr("Texte"));
 	setParentItem(parent_element);
-	QSettings settings;
-	setRotation(settings.value("dynamic_text_rotation", 0).toInt());
+	setRotation(QetSettings::dynamicTextRotation());
 	setKeepVisualRotation(true);
-	setTextWidth(settings.value("dynamic_text_width", -1).toInt());
+	setTextWidth(QetSettings::dynamicTextWidth());
 	connect(this, &DynamicElementTextItem::textEdited, [this](const QString &old_str, const QString &new_str)
 	{
 		if(this->m_parent_element && this->m_parent_element->diagram())
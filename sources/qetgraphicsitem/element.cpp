@@ -17,6 +17,7 @@
 */
 #include "element.h"
 
+#include "../ElementsCollection/elementdefinitioncache.h"
 #include "../PropertiesEditor/propertieseditordialog.h"
 #include "../autoNum/numerotationcontextcommands.h"
 #include "../diagram.h"
@@ -24,6 +25,7 @@
 #include "../diagramcontext.h"
 #include "../diagramposition.h"
 #include "../elementprovider.h"
+#include "../project/diagramcontentdata.h"
 #include "../factory/elementpicturefactory.h"
 #include "../properties/terminaldata.h"
 #include "../qetgraphicsitem/conductor.h"
@@ -100,7 +102,8 @@ Element::Element(
 		}
 	}
 	int elmt_state;
-	buildFromXml(location.xml(), &elmt_state);
+	const auto definition = location.definition();
+	buildFromDefinition(definition.data(), &elmt_state);
 	if (state) {
 		*state = elmt_state;
 	}
@@ -395,9 +398,11 @@ void Element::drawHighlight(
 }
 
 /**
-	@brief Element::buildFromXml
-	Build this element from an xml description
-	@param xml_def_elmt
+	@brief Element::buildFromDefinition
+	Build this element from the shared parsed definition of its location.
+	The size, hotspot, element data, terminals and texts are taken from
+	the definition, they are parsed only once per element type.
+	@param definition
 	@param state
 	Optional pointer which define the status of build
 	0 - evreything all right
@@ -408,17 +413,19 @@ void Element::drawHighlight(
 	8 - No part of the drawing could be loaded
 	@return
 */
-bool Element::buildFromXml(const QDomElement &xml_def_elmt, int *state)
+bool Element::buildFromDefinition(const ElementDefinition *definition,
+				  int *state)
 {
 	m_state = QET::GIBuildingFromXml;
 
-	if (xml_def_elmt.tagName() != QLatin1String("definition")
-			|| xml_def_elmt.attribute(QStringLiteral("type")) != QLatin1String("element"))
+	if (!definition
+		|| definition->xml().attribute(QStringLiteral("type")) != QLatin1String("element"))
 	{
 		if (state) *state = 4;
 		m_state = QET::GIOK;
 		return(false);
 	}
+	const QDomElement xml_def_elmt = definition->xml();
 
 		//Check if the current version can read the xml description
 	const auto elmt_version = QetVersion::fromXmlAttribute(xml_def_elmt);
@@ -433,19 +440,15 @@ bool Element::buildFromXml(const QDomElement &xml_def_elmt, int *state)
 	}
 
 		//This attribute must be present and valid
-	int w = 0, h = 0, hot_x = 0, hot_y = 0;
-	if (!QET::attributeIsAnInteger(xml_def_elmt, QStringLiteral("width"), &w)         ||
-		!QET::attributeIsAnInteger(xml_def_elmt, QStringLiteral("height"), &h)        ||
-		!QET::attributeIsAnInteger(xml_def_elmt, QStringLiteral("hotspot_x"), &hot_x) ||
-		!QET::attributeIsAnInteger(xml_def_elmt, QStringLiteral("hotspot_y"), &hot_y))
+	if (!definition->hasValidSize())
 	{
 		if (state) *state = 5;
 		m_state = QET::GIOK;
 		return(false);
 	}
 
-	setSize(w, h);
-	setHotspot(QPoint(hot_x, hot_y));
+	setSize(definition->size().width(), definition->size().height());
+	setHotspot(definition->hotspot());
 
 		//the definition must have childs
 	if (xml_def_elmt.firstChild().isNull())
@@ -455,71 +458,34 @@ bool Element::buildFromXml(const QDomElement &xml_def_elmt, int *state)
 		return(false);
 	}
 
-	m_data.fromXml(xml_def_elmt);
+	m_data = definition->elementData();
 	setToolTip(name());
+	m_kind_informations = definition->kindInformations();
 
-		//load kind informations
-	m_kind_informations.fromXml(
-				xml_def_elmt.firstChildElement(QStringLiteral("kindInformations")),
-				QStringLiteral("kindInformation"));
-		//load element information
-	m_data.m_informations.fromXml(
-				xml_def_elmt.firstChildElement(QStringLiteral("elementInformations")),
-				QStringLiteral("elementInformation"));
-
-		//scroll of the Children of the Definition: Parts of the Drawing
-	int parsed_elements_count = 0;
-	for (QDomNode node = xml_def_elmt.firstChild() ;
-		 !node.isNull() ;
-		 node = node.nextSibling())
+		//Terminals and texts are already extracted from the description
+		//by the definition, the label workaround of the old "input"
+		//is also already done.
+	for (const auto &dom : definition->terminals())
 	{
-		QDomElement elmts = node.toElement();
-		if (elmts.isNull())
-			continue;
-
-		if (elmts.tagName() == QLatin1String("description"))
+		if (!parseTerminal(dom))
 		{
-				//Minor workaround to find if there is a "input" tagg as label.
-				//If not, we set the tagg "label" to the first "input.
-			QList <QDomElement> input_field;
-			bool have_label = false;
-			for (QDomElement input_node = node.firstChildElement(QStringLiteral("input")) ;
-				 !input_node.isNull() ;
-				 input_node = input_node.nextSiblingElement(QStringLiteral("input")))
-			{
-				if (!input_node.isNull())
-				{
-					input_field << input_node;
-					if (input_node.attribute(QStringLiteral("tagg"), QStringLiteral("none"))
-							== QLatin1String("label"))
-						have_label = true;
-				}
-			}
-			if(!have_label && !input_field.isEmpty())
-				input_field.first().setAttribute(QStringLiteral("tagg"), QStringLiteral("label"));
-
-				//Parse the definition
-			for (QDomNode n = node.firstChild() ;
-				 !n.isNull() ;
-				 n = n.nextSibling())
-			{
-				QDomElement qde = n.toElement();
-				if (qde.isNull())
-					continue;
-
-				if (parseElement(qde)) {
-					++ parsed_elements_count;
-				}
-				else
-				{
-					if (state)
-						*state = 7;
-					m_state = QET::GIOK;
-					return(false);
-				}
-			}
+			if (state)
+				*state = 7;
+			m_state = QET::GIOK;
+			return(false);
+		}
+	}
+	for (const auto &dom : definition->texts())
+	{
+		if (!parseElement(dom))
+		{
+			if (state)
+				*state = 7;
+			m_state = QET::GIOK;
+			return(false);
 		}
 	}
+	int parsed_elements_count = definition->partsCount();
 
 	ElementPictureFactory *epf = ElementPictureFactory::instance();
 	epf->getPictures(m_location,
@@ -704,32 +670,43 @@ bool Element::valideXml(QDomElement &e)
 	@param table_id_adr : Reference to the mapping table between IDs of the XML file
 	and the addresses in memory. If the import succeeds, it must be add the right couples (id, address).
 	@return
+	@see Element::fromContentData
 */
 bool Element::fromXml(QDomElement &e,
 					  QHash<int,Terminal *> &table_id_adr)
+{
+	return fromContentData(ElementContentData::fromXml(e), table_id_adr);
+}
+
+/**
+	@brief Element::fromContentData
+	Import the parameters of this element from the description
+	of the element decoded from xml (see ElementContentData::fromXml).
+	Same as fromXml, ensure this element is already in a scene.
+	@param data : the description of this element
+	@param table_id_adr : Reference to the mapping table between IDs of the XML file
+	and the addresses in memory. If the import succeeds, it must be add the right couples (id, address).
+	@return
+*/
+bool Element::fromContentData(const ElementContentData &data,
+			      QHash<int, Terminal *> &table_id_adr)
 {
 	m_state = QET::GILoadingFromXml;
 	/*
 		les bornes vont maintenant etre recensees pour associer leurs id a leur adresse reelle
 		ce recensement servira lors de la mise en place des fils
 	*/
-	QList<QDomElement> liste_terminals;
-	for (auto qde :
-			QET::findInDomElement(e, QStringLiteral("terminals"), QStringLiteral("terminal"))) {
-		if (Terminal::valideXml(qde)) liste_terminals << qde;
-	}
-
 	QHash<int, Terminal *> priv_id_adr;
 
 	for (auto *qgi : childItems())
 	{
 		if (auto terminal_ = qgraphicsitem_cast<Terminal *>(qgi))
 		{
-			for(auto qde : liste_terminals)
+			for(const auto &terminal_data : data.terminals)
 			{
-				if (terminal_ -> fromXml(qde))
+				if (terminal_ -> fromContentData(terminal_data))
 				{
-					priv_id_adr.insert(qde.attribute(QStringLiteral("id")).toInt(),
+					priv_id_adr.insert(terminal_data.id,
 									   terminal_);
 				}
 			}
@@ -755,23 +732,19 @@ bool Element::fromXml(QDomElement &e,
 	}
 
 	//load uuid of connected elements
-	QList <QDomElement> uuid_list = QET::findInDomElement(e,
-														  QStringLiteral("links_uuids"),
-														  QStringLiteral("link_uuid"));
-	foreach (QDomElement qdo, uuid_list) {
-		tmp_uuids_link << QUuid(qdo.attribute(QStringLiteral("uuid")));
-	}
+	tmp_uuids_link << data.links;
 
 	//uuid of this element
-	m_uuid = QUuid(e.attribute(QStringLiteral("uuid"), QUuid::createUuid().toString()));
+	m_uuid = data.uuid;
+	emit uuidChanged();
 
 		//load prefix
-	m_prefix = e.attribute(QStringLiteral("prefix"));
+	m_prefix = data.prefix;
 
-	QString fl = e.attribute(QStringLiteral("freezeLabel"), QStringLiteral("false"));
-	m_freeze_label = fl == QLatin1String("false") ? false : true;
+	m_freeze_label = data.freeze_label;
 
 		//Load Sequential Values
+	QDomElement e = data.xml;
 	if (e.hasAttribute(QStringLiteral("sequ_1"))
 			|| e.hasAttribute(QStringLiteral("sequf_1"))
 			|| e.hasAttribute(QStringLiteral("seqt_1"))
@@ -784,19 +757,15 @@ bool Element::fromXml(QDomElement &e,
 
 		//Position and selection.
 		//We directly call setPos from QGraphicsObject, because QetGraphicsItem will snap to grid
-	QGraphicsObject::setPos(e.attribute(QStringLiteral("x")).toDouble(),
-							e.attribute(QStringLiteral("y")).toDouble());
-	setZValue(e.attribute(QStringLiteral("z"), QString::number(this->zValue())).toDouble());
+	QGraphicsObject::setPos(data.pos);
+	if (data.has_z) {
+		setZValue(data.z);
+	}
 	setFlags(QGraphicsItem::ItemIsMovable
 		 | QGraphicsItem::ItemIsSelectable);
 
 	// orientation
-	bool conv_ok;
-	int read_ori = e.attribute(QStringLiteral("orientation")).toInt(&conv_ok);
-	if (!(conv_ok) || (read_ori < 0) || (read_ori > 3)) {
-		read_ori = 0;
-	}
-	setRotation(90*read_ori);
+	setRotation(90*data.orientation);
 
 		//Before loading the dynamic text field,
 		//we remove the dynamic text field created from the description of this element, to avoid doubles.
@@ -807,31 +776,20 @@ bool Element::fromXml(QDomElement &e,
 		//************************//
 		//***Dynamic texts item***//
 		//************************//
-	for (const QDomElement& qde : QET::findInDomElement(
-			 e,
-			 QStringLiteral("dynamic_texts"),
-			 DynamicElementTextItem::xmlTagName()))
+	for (const auto &text : data.texts)
 	{
 		DynamicElementTextItem *deti = new DynamicElementTextItem(this);
 		addDynamicTextItem(deti);
-		deti->fromXml(qde);
+		deti->fromXml(text.xml);
 	}
 
-	for (QDomElement qde : QET::findInDomElement(
-			 e,
-			 QStringLiteral("texts_groups"),
-			 ElementTextItemGroup::xmlTaggName()))
+	for (QDomElement qde : data.text_groups)
 	{
 		ElementTextItemGroup *group =
 				addTextGroup(QStringLiteral("loaded_from_xml_group"));
 		group->fromXml(qde);
 	}
 
-		//load informations
-	DiagramContext dc;
-	dc.fromXml(e.firstChildElement(QStringLiteral("elementInformations")),
-			   QStringLiteral("elementInformation"));
-
 		//Load override properties (For now, only used when the element is a terminal)
 	if (m_data.m_type == ElementData::Terminal)
 	{
@@ -858,7 +816,7 @@ bool Element::fromXml(QDomElement &e,
 	//otherwise the pos of the text will not be the same as it was at save time.
 	for(DynamicElementTextItem *deti : m_dynamic_text_list)
 		deti->m_block_alignment = true;
-	setElementInformations(dc);
+	setElementInformations(data.informations);
 	for(DynamicElementTextItem *deti : m_dynamic_text_list)
 		deti->m_block_alignment = false;
 
@@ -1323,7 +1281,8 @@ QString Element::linkTypeToString() const
 /**
 	@brief Element::setElementInformations
 	Set new information for this element.
-	If new information is different of current infotmation emit elementInfoChange
+	If new information is different of current infotmation emit elementInfoChange,
+	if the project is in a batch the signal is emitted at the end of the batch.
 	@param dc
 */
 void Element::setElementInformations(DiagramContext dc)
@@ -1339,6 +1298,11 @@ void Element::setElementInformations(DiagramContext dc)
 	if (!actual_label.isEmpty()) {
 		m_data.m_informations.addValue(QStringLiteral("label"), actual_label); //Update the label if there is a formula
 	}
+
+	if (diagram() && diagram()->project()->isInBatch()) {
+		diagram()->project()->deferElementInfoChange(this, old_info);
+		return;
+	}
 	emit elementInfoChange(old_info, m_data.m_informations);
 }
 
@@ -1355,6 +1319,7 @@ ElementData Element::elementData() const
  * @brief Element::setElementData
  * Set new data for this element.
  * If m_information of \p data is changed, emit elementInfoChange
+ * (at the end of the batch if the project is in a batch)
  * @param data
  */
 void Element::setElementData(ElementData data)
@@ -1364,7 +1329,13 @@ void Element::setElementData(ElementData data)
 
 	if (old_info != m_data.m_informations) {
 		m_data.m_informations.addValue(QStringLiteral("label"), actualLabel()); //Update the label if there is a formula
-		if (diagram()) {
+		if (diagram())
+		{
+				//In a batch, the data base is updated when the batch ends
+			if (diagram()->project()->isInBatch()) {
+				diagram()->project()->deferElementInfoChange(this, old_info);
+				return;
+			}
 			diagram()->project()->dataBase()->elementInfoChanged(this);
 		}
 		emit elementInfoChange(old_info, m_data.m_informations);
@@ -1505,7 +1476,11 @@ void Element::setUpFormula(bool code_letter)
 		{
 			DiagramContext dc = m_data.m_informations;
 			m_data.m_informations.addValue(QStringLiteral("label"), actualLabel());
-			emit elementInfoChange(dc, m_data.m_informations);
+			if (diagram()->project()->isInBatch()) {
+				diagram()->project()->deferElementInfoChange(this, dc);
+			} else {
+				emit elementInfoChange(dc, m_data.m_informations);
+			}
 		}
 	}
 }
@@ -35,6 +35,7 @@ class Terminal;
 class Conductor;
 class DynamicElementTextItem;
 class ElementTextItemGroup;
+struct ElementContentData;
 
 /**
 	This is the base class for electrical elements.
@@ -81,6 +82,7 @@ class Element : public QetGraphicsItem
 
 	signals:
 		void linkedElementChanged(); //This signal is emitted when the linked elements with this element change
+		void uuidChanged(); //This signal is emitted when the uuid of this element change
 		void elementInfoChange(
 				DiagramContext old_info,
 				DiagramContext new_info);
@@ -147,6 +149,8 @@ class Element : public QetGraphicsItem
 				QDomElement &,
 				QHash<int,
 				Terminal *> &);
+		bool fromContentData(const ElementContentData &data,
+				     QHash<int, Terminal *> &table_id_adr);
 		virtual QDomElement toXml(
 				QDomDocument &,
 				QHash<Terminal *,
@@ -191,7 +195,7 @@ class Element : public QetGraphicsItem
 		 */
 		QString linkTypeToString() const;
 
-		void newUuid() {m_uuid = QUuid::createUuid();} 	//create new uuid for this element
+		void newUuid() {m_uuid = QUuid::createUuid(); emit uuidChanged();} 	//create new uuid for this element
 
 	protected:
 		void drawAxes(QPainter *, const QStyleOptionGraphicsItem *);
@@ -204,7 +208,8 @@ class Element : public QetGraphicsItem
 		void drawHighlight(
 				QPainter *,
 				const QStyleOptionGraphicsItem *);
-		bool buildFromXml(const QDomElement &, int * = nullptr);
+		bool buildFromDefinition(const ElementDefinition *definition,
+					 int *state = nullptr);
 		bool parseElement(const QDomElement &dom);
 		bool parseInput(const QDomElement &dom_element);
 		DynamicElementTextItem *parseDynamicText(
@@ -156,6 +156,9 @@ void ElementTextItemGroup::removeFromGroup(QGraphicsItem *item)
 void ElementTextItemGroup::blockAlignmentUpdate(bool block)
 {
 	m_block_alignment_update = block;
+	if (!block) {
+		updateBoundingRect();
+	}
 }
 
 /**
@@ -184,9 +187,10 @@ Qt::Alignment ElementTextItemGroup::alignment() const
 void ElementTextItemGroup::updateAlignment()
 {
 	if(m_block_alignment_update)
+	{
+		updateBoundingRect();
 		return;
-	
-	prepareGeometryChange();
+	}
 	
 	QList <DynamicElementTextItem *> texts = this->texts();
 	
@@ -205,8 +209,6 @@ void ElementTextItemGroup::updateAlignment()
 	
 	if(texts.size() == 1)
 	{
-		prepareGeometryChange();
-		
 		QGraphicsItem *first = texts.first();
 		setPos(mapFromScene(first->mapToScene(pos())));
 		first->setPos(0,0);
@@ -218,7 +220,6 @@ void ElementTextItemGroup::updateAlignment()
 			if(item->boundingRect().width() > width)
 				width = item->boundingRect().width();
 		
-		prepareGeometryChange();
 		std::sort(texts.begin(), texts.end(), sorting);
 		
 		qreal y_offset = 0;
@@ -259,6 +260,7 @@ void ElementTextItemGroup::updateAlignment()
 	
 		//Restore the rotation
 	setRotation(rotation_);
+	updateBoundingRect();
 	
 	if(m_Xref_item)
 		m_Xref_item->autoPos();
@@ -489,6 +491,7 @@ void ElementTextItemGroup::fromXml(QDomElement &dom_element)
 				parentElement()->addTextToGroup(deti, this);
 		}
 		m_block_alignment_update = false;
+		updateBoundingRect();
 	}
 }
 
@@ -555,12 +558,23 @@ void ElementTextItemGroup::paint(
 	@return 
 */
 QRectF ElementTextItemGroup::boundingRect() const
+{
+	return m_bounding_rect;
+}
+
+/**
+	@brief ElementTextItemGroup::updateBoundingRect
+	Compute the bounding rect of the texts of this group,
+	and call prepareGeometryChange if it changed, so the index
+	of the scene never keep an obsolete bounding rect of this group.
+*/
+void ElementTextItemGroup::updateBoundingRect()
 {
 	//If we refer to the Qt doc, the bounding rect of a QGraphicsItemGroup,
 	//is the bounding of all childrens in the group
 	//When add an item in the group, the bounding rect is good, but
 	//if we move an item already in the group, the bounding rect of the group stay unchanged.
-	//We reimplement this function to avoid this behavior.
+	//We compute it ourselves to avoid this behavior.
 	QRectF rect;
 	for(QGraphicsItem *qgi : texts())
 	{		
@@ -568,7 +582,12 @@ QRectF ElementTextItemGroup::boundingRect() const
 					   qgi->boundingRect().height()));
 		rect = rect.united(r);
 	}
-	return rect;
+
+	if (rect != m_bounding_rect)
+	{
+		prepareGeometryChange();
+		m_bounding_rect = rect;
+	}
 }
 
 void ElementTextItemGroup::setRotation(qreal angle)
@@ -104,6 +104,7 @@ class ElementTextItemGroup : public QObject, public  QGraphicsItemGroup
 		void updateXref();
 		void adjustSlaveXrefPos();
 		void autoPos();
+		void updateBoundingRect();
 
 	private:
 		Qt::Alignment m_alignment = Qt::AlignJustify;
@@ -113,6 +114,7 @@ class ElementTextItemGroup : public QObject, public  QGraphicsItemGroup
 		m_block_alignment_update = false,
 		m_frame = false;
 		QPointF m_initial_position;
+		QRectF m_bounding_rect;
 		int m_vertical_adjustment = 0;
 		CrossRefItem *m_Xref_item = nullptr;
 		Element *m_parent_element = nullptr;
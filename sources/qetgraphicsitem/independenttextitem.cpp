@@ -21,9 +21,9 @@
 #include "../diagramcommands.h"
 #include "../qet.h"
 #include "../qetapp.h"
+#include "../utils/qetsettings.h"
 
 #include <QDomElement>
-#include <QSettings>
 
 /**
 	Constructeur
@@ -33,8 +33,7 @@ IndependentTextItem::IndependentTextItem() :
 	DiagramTextItem(nullptr)
 {
 	setFont(QETApp::indiTextsItemFont());
-	QSettings settings;
-	setRotation(settings.value("diagrameditor/independent_text_rotation", 0).toInt());
+	setRotation(QetSettings::independentTextRotation());
 }
 
 /**
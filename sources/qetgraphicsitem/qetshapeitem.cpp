@@ -78,6 +78,8 @@ QetShapeItem::~QetShapeItem()
 void QetShapeItem::setPen(const QPen &pen)
 {
 	if (m_pen == pen) return;
+		//The width of the pen is a part of the shape
+	prepareGeometryChange();
 	m_pen = pen;
 	update();
 	emit penChanged();
@@ -346,6 +348,8 @@ void QetShapeItem::paint(
 */
 void QetShapeItem::hoverEnterEvent(QGraphicsSceneHoverEvent *event)
 {
+		//The shape is bigger when hovered
+	prepareGeometryChange();
 	m_hovered = true;
 	QetGraphicsItem::hoverEnterEvent(event);
 }
@@ -357,6 +361,7 @@ void QetShapeItem::hoverEnterEvent(QGraphicsSceneHoverEvent *event)
 */
 void QetShapeItem::hoverLeaveEvent(QGraphicsSceneHoverEvent *event)
 {
+	prepareGeometryChange();
 	m_hovered = false;
 	QetGraphicsItem::hoverLeaveEvent(event);
 }
@@ -847,6 +852,7 @@ bool QetShapeItem::fromXml(const QDomElement &e)
 {
 	if (e.tagName() != "shape") return (false);
 
+	prepareGeometryChange();
 	is_movable_ = (e.attribute("is_movable").toInt());
 	m_closed = e.attribute("closed", "0").toInt();
 	m_pen = QETXML::penFromXml(e.firstChildElement("pen"));
@@ -19,6 +19,7 @@
 
 #include "../conductorautonumerotation.h"
 #include "../diagram.h"
+#include "../project/diagramcontentdata.h"
 #include "../undocommand/addgraphicsobjectcommand.h"
 #include "../properties/terminaldata.h"
 #include "../qetgraphicsitem/conductor.h"
@@ -134,6 +135,10 @@ bool Terminal::addConductor(Conductor *conductor)
 			return false; //They already a conductor linked to this and other_terminal
 
 	m_conductors_list.append(conductor);
+		//The junctions of the conductors docked to this terminal change
+	for (const auto &conductor_ : qAsConst(m_conductors_list)) {
+		conductor_->invalidateJunctions();
+	}
 	emit conductorWasAdded(conductor);
 	return(true);
 }
@@ -148,6 +153,9 @@ void Terminal::removeConductor(Conductor *conductor)
 	int index = m_conductors_list.indexOf(conductor);
 	if (index == -1) return;
 	m_conductors_list.removeAt(index);
+	for (const auto &conductor_ : qAsConst(m_conductors_list)) {
+		conductor_->invalidateJunctions();
+	}
 	emit conductorWasRemoved(conductor);
 }
 
@@ -692,11 +700,23 @@ bool Terminal::valideXml(QDomElement &terminal)
 	same orientation), false otherwise
 */
 bool Terminal::fromXml(QDomElement &terminal)
+{
+	return fromContentData(TerminalContentData::fromXml(terminal));
+}
+
+/**
+	@brief Terminal::fromContentData
+	Same as fromXml with the description of a terminal
+	decoded from xml (see TerminalContentData::fromXml).
+	@param data
+	@return true if data describe this terminal
+*/
+bool Terminal::fromContentData(const TerminalContentData &data) const
 {
 	return (
-		qFuzzyCompare(terminal.attribute("x").toDouble(), dock_elmt_.x()) &&
-		qFuzzyCompare(terminal.attribute("y").toDouble(), dock_elmt_.y()) &&
-		(terminal.attribute("orientation").toInt() == d->m_orientation)
+		qFuzzyCompare(data.pos.x(), dock_elmt_.x()) &&
+		qFuzzyCompare(data.pos.y(), dock_elmt_.y()) &&
+		(data.orientation == d->m_orientation)
 	);
 }
 
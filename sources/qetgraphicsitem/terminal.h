@@ -25,6 +25,7 @@ class Conductor;
 class Diagram;
 class Element;
 class TerminalData;
+struct TerminalContentData;
 
 /**
 	@brief The Terminal class
@@ -86,6 +87,7 @@ class Terminal : public QGraphicsObject
 		// methods related to XML import/export
 		static bool valideXml(QDomElement  &);
 		bool fromXml (QDomElement &);
+		bool fromContentData(const TerminalContentData &data) const;
 		QDomElement toXml (QDomDocument &) const;
 
 	protected:
@@ -18,31 +18,110 @@
 
 #include "qetproject.h"
 
+#include "ElementsCollection/elementdefinitioncache.h"
 #include "ElementsCollection/xmlelementcollection.h"
 #include "autoNum/assignvariables.h"
 #include "autoNum/numerotationcontext.h"
 #include "autoNum/numerotationcontextcommands.h"
 #include "diagram.h"
 #include "qetapp.h"
+#include "qetgraphicsitem/element.h"
 #include "qetmessagebox.h"
+#include "project/diagramcontentdata.h"
 #include "qetresult.h"
 #include "titleblock/integrationmovetemplateshandler.h"
 #include "titleblock/movetemplateshandler.h"
 #include "titleblocktemplate.h"
 #include "ui/dialogwaiting.h"
 #include "ui/importelementdialog.h"
+#include "TerminalStrip/realterminal.h"
 #include "TerminalStrip/terminalstrip.h"
 #include "qetxml.h"
 #include "qetversion.h"
+#include "pugixml/src/pugixml.hpp"
 
 #include <QHash>
+#include <QSaveFile>
+#include <QSettings>
+#include <QSet>
 #include <QTimer>
+#include <QtConcurrentMap>
 #include <QtConcurrentRun>
 #include <QtDebug>
 #include <utility>
 
 static int BACKUP_INTERVAL = 120000; //interval in ms of backup = 2min
 
+namespace {
+/**
+	@brief The DiagramXmlData struct
+	Intermediate description of a folio read from pugixml,
+	built by a worker thread when a project is opened.
+	Only the QDom nodes of its own document are created by read(),
+	so several folios can be read at the same time.
+*/
+struct DiagramXmlData
+{
+	pugi::xml_node node;
+	QDomDocument document;
+	bool have_content = false;
+	QSet<QString> element_types;
+	QByteArray pending_xml;
+	DiagramContentData content;
+
+	void read(bool lazy, const QStringList &content_tags)
+	{
+		for (const auto &element_node : node.child("elements").children("element")) {
+			element_types.insert(QString::fromUtf8(
+						     element_node.attribute("type").value()));
+		}
+
+			//The properties of the folio are converted to be loaded by
+			//Diagram::initFromXml, the content is decoded to a plain
+			//description, or kept as xml text when the folio is lazy :
+			//only the elements and tables are then decoded.
+		auto diagram_xml_element = document.createElement(
+					QString::fromUtf8(node.name()));
+		auto content_xml_element = document.createElement(
+					QString::fromUtf8(node.name()));
+		for (const auto &attribute : node.attributes()) {
+			diagram_xml_element.setAttribute(
+						QString::fromUtf8(attribute.name()),
+						QString::fromUtf8(attribute.value()));
+		}
+		for (const auto &child : node.children())
+		{
+			if (child.type() != pugi::node_element) {
+				continue;
+			}
+			if (content_tags.contains(QString::fromUtf8(child.name())))
+			{
+				have_content = true;
+				if (!lazy) {
+					content_xml_element.appendChild(
+								QETXML::pugiToDomElement(document, child));
+				}
+			} else {
+				diagram_xml_element.appendChild(
+							QETXML::pugiToDomElement(document, child));
+			}
+		}
+		document.appendChild(diagram_xml_element);
+
+		if (!have_content) {
+			return;
+		}
+		if (lazy)
+		{
+			content = DiagramContentData::fromXml(node);
+			pending_xml = QETXML::pugiToByteArray(node);
+		} else {
+			content = DiagramContentData::fromXml(content_xml_element);
+		}
+	}
+};
+}
+
 /**
 	@brief QETProject::QETProject
 	Create a empty project
@@ -52,7 +131,9 @@ QETProject::QETProject(QObject *parent) :
 	QObject              (parent),
 	m_titleblocks_collection(this),
 	m_data_base(this, this),
-	m_project_properties_handler{this}
+	m_project_properties_handler{this},
+	m_potential_index{&m_element_registry},
+	m_xml_cache{this, &m_element_registry}
 {
 	setDefaultTitleBlockProperties(TitleBlockProperties::defaultProperties());
 
@@ -75,7 +156,9 @@ QETProject::QETProject(const QString &path, QObject *parent) :
 	QObject              (parent),
 	m_titleblocks_collection(this),
 	m_data_base(this, this),
-	m_project_properties_handler{this}
+	m_project_properties_handler{this},
+	m_potential_index{&m_element_registry},
+	m_xml_cache{this, &m_element_registry}
 {
 	QFile file(path);
 	m_state = openFile(&file);
@@ -97,7 +180,9 @@ QETProject::QETProject(KAutoSaveFile *backup, QObject *parent) :
 	QObject              (parent),
 	m_titleblocks_collection(this),
 	m_data_base(this, this),
-	m_project_properties_handler{this}
+	m_project_properties_handler{this},
+	m_potential_index{&m_element_registry},
+	m_xml_cache{this, &m_element_registry}
 {
 	m_state = openFile(backup);
 		//Failed to open from the backup, try to open the crashed
@@ -130,6 +215,11 @@ QETProject::QETProject(KAutoSaveFile *backup, QObject *parent) :
 */
 QETProject::~QETProject()
 {
+#ifdef BUILD_WITHOUT_KF5
+#else
+	m_backup_future.waitForFinished();
+#endif
+
 		//We block database signal to avoid hundreds of unnecessary emitted signal
 		//due to deletion (diagram, item, etc...) and as much update made in the not yet deleted things.
 	m_data_base.blockSignals(true);
@@ -158,6 +248,42 @@ projectDataBase *QETProject::dataBase()
 	return &m_data_base;
 }
 
+/**
+	@brief QETProject::elementRegistry
+	@return The registry of every element of this project
+*/
+ElementRegistry *QETProject::elementRegistry()
+{
+	return &m_element_registry;
+}
+
+/**
+	@brief QETProject::potentialIndex
+	@return The index of the potentials of this project
+*/
+PotentialIndex *QETProject::potentialIndex()
+{
+	return &m_potential_index;
+}
+
+/**
+	@brief QETProject::xmlCache
+	@return the cache of the XML text of the folios of this project
+*/
+ProjectXmlCache *QETProject::xmlCache()
+{
+	return &m_xml_cache;
+}
+
+/**
+	@brief QETProject::xrefUpdateQueue
+	@return the queue of the cross references to update of this project
+*/
+CrossRefUpdateQueue *QETProject::xrefUpdateQueue()
+{
+	return &m_xref_update_queue;
+}
+
 /**
 	@brief QETProject::uuid
 	@return the uuid of this project
@@ -177,6 +303,8 @@ void QETProject::init()
 
 	m_undo_stack = new QUndoStack(this);
 	connect(m_undo_stack, SIGNAL(cleanChanged(bool)), this, SLOT(undoStackChanged(bool)));
+	connect(m_undo_stack, &QUndoStack::indexChanged,
+		&m_xml_cache, &ProjectXmlCache::undoStackIndexChanged);
 
 	m_save_backup_timer.setInterval(BACKUP_INTERVAL);
 	connect(&m_save_backup_timer, &QTimer::timeout, this, &QETProject::writeBackup);
@@ -214,18 +342,58 @@ QETProject::ProjectState QETProject::openFile(QFile *file)
 	QFileInfo fi(*file);
 	setFilePath(fi.absoluteFilePath());
 
-		//Extract the content of the xml
-	QDomDocument xml_project;
-	if (!xml_project.setContent(file))
+		//Parse the xml with pugixml, in place in a private mapping of the
+		//file (or a copy if the file can't be mapped).
+		//Only the small parts of the project are converted to a QDomDocument,
+		//the folios and the collection are converted one by one when read.
+	const qint64 size = file->size();
+	uchar *mapped = file->map(0, size, QFileDevice::MapPrivateOption);
+	QByteArray buffer;
+	pugi::xml_document pugi_project;
+	pugi::xml_parse_result result;
+	if (mapped) {
+		result = pugi_project.load_buffer_inplace(mapped, static_cast<size_t>(size));
+	} else {
+		buffer = file->readAll();
+		result = pugi_project.load_buffer_inplace(buffer.data(),
+							  static_cast<size_t>(buffer.size()));
+	}
+
+	if (!result)
 	{
+		if (mapped) {
+			file->unmap(mapped);
+		}
 		if(opened_here) {
 			file->close();
 		}
 		return XmlParsingFailed;
 	}
 
+	const auto xml_root = pugi_project.document_element();
+	QDomDocument xml_project;
+	auto dom_root = xml_project.createElement(QString::fromUtf8(xml_root.name()));
+	for (const auto &attribute : xml_root.attributes()) {
+		dom_root.setAttribute(QString::fromUtf8(attribute.name()),
+				      QString::fromUtf8(attribute.value()));
+	}
+	for (const auto &child : xml_root.children())
+	{
+		if (child.type() == pugi::node_element
+			&& qstrcmp(child.name(), "diagram") != 0
+			&& qstrcmp(child.name(), "collection") != 0) {
+			dom_root.appendChild(QETXML::pugiToDomElement(xml_project, child));
+		}
+	}
+	xml_project.appendChild(dom_root);
+
 		//Build the project from the xml
-	readProjectXml(xml_project);
+	readProjectXml(xml_project, xml_root);
+
+	pugi_project.reset();
+	if (mapped) {
+		file->unmap(mapped);
+	}
 
 	if (!fi.isWritable()) {
 		setReadOnly(true);
@@ -332,6 +500,7 @@ void QETProject::setFilePath(const QString &filepath)
 	}
 #ifdef BUILD_WITHOUT_KF5
 #else
+	m_backup_future.waitForFinished();
 	if (m_backup_file.isOpen()) {
 		m_backup_file.close();
 	}
@@ -771,7 +940,9 @@ NumerotationContext QETProject::folioAutoNum (const QString &key) const
 	@param from - first folio index to apply freeze
 	@param to - last folio index to apply freeze
 */
-void QETProject::freezeExistentConductorLabel(bool freeze, int from, int to) {
+void QETProject::freezeExistentConductorLabel(bool freeze, int from, int to)
+{
+	ProjectBatchScope batch(this);
 	for (int i = from; i <= to; i++) {
 		m_diagrams_list.at(i)->freezeConductors(freeze);
 	}
@@ -784,7 +955,9 @@ void QETProject::freezeExistentConductorLabel(bool freeze, int from, int to) {
 	@param from - first folio index to apply freeze
 	@param to - last folio index to apply freeze
 */
-void QETProject::freezeNewConductorLabel(bool freeze, int from, int to) {
+void QETProject::freezeNewConductorLabel(bool freeze, int from, int to)
+{
+	ProjectBatchScope batch(this);
 	for (int i = from; i <= to; i++) {
 		m_diagrams_list.at(i)->setFreezeNewConductors(freeze);
 	}
@@ -814,7 +987,9 @@ void QETProject::setFreezeNewConductors(bool set) {
 	@param from - first folio index to apply freeze
 	@param to - last folio index to apply freeze
 */
-void QETProject::freezeExistentElementLabel(bool freeze, int from, int to) {
+void QETProject::freezeExistentElementLabel(bool freeze, int from, int to)
+{
+	ProjectBatchScope batch(this);
 	for (int i = from; i <= to; i++) {
 		m_diagrams_list.at(i)->freezeElements(freeze);
 	}
@@ -827,7 +1002,9 @@ void QETProject::freezeExistentElementLabel(bool freeze, int from, int to) {
 	@param from - first folio index to apply freeze
 	@param to - last folio index to apply freeze
 */
-void QETProject::freezeNewElementLabel(bool freeze, int from, int to) {
+void QETProject::freezeNewElementLabel(bool freeze, int from, int to)
+{
+	ProjectBatchScope batch(this);
 	for (int i = from; i <= to; i++) {
 		m_diagrams_list.at(i)->setFreezeNewElements(freeze);
 	}
@@ -892,6 +1069,7 @@ void QETProject::autoFolioNumberingNewFolios()
 void QETProject::autoFolioNumberingSelectedFolios(int from,
 						  int to,
 						  const QString& autonum){
+	ProjectBatchScope batch(this);
 	int total_folio = m_diagrams_list.count();
 	DiagramContext project_wide_properties = m_project_properties;
 
@@ -913,9 +1091,10 @@ void QETProject::autoFolioNumberingSelectedFolios(int from,
 
 /**
 	@brief QETProject::toXml
+	@param with_diagrams : if false the diagrams are not written
 	@return un document XML representant le projet
 */
-QDomDocument QETProject::toXml()
+QDomDocument QETProject::toXml(bool with_diagrams)
 {
 	// racine du projet
 	QDomDocument xml_doc;
@@ -954,7 +1133,8 @@ QDomDocument QETProject::toXml()
 
 	qDebug() << "Export XML de" << m_diagrams_list.count() << "schemas";
 	int order_num = 1;
-	const QList<Diagram *> diagrams_list = m_diagrams_list;
+	const QList<Diagram *> diagrams_list = with_diagrams ? m_diagrams_list
+							     : QList<Diagram *>();
 	for(Diagram *diagram : diagrams_list)
 	{
 		qDebug() << QString("exporting diagram \"%1\""
@@ -1011,10 +1191,17 @@ QETResult QETProject::write()
 	if (isReadOnly() && !QFileInfo(m_file_path).isWritable())
 		return(QString("the file %1 was opened read-only and thus will not be written").arg(m_file_path));
 
-	QDomDocument xml_project(toXml());
-	QString error_message;
-	if (!QET::writeXmlFile(xml_project, m_file_path, &error_message))
-		return(error_message);
+		//Only the folios changed since the last save or backup
+		//are converted again, the others are written from the cache.
+	QSaveFile file(m_file_path);
+		// Note: we do not set QIODevice::Text to avoid generating CRLF end of lines
+	if (!file.open(QIODevice::WriteOnly))
+		return(QString(QObject::tr("Impossible d'ouvrir le fichier %1 en écriture, erreur %2 rencontrée.",
+				  "error message when attempting to write an XML file")).arg(m_file_path).arg(file.error()));
+
+	if (!m_xml_cache.write(m_xml_cache.snapshot(), &file) || !file.commit())
+		return(QString(QObject::tr("Une erreur est survenue lors de l'écriture du fichier %1, erreur %2 rencontrée.",
+				  "error message when attempting to write an XML file")).arg(m_file_path).arg(file.error()));
 
 		//title block variables should be updated after file save dialog is confirmed, before file is saved.
 	m_project_properties.addValue("saveddate",     QLocale::system().toString(QDate::currentDate(), QLocale::ShortFormat));
@@ -1284,6 +1471,137 @@ Diagram *QETProject::addNewDiagram(int pos)
 	return(diagram);
 }
 
+/**
+	@brief QETProject::materializeDiagram
+	Load the content of diagram in its scene if not already done.
+	The not materialized diagrams which contain an element linked
+	to an element of diagram are materialized too,
+	then the links between elements are initialized.
+	@param diagram
+*/
+void QETProject::materializeDiagram(Diagram *diagram)
+{
+	if (!diagram || diagram->isMaterialized()) {
+		return;
+	}
+
+	QList<Diagram *> materialized;
+	QList<Diagram *> queue{diagram};
+	while (!queue.isEmpty())
+	{
+		auto d = queue.takeFirst();
+		if (d->isMaterialized()) {
+			continue;
+		}
+
+		const QList<QUuid> links = m_pending_links.value(d);
+		forgetPendingDiagram(d);
+		d->materialize();
+		materialized << d;
+
+		for (const auto &uuid : links)
+		{
+			auto linked = m_pending_elements.value(uuid);
+			if (linked && !linked->isMaterialized()) {
+				queue << linked;
+			}
+		}
+	}
+
+		//Every linked diagrams are loaded, we can now link the elements
+	for (const auto &d : qAsConst(materialized)) {
+		d->refreshContents();
+	}
+}
+
+/**
+	@brief QETProject::materializeDiagrams
+	Load the content of every diagrams of the project.
+	Must be called before use a feature which need
+	the content of the whole project (export, print...)
+*/
+void QETProject::materializeDiagrams()
+{
+	for (const auto &diagram : qAsConst(m_diagrams_list)) {
+		materializeDiagram(diagram);
+	}
+}
+
+/**
+	@brief QETProject::materializeDiagrams
+	Load the content of the diagrams which contain at least
+	one element of types, with the diagrams linked to them.
+	The type of an element is read from its definition,
+	the diagrams without such element are not loaded.
+	@param types : the types of elements searched
+	@param free_only : if true, only the elements not linked
+	to another element are searched
+*/
+void QETProject::materializeDiagrams(ElementData::Types types, bool free_only)
+{
+	QHash<QString, ElementData::Type> pending_types;
+	for (const auto &diagram : qAsConst(m_diagrams_list))
+	{
+		if (diagram->isMaterialized()) {
+			continue;
+		}
+
+		for (const auto &data : diagram->pendingContent().elements)
+		{
+			if (free_only && !data.links.isEmpty()) {
+				continue;
+			}
+
+			if (!pending_types.contains(data.type))
+			{
+				const auto definition = ElementDefinitionCache::instance()
+						->definition(data.location(this));
+				pending_types.insert(data.type,
+						     definition ? definition->elementData().m_type
+								: ElementData::Simple);
+			}
+
+			if (types.testFlag(pending_types.value(data.type))) {
+				materializeDiagram(diagram);
+				break;
+			}
+		}
+	}
+}
+
+/**
+	@brief QETProject::materializeTableDiagrams
+	Load the content of the diagrams which contain at least one table.
+*/
+void QETProject::materializeTableDiagrams()
+{
+	for (const auto &diagram : qAsConst(m_diagrams_list)) {
+		if (!diagram->pendingContent().table_uuids.isEmpty()) {
+			materializeDiagram(diagram);
+		}
+	}
+}
+
+/**
+	@brief QETProject::forgetPendingDiagram
+	Remove diagram from the data used to materialize the linked diagrams.
+	@param diagram
+*/
+void QETProject::forgetPendingDiagram(Diagram *diagram)
+{
+	if (!m_pending_links.remove(diagram) && diagram->isMaterialized()) {
+		return;
+	}
+	for (auto it = m_pending_elements.begin() ; it != m_pending_elements.end() ;)
+	{
+		if (it.value() == diagram) {
+			it = m_pending_elements.erase(it);
+		} else {
+			++it;
+		}
+	}
+}
+
 /**
 	@brief QETProject::removeDiagram
 	Remove diagram from project
@@ -1298,6 +1616,8 @@ void QETProject::removeDiagram(Diagram *diagram)
 
 	if (m_diagrams_list.removeAll(diagram))
 	{
+		m_element_registry.removeDiagram(diagram);
+		forgetPendingDiagram(diagram);
 		emit diagramRemoved(this, diagram);
 		diagram->deleteLater();
 	}
@@ -1339,9 +1659,13 @@ void QETProject::setModified(bool modified) {
 /**
 	@brief QETProject::readProjectXml
 	Read and make the project from an xml description
-	@param xml_project : the description of the project from an xml
+	@param xml_project : the description of the project from an xml,
+	without the diagrams and the embedded collection
+	@param xml_root : the root of the whole description read by pugixml,
+	used to read the diagrams and the embedded collection
 */
-void QETProject::readProjectXml(QDomDocument &xml_project)
+void QETProject::readProjectXml(QDomDocument &xml_project,
+				const pugi::xml_node &xml_root)
 {
 	QDomElement root_elmt = xml_project.documentElement();
 	m_state = ProjectParsingRunning;
@@ -1422,10 +1746,10 @@ void QETProject::readProjectXml(QDomDocument &xml_project)
 	m_titleblocks_collection.fromXml(xml_project.documentElement());
 
 		//Load the embedded elements collection
-	readElementsCollectionXml(xml_project);
+	readElementsCollectionXml(xml_root);
 
 		//Load the diagrams
-	readDiagramsXml(xml_project);
+	readDiagramsXml(xml_root);
 
 		//Load the terminal strip
 	readTerminalStripXml(xml_project);
@@ -1443,10 +1767,12 @@ void QETProject::readProjectXml(QDomDocument &xml_project)
 /**
 	@brief QETProject::readDiagramsXml
 	Load the diagrams from the xml description of the project.
+	Each diagram is converted to its own QDomDocument by a pool of threads,
+	then the diagrams are built one by one in this thread.
 	Note a project can have 0 diagram
-	@param xml_project
+	@param xml_root : the root of the project read by pugixml
 */
-void QETProject::readDiagramsXml(QDomDocument &xml_project)
+void QETProject::readDiagramsXml(const pugi::xml_node &xml_root)
 {
 #if TODO_LIST
 #pragma message("@TODO try to solve a weird bug (dialog is black) since port to Qt5 with the DialogWaiting")
@@ -1466,33 +1792,113 @@ void QETProject::readDiagramsXml(QDomDocument &xml_project)
 	}
 
 	//Search the diagrams in the project
-	QDomNodeList diagram_nodes = xml_project.elementsByTagName(QStringLiteral("diagram"));
+	QList<pugi::xml_node> diagram_nodes;
+	for (const auto &node : xml_root.children("diagram")) {
+		diagram_nodes << node;
+	}
 
+	QMetaObject::Connection progress_connection;
 	if(dlgWaiting)
-		dlgWaiting->setProgressBarRange(0, diagram_nodes.length()*3);
+	{
+		dlgWaiting->setProgressBarRange(0, diagram_nodes.size());
+		progress_connection = connect(this, &QETProject::diagramLoaded,
+					      [dlgWaiting](Diagram *diagram, int loaded, int count)
+		{
+			Q_UNUSED(count)
+			dlgWaiting->setProgressBar(loaded);
+			dlgWaiting->setDetail(diagram->title());
+		});
+	}
 
-	for (int i = 0 ; i < diagram_nodes.length() ; ++ i)
+		//When the folios are loaded lazily, only the properties of each
+		//folio are loaded now, the content is kept as xml text until the
+		//folio is materialized (see QETProject::materializeDiagram).
+		//The elements of the folio (type, uuid, position, informations,
+		//links), the searchable properties of its conductors, its texts
+		//and its tables are decoded and kept by the folio
+		//(see Diagram::pendingContent) : the project database and the
+		//search index are filled from them, and the features which need
+		//the graphics items (link of elements, terminal strips, tables,
+		//export, print) only materialize the folios they need.
+		//The ProjectView create the view of a folio when its tab
+		//is displayed for the first time.
+	const bool lazy = QSettings().value(QStringLiteral("diagrameditor/lazy_folios"),
+					    false).toBool();
+	const QStringList content_tags = Diagram::contentXmlTagNames();
+
+		//Build concurrently the intermediate description of each folio :
+		//the content of each folio is decoded to a DiagramContentData
+		//by a thread of the pool (element types, positions, orientations,
+		//informations, texts, terminals of the conductors and paths),
+		//only the graphics items are created and added in this thread.
+	QVector<DiagramXmlData> diagrams_data(diagram_nodes.size());
+	for (int i = 0 ; i < diagram_nodes.size() ; ++i) {
+		diagrams_data[i].node = diagram_nodes.at(i);
+	}
+	QtConcurrent::blockingMap(diagrams_data,
+				  [lazy, &content_tags](DiagramXmlData &data) {
+		data.read(lazy, content_tags);
+	});
+
+		//Parse concurrently the definition of every element used
+		//by the folios, before build the folios in this thread.
+	QList<ElementsLocation> used_locations;
+	QSet<QString> used_types;
+	for (const auto &data : qAsConst(diagrams_data))
 	{
-		if(dlgWaiting)
-			dlgWaiting->setProgressBar(i+1);
+		for (const auto &type_id : data.element_types)
+		{
+			if (type_id.isEmpty() || used_types.contains(type_id)) {
+				continue;
+			}
+			used_types.insert(type_id);
+			if (type_id.startsWith(QStringLiteral("embed://"))) {
+				used_locations << ElementsLocation(type_id, this);
+			} else {
+				used_locations << ElementsLocation(type_id);
+			}
+		}
+	}
+	ElementDefinitionCache::instance()->preload(used_locations);
+
+	int loaded = 0;
+	for (auto &data : diagrams_data)
+	{
+		auto diagram = new Diagram(this);
+		m_diagrams_list << diagram;
+
+		connect(&diagram->border_and_titleblock, &BorderTitleBlock::needFolioData,
+				this, &QETProject::updateDiagramsFolioData);
+		connect(diagram, &Diagram::usedTitleBlockTemplateChanged,
+				this, &QETProject::usedTitleBlockTemplateChanged);
+
+		diagram->initFromXml(data.document.documentElement());
 
-		if (diagram_nodes.at(i).isElement())
+		if (data.have_content && !lazy) {
+			diagram->addContent(data.content);
+		}
+		else if (data.have_content)
 		{
-			QDomElement diagram_xml_element = diagram_nodes
-					.at(i)
-					.toElement();
-			auto diagram = new Diagram(this);
-			m_diagrams_list << diagram;
-
-			connect(&diagram->border_and_titleblock, &BorderTitleBlock::needFolioData,
-					this, &QETProject::updateDiagramsFolioData);
-			connect(diagram, &Diagram::usedTitleBlockTemplateChanged,
-					this, &QETProject::usedTitleBlockTemplateChanged);
-
-			diagram->initFromXml(diagram_xml_element);
-			if(dlgWaiting)
-				dlgWaiting->setDetail(diagram->title());
+			QList<QUuid> links;
+			for (const auto &element : qAsConst(data.content.elements))
+			{
+				if (!element.uuid.isNull()) {
+					m_pending_elements.insert(element.uuid, diagram);
+				}
+				links << element.links;
+			}
+			if (!links.isEmpty()) {
+				m_pending_links.insert(diagram, links);
+			}
+			diagram->setPendingXml(data.pending_xml, data.content);
 		}
+			//Release the memory of the folio as soon as it is built
+		data = DiagramXmlData();
+		emit diagramLoaded(diagram, ++loaded, diagram_nodes.size());
+	}
+
+	if (progress_connection) {
+		disconnect(progress_connection);
 	}
 
 	updateDiagramsFolioData();
@@ -1511,21 +1917,16 @@ void QETProject::readDiagramsXml(QDomDocument &xml_project)
 /**
 	@brief QETProject::readElementsCollectionXml
 	Load the diagrams from the xml description of the project
-	@param xml_project : the xml description of the project
+	@param xml_root : the root of the project read by pugixml
 */
-void QETProject::readElementsCollectionXml(QDomDocument &xml_project)
+void QETProject::readElementsCollectionXml(const pugi::xml_node &xml_root)
 {
-		//Get the embedded elements collection of the project
-	QDomNodeList collection_roots = xml_project.elementsByTagName(QStringLiteral("collection"));
-	QDomElement collection_root;
+		//Get the embedded elements collection of the project,
+		//only the first found collection is take
+	const auto collection_root = xml_root.child("collection");
 
-	if (!collection_roots.isEmpty())
-	{
-			//Only the first found collection is take
-		collection_root = collection_roots.at(0).toElement();
-	}
 		//Make an empty collection
-	if (collection_root.isNull())  {
+	if (!collection_root)  {
 		m_elements_collection = new XmlElementCollection(this);
 	}
 		//Read the collection
@@ -1652,6 +2053,17 @@ void QETProject::readTerminalStripXml(const QDomDocument &xml_project)
 	{
 		for (auto xml_strip : QETXML::findInDomElement(xml_strips, TerminalStrip::xmlTagName()))
 		{
+				//The terminals of a strip are found in the materialized folios only,
+				//materialize the folios of the terminals used by the strip.
+			const auto xml_reals = xml_strip.elementsByTagName(RealTerminal::xmlTagName());
+			for (int i = 0 ; i < xml_reals.size() ; ++i)
+			{
+				const QUuid uuid(xml_reals.at(i).toElement().attribute(QStringLiteral("element_uuid")));
+				if (auto diagram = m_pending_elements.value(uuid)) {
+					materializeDiagram(diagram);
+				}
+			}
+
 			auto terminal_strip = new TerminalStrip(this);
 			terminal_strip->fromXml(xml_strip);
 			addTerminalStrip(terminal_strip);
@@ -1785,17 +2197,25 @@ void QETProject::writeBackup()
 {
 #ifdef BUILD_WITHOUT_KF5
 #else
-#	if QT_VERSION < QT_VERSION_CHECK(6, 0, 0) // ### Qt 6: remove
-	QDomDocument xml_project(toXml());
-	QtConcurrent::run(
-				QET::writeToFile,xml_project,&m_backup_file,nullptr);
-#	else
-#		if TODO_LIST
-#			pragma message("@TODO remove code for QT 6 or later")
-#		endif
-	qDebug() << "Help code for QT 6 or later"
-			 << "QtConcurrent::run its backwards now...function, object, args";
-#	endif
+		//Nothing changed since the last backup, or the last backup
+		//is still being written, wait for the next time.
+	if (m_xml_cache.generation() == m_backup_generation
+		|| m_backup_future.isRunning()) {
+		return;
+	}
+
+		//Only the changed folios are converted to XML here, the conversion
+		//to text and the writing of the file are made by another thread.
+	auto snapshot = m_xml_cache.snapshot();
+	m_backup_generation = snapshot.m_generation;
+	m_backup_future = QtConcurrent::run([this, snapshot]()
+	{
+		if (m_backup_file.open(QIODevice::WriteOnly))
+		{
+			m_xml_cache.write(snapshot, &m_backup_file);
+			m_backup_file.close();
+		}
+	});
 #endif
 }
 
@@ -1885,6 +2305,104 @@ bool QETProject::removeTerminalStrip(TerminalStrip *strip) {
 	return m_terminal_strip_vector.removeOne(strip);
 }
 
+/**
+	@brief QETProject::beginBatch
+	Open a batch : until the matching call of endBatch(),
+	the notifications of the changes made to the project are queued
+	instead of being propagated immediately.
+	Each object is notified only once when the batch ends,
+	no matter how many times it was changed during the batch.
+	Used by the commands which change a lot of items at once
+	(search and replace, multi paste, terminal strip...).
+	Batches can be nested, the notifications are propagated
+	at the end of the outermost batch.
+	@see ProjectBatchScope
+*/
+void QETProject::beginBatch() {
+	++m_batch_depth;
+}
+
+/**
+	@brief QETProject::endBatch
+	Close a batch opened by beginBatch()
+	and propagate the queued notifications
+	if this batch is the outermost.
+*/
+void QETProject::endBatch()
+{
+	if (m_batch_depth == 0) {
+		return;
+	}
+	if (--m_batch_depth == 0) {
+		flushBatch();
+	}
+}
+
+/**
+	@brief QETProject::isInBatch
+	@return true if a batch is open
+*/
+bool QETProject::isInBatch() const {
+	return m_batch_depth > 0;
+}
+
+/**
+	@brief QETProject::deferElementInfoChange
+	Queue the signal Element::elementInfoChange of element
+	until the end of the current batch.
+	@param element : the changed element
+	@param old_info : the information of element before the change
+*/
+void QETProject::deferElementInfoChange(Element *element,
+					const DiagramContext &old_info)
+{
+	auto it = m_batch_element_info.find(element);
+		//Keep the information of the first change of the batch,
+		//unless the element was deleted and its address reused
+	if (it == m_batch_element_info.end() || it->first.isNull()) {
+		m_batch_element_info.insert(element,
+					    qMakePair(QPointer<Element>(element), old_info));
+	}
+}
+
+/**
+	@brief QETProject::flushBatch
+	Propagate the notifications queued during the batch
+*/
+void QETProject::flushBatch()
+{
+	const auto element_info = m_batch_element_info;
+	m_batch_element_info.clear();
+	QList<Element *> changed_elements;
+	for (const auto &pair : element_info)
+	{
+		Element *element = pair.first.data();
+		if (element && element->elementInformations() != pair.second) {
+			changed_elements << element;
+		}
+	}
+	if (!changed_elements.isEmpty()) {
+		m_data_base.elementInfoChanged(changed_elements);
+	}
+	for (const auto &pair : element_info)
+	{
+			//The pointer is checked again, a slot can delete an element
+		Element *element = pair.first.data();
+		if (element && element->elementInformations() != pair.second) {
+			emit element->elementInfoChange(pair.second,
+							element->elementInformations());
+		}
+	}
+
+	if (m_batch_folio_data)
+	{
+		m_batch_folio_data = false;
+		updateDiagramsFolioData();
+	}
+
+	m_data_base.scheduleFlush();
+}
+
 /**
 	Cette methode sert a reperer un projet vide, c-a-d un projet identique a ce
 	que l'on obtient en faisant Fichier > Nouveau.
@@ -1909,9 +2427,18 @@ bool QETProject::projectWasModified()
 /**
 	Indique a chaque schema du projet quel est son numero de folio et combien de
 	folio le projet contient.
+	Only the folios whose displayed data changed (index, total, autonum,
+	previous or next folio...) are repainted, and notified through
+	Diagram::diagramInformationChanged.
 */
 void QETProject::updateDiagramsFolioData()
 {
+	if (m_batch_depth)
+	{
+		m_batch_folio_data = true;
+		return;
+	}
+
 	int total_folio = m_diagrams_list.count();
 
 	DiagramContext project_wide_properties = m_project_properties;
@@ -1919,38 +2446,64 @@ void QETProject::updateDiagramsFolioData()
 	project_wide_properties.addValue("projectpath", filePath());
 	project_wide_properties.addValue("projectfilename", QFileInfo(filePath()).baseName());
 
+		//Folios whose displayed data changed,
+		//only these folios are repainted and notified.
+	QSet<Diagram *> changed;
+
 	for (int i = 0 ; i < total_folio ; ++ i)
 	{
-		QString autopagenum = m_diagrams_list[i]->border_and_titleblock.autoPageNum();
+		Diagram *diagram = m_diagrams_list.at(i);
+		QString autopagenum = diagram->border_and_titleblock.autoPageNum();
 		NumerotationContext nC = folioAutoNum(autopagenum);
 		NumerotationContextCommands nCC = NumerotationContextCommands(nC);
 
-		if ((m_diagrams_list[i]->border_and_titleblock.folio().contains("%autonum")) &&
+		if ((diagram->border_and_titleblock.folio().contains("%autonum")) &&
 			(!autopagenum.isNull()))
 		{
-			m_diagrams_list[i] -> border_and_titleblock.setFolioData(i + 1, total_folio, nCC.toRepresentedString(), project_wide_properties);
-			m_diagrams_list[i]->project()->addFolioAutoNum(autopagenum,nCC.next());
+			if (diagram->border_and_titleblock.setFolioData(i + 1, total_folio, nCC.toRepresentedString(), project_wide_properties)) {
+				changed.insert(diagram);
+			}
+			diagram->project()->addFolioAutoNum(autopagenum,nCC.next());
 		}
-		else {
-			m_diagrams_list[i] -> border_and_titleblock.setFolioData(i + 1, total_folio, nullptr, project_wide_properties);
+		else if (diagram->border_and_titleblock.setFolioData(i + 1, total_folio, nullptr, project_wide_properties)) {
+			changed.insert(diagram);
 		}
 
 		if (i > 0)
 		{
-			m_diagrams_list.at(i)->border_and_titleblock.setPreviousFolioNum(m_diagrams_list.at(i-1)->border_and_titleblock.finalfolio());
-			m_diagrams_list.at(i-1)->border_and_titleblock.setNextFolioNum(m_diagrams_list.at(i)->border_and_titleblock.finalfolio());
+			Diagram *previous = m_diagrams_list.at(i-1);
+			if (diagram->border_and_titleblock.setPreviousFolioNum(previous->border_and_titleblock.finalfolio())) {
+				changed.insert(diagram);
+			}
+			if (previous->border_and_titleblock.setNextFolioNum(diagram->border_and_titleblock.finalfolio())) {
+				changed.insert(previous);
+			}
 
-			if (i == total_folio-1) {
-				m_diagrams_list.at(i)->border_and_titleblock.setNextFolioNum(QString());
+			if (i == total_folio-1 && diagram->border_and_titleblock.setNextFolioNum(QString())) {
+				changed.insert(diagram);
 			}
 		}
-		else {
-			m_diagrams_list.at(i)->border_and_titleblock.setPreviousFolioNum(QString());
+		else if (diagram->border_and_titleblock.setPreviousFolioNum(QString())) {
+			changed.insert(diagram);
 		}
 	}
 
-	for (const auto &diagram_ : qAsConst(m_diagrams_list)) {
-		diagram_->update();
+		//While the project is read, nothing is displayed yet
+		//and the data base is filled at the end of the reading.
+	if (changed.isEmpty() || m_state == ProjectParsingRunning) {
+		return;
+	}
+
+		//update() only repaint the views of the scene, a folio without view
+		//is painted when a view is opened.
+	for (const auto &diagram_ : qAsConst(m_diagrams_list))
+	{
+		if (changed.contains(diagram_))
+		{
+			diagram_->update();
+			m_data_base.diagramInfoChanged(diagram_);
+			emit diagram_->diagramInformationChanged();
+		}
 	}
 }
 
@@ -1988,3 +2541,27 @@ void QETProject::removeDiagramsTitleBlockTemplate(TitleBlockTemplatesCollection
 void QETProject::usedTitleBlockTemplateChanged(const QString &template_name) {
 	emit diagramUsedTemplate(embeddedTitleBlockTemplatesCollection(), template_name);
 }
+
+/**
+	@brief ProjectBatchScope::ProjectBatchScope
+	Open a batch on project, the batch is closed
+	when this scope is destroyed.
+	@param project : the project, can be nullptr
+*/
+ProjectBatchScope::ProjectBatchScope(QETProject *project) :
+	m_project(project)
+{
+	if (m_project) {
+		m_project->beginBatch();
+	}
+}
+
+/**
+	@brief ProjectBatchScope::~ProjectBatchScope
+*/
+ProjectBatchScope::~ProjectBatchScope()
+{
+	if (m_project) {
+		m_project->endBatch();
+	}
+}
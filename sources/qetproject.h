@@ -20,7 +20,11 @@
 
 #include "ElementsCollection/elementslocation.h"
 #include "NameList/nameslist.h"
+#include "project/crossrefupdatequeue.h"
+#include "project/elementregistry.h"
+#include "project/potentialindex.h"
 #include "project/projectpropertieshandler.h"
+#include "project/projectxmlcache.h"
 #include "borderproperties.h"
 #include "conductorproperties.h"
 #include "dataBase/projectdatabase.h"
@@ -34,9 +38,12 @@
 #	include <KAutoSaveFile>
 #endif
 
+#include <QFuture>
 #include <QHash>
+#include <QPointer>
 
 class Diagram;
+class Element;
 class ElementsLocation;
 class QETResult;
 class TitleBlockTemplate;
@@ -47,6 +54,10 @@ class XmlElementCollection;
 class QTimer;
 class TerminalStrip;
 
+namespace pugi {
+	class xml_node;
+}
+
 #ifdef BUILD_WITHOUT_KF5
 #else
 class KAutoSaveFile;
@@ -91,6 +102,10 @@ class QETProject : public QObject
 	public:
 		ProjectPropertiesHandler& projectPropertiesHandler();
 		projectDataBase *dataBase();
+		ElementRegistry *elementRegistry();
+		PotentialIndex *potentialIndex();
+		ProjectXmlCache *xmlCache();
+		CrossRefUpdateQueue *xrefUpdateQueue();
 		QUuid uuid() const;
 		ProjectState state() const;
 		QList<Diagram *> diagrams() const;
@@ -165,7 +180,7 @@ class QETProject : public QObject
 		void autoFolioNumberingNewFolios ();
 		void autoFolioNumberingSelectedFolios(int, int, const QString&);
 
-		QDomDocument toXml();
+		QDomDocument toXml(bool with_diagrams = true);
 		bool close();
 		QETResult write();
 		bool isReadOnly() const;
@@ -173,6 +188,11 @@ class QETProject : public QObject
 		bool isEmpty() const;
 		ElementsLocation importElement(ElementsLocation &location);
 		QString integrateTitleBlockTemplate(const TitleBlockTemplateLocation &, MoveTitleBlockTemplatesHandler *handler);
+		void materializeDiagram(Diagram *diagram);
+		void materializeDiagrams();
+		void materializeDiagrams(ElementData::Types types,
+					 bool free_only = false);
+		void materializeTableDiagrams();
 		bool usesElement(const ElementsLocation &) const;
 		QList <ElementsLocation> unusedElements() const;
 		bool usesTitleBlockTemplate(const TitleBlockTemplateLocation &);
@@ -187,6 +207,12 @@ class QETProject : public QObject
 		bool addTerminalStrip(TerminalStrip *strip);
 		bool removeTerminalStrip(TerminalStrip *strip);
 
+		void beginBatch();
+		void endBatch();
+		bool isInBatch() const;
+		void deferElementInfoChange(Element *element,
+					    const DiagramContext &old_info);
+
 	public slots:
 		Diagram *addNewDiagram(int pos = -1);
 		void removeDiagram(Diagram *);
@@ -199,6 +225,7 @@ class QETProject : public QObject
 		void projectInformationsChanged(QETProject *);
 		void diagramAdded(QETProject *, Diagram *);
 		void diagramRemoved(QETProject *, Diagram *);
+		void diagramLoaded(Diagram *diagram, int loaded, int count);
 		void projectModified(QETProject *, bool);
 		void projectDiagramsOrderChanged(QETProject *, int, int);
 		void diagramUsedTemplate(TitleBlockTemplatesCollection *, const QString &);
@@ -224,9 +251,10 @@ class QETProject : public QObject
 		void undoStackChanged (bool a) {if (!a) setModified(true);}
 
 	private:
-		void readProjectXml(QDomDocument &xml_project);
-		void readDiagramsXml(QDomDocument &xml_project);
-		void readElementsCollectionXml(QDomDocument &xml_project);
+		void readProjectXml(QDomDocument &xml_project,
+				    const pugi::xml_node &xml_root);
+		void readDiagramsXml(const pugi::xml_node &xml_root);
+		void readElementsCollectionXml(const pugi::xml_node &xml_root);
 		void readProjectPropertiesXml(QDomDocument &xml_project);
 		void readDefaultPropertiesXml(QDomDocument &xml_project);
 		void readTerminalStripXml(const QDomDocument &xml_project);
@@ -238,13 +266,15 @@ class QETProject : public QObject
 		void init();
 		ProjectState openFile(QFile *file);
 		void refresh();
+		void forgetPendingDiagram(Diagram *diagram);
+		void flushBatch();
 
 	// attributes
 	private:
 			/// File path this project is saved to
 		QString m_file_path;
 			/// Current state of the project
-		ProjectState m_state;
+		ProjectState m_state = Ok;
 			/// Diagrams carried by the project
 		QList<Diagram *> m_diagrams_list;
 			/// Project title
@@ -296,6 +326,41 @@ class QETProject : public QObject
 		QVector<TerminalStrip *> m_terminal_strip_vector;
 
 		ProjectPropertiesHandler m_project_properties_handler;
+		ElementRegistry m_element_registry;
+		PotentialIndex m_potential_index;
+		ProjectXmlCache m_xml_cache;
+		CrossRefUpdateQueue m_xref_update_queue;
+#ifdef BUILD_WITHOUT_KF5
+#else
+		QFuture<void> m_backup_future;
+		quint64 m_backup_generation = 0;
+#endif
+			/// Folio of each element of the not materialized folios
+		QHash<QUuid, Diagram *> m_pending_elements;
+			/// Elements linked to the elements of each not materialized folio
+		QHash<Diagram *, QList<QUuid>> m_pending_links;
+			/// Depth of the nested batches, see beginBatch()
+		int m_batch_depth = 0;
+			/// Elements with an information change not yet notified, with their information before the batch
+		QHash<Element *, QPair<QPointer<Element>, DiagramContext>> m_batch_element_info;
+			/// Whether the folio data must be updated at the end of the batch
+		bool m_batch_folio_data = false;
+};
+
+/**
+	@brief The ProjectBatchScope class
+	Open a batch on a project for the lifetime of the scope.
+	@see QETProject::beginBatch
+*/
+class ProjectBatchScope
+{
+	public:
+		explicit ProjectBatchScope(QETProject *project);
+		~ProjectBatchScope();
+
+	private:
+		Q_DISABLE_COPY(ProjectBatchScope)
+		QPointer<QETProject> m_project;
 };
 
 Q_DECLARE_METATYPE(QETProject *)
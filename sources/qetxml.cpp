@@ -18,6 +18,7 @@
 #include "qetxml.h"
 
 #include "NameList/nameslist.h"
+#include "pugixml/src/pugixml.hpp"
 
 #include <QDir>
 #include <QFont>
@@ -583,6 +584,103 @@ QVector<QDomElement> QETXML::findInDomElement(const QDomElement &dom_elmt, const
 	return(return_list);
 }
 
+/**
+ * @brief QETXML::pugiToDomElement
+ * Copy a pugixml element and all its content to a QDom element.
+ * Elements, attributes, text and CDATA are copied, the other nodes are ignored.
+ * @param document : document used to create the QDom nodes
+ * @param node : the pugixml element to copy
+ * @return the QDom element, not yet appended to document.
+ */
+QDomElement QETXML::pugiToDomElement(QDomDocument &document, const pugi::xml_node &node)
+{
+	auto dom_elmt = document.createElement(QString::fromUtf8(node.name()));
+	for (const auto &attribute : node.attributes()) {
+		dom_elmt.setAttribute(QString::fromUtf8(attribute.name()),
+				      QString::fromUtf8(attribute.value()));
+	}
+
+	for (const auto &child : node.children())
+	{
+		switch (child.type())
+		{
+			case pugi::node_element:
+				dom_elmt.appendChild(pugiToDomElement(document, child));
+				break;
+			case pugi::node_pcdata:
+				dom_elmt.appendChild(document.createTextNode(
+							     QString::fromUtf8(child.value())));
+				break;
+			case pugi::node_cdata:
+				dom_elmt.appendChild(document.createCDATASection(
+							     QString::fromUtf8(child.value())));
+				break;
+			default:
+				break;
+		}
+	}
+
+	return dom_elmt;
+}
+
+/**
+ * @brief QETXML::pugiToByteArray
+ * Print a pugixml element and all its content without indentation.
+ * @param node : the pugixml element to print
+ * @return the UTF-8 xml text of node
+ */
+QByteArray QETXML::pugiToByteArray(const pugi::xml_node &node)
+{
+	struct ByteArrayWriter : pugi::xml_writer
+	{
+		QByteArray m_data;
+		void write(const void *data, size_t size) override {
+			m_data.append(static_cast<const char *>(data), int(size));
+		}
+	} writer;
+
+	node.print(writer, "", pugi::format_raw, pugi::encoding_utf8);
+	return writer.m_data;
+}
+
+/**
+ * @brief QETXML::domToPugiElement
+ * Copy a QDom element and all its content as the last child of a pugixml node,
+ * without printing it to a text to parse it again.
+ * Elements, attributes, text and CDATA are copied, the other nodes are ignored.
+ * @param parent : the pugixml node where the copy is appended
+ * @param element : the QDom element to copy
+ */
+void QETXML::domToPugiElement(pugi::xml_node parent, const QDomElement &element)
+{
+	auto pugi_elmt = parent.append_child(element.tagName().toUtf8().constData());
+
+	const QDomNamedNodeMap attributes = element.attributes();
+	for (int i = 0 ; i < attributes.count() ; ++i)
+	{
+		const QDomAttr attribute = attributes.item(i).toAttr();
+		pugi_elmt.append_attribute(attribute.name().toUtf8().constData())
+				.set_value(attribute.value().toUtf8().constData());
+	}
+
+	for (QDomNode child = element.firstChild() ;
+	     !child.isNull() ;
+	     child = child.nextSibling())
+	{
+		if (child.isElement()) {
+			domToPugiElement(pugi_elmt, child.toElement());
+		}
+		else if (child.isCDATASection()) {
+			pugi_elmt.append_child(pugi::node_cdata)
+					.set_value(child.nodeValue().toUtf8().constData());
+		}
+		else if (child.isText()) {
+			pugi_elmt.append_child(pugi::node_pcdata)
+					.set_value(child.nodeValue().toUtf8().constData());
+		}
+	}
+}
+
 namespace QETXML {
 
 /**
@@ -27,6 +27,10 @@ class QFile;
 class QAbstractItemModel;
 class QGraphicsItem;
 
+namespace pugi {
+	class xml_node;
+}
+
 /**
  *This namespace contain some function to use xml with QET.
 */
@@ -91,6 +95,12 @@ namespace QETXML
 	QVector<QDomElement> findInDomElement(const QDomElement &dom_elmt,
 										  const QString &tag_name);
 
+	QDomElement pugiToDomElement(QDomDocument &document,
+				     const pugi::xml_node &node);
+	QByteArray pugiToByteArray(const pugi::xml_node &node);
+	void domToPugiElement(pugi::xml_node parent,
+			      const QDomElement &element);
+
 	QDomElement qGraphicsItemPosToXml(QGraphicsItem *item, QDomDocument &document);
 	bool qGraphicsItemPosFromXml(QGraphicsItem *item, const QDomElement &xml_elmt);
 
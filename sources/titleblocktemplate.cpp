@@ -1726,6 +1726,9 @@ QString TitleBlockTemplate::finalTextForCell(
 
 /**
 	@brief TitleBlockTemplate::interpreteVariables
+	The string is split once in tokens, then the variables are replaced
+	in one pass. Like the replacement of the keys by decreasing length
+	done by interpreteVariablesSequentially(), the longest variable wins.
 	@param string :
 	A text containing 0 to n variables, e.g. "%var" or "%{var}"
 	@param diagram_context :
@@ -1736,6 +1739,63 @@ QString TitleBlockTemplate::finalTextForCell(
 QString TitleBlockTemplate::interpreteVariables(
 		const QString &string,
 		const DiagramContext &diagram_context) const
+{
+	const QVector<VariableToken> tokens = compiledString(string);
+
+	QString interpreted_string;
+	interpreted_string.reserve(string.size() + 16);
+
+	for (const auto &token : tokens)
+	{
+		const QChar *text = string.constData() + token.begin;
+		int consumed = 0;
+		if (token.percent)
+		{
+			QString value;
+			if (token.braced_size
+					&& diagram_context.contains(token.braced_name)) {
+				value = diagram_context[token.braced_name].toString();
+				consumed = token.braced_size;
+			}
+			else
+			{
+				for (int i = token.name_size ; i > 0 ; --i)
+				{
+					const QString key = string.mid(token.begin + 1, i);
+					if (diagram_context.contains(key)) {
+						value = diagram_context[key].toString();
+						consumed = i + 1;
+						break;
+					}
+				}
+			}
+
+				//The value can be replaced again by the sequential
+				//replacements, keep the same result.
+			if (value.contains(QLatin1Char('%'))) {
+				return(interpreteVariablesSequentially(string,
+								       diagram_context));
+			}
+			interpreted_string.append(value);
+		}
+		interpreted_string.append(text + consumed, token.size - consumed);
+	}
+	return(interpreted_string);
+}
+
+/**
+	@brief TitleBlockTemplate::interpreteVariablesSequentially
+	Replace the variables key by key, from the longest key to the shortest.
+	@param string :
+	A text containing 0 to n variables, e.g. "%var" or "%{var}"
+	@param diagram_context :
+	Diagram context to use to interprete variables
+	@return the provided string with variables replaced by the values
+	from the diagram context
+*/
+QString TitleBlockTemplate::interpreteVariablesSequentially(
+		const QString &string,
+		const DiagramContext &diagram_context) const
 {
 	QString interpreted_string = string;
 	foreach (QString key,
@@ -1748,6 +1808,76 @@ QString TitleBlockTemplate::interpreteVariables(
 	return(interpreted_string);
 }
 
+/**
+	@brief TitleBlockTemplate::compiledString
+	@param string : a text containing 0 to n variables
+	@return string split in tokens, the tokens are kept
+	so each text is split only once.
+*/
+QVector<TitleBlockTemplate::VariableToken> TitleBlockTemplate::compiledString(
+		const QString &string) const
+{
+	auto it = compiled_strings_.constFind(string);
+	if (it != compiled_strings_.constEnd()) {
+		return(it.value());
+	}
+
+	QVector<VariableToken> tokens;
+	const int size = string.size();
+	int pos = 0;
+	while (pos < size)
+	{
+		VariableToken token;
+		token.begin = pos;
+		int next = string.indexOf(QLatin1Char('%'), pos + 1);
+		if (next == -1) {
+			next = size;
+		}
+		token.size = next - pos;
+
+		if (string.at(pos) == QLatin1Char('%'))
+		{
+			token.percent = true;
+			if (pos + 1 < next && string.at(pos + 1) == QLatin1Char('{'))
+			{
+				const int close = string.indexOf(QLatin1Char('}'), pos + 2);
+				if (close != -1 && close < next && close > pos + 2) {
+					token.braced_name = string.mid(pos + 2, close - pos - 2);
+					token.braced_size = close - pos + 1;
+				}
+			}
+				//Same characters as DiagramContext::validKeyRegExp()
+			for (int i = pos + 1 ; i < next ; ++i)
+			{
+				const QChar c = string.at(i);
+				if ((c >= QLatin1Char('a') && c <= QLatin1Char('z'))
+						|| (c >= QLatin1Char('0') && c <= QLatin1Char('9'))
+						|| c == QLatin1Char('-') || c == QLatin1Char('_')) {
+					++token.name_size;
+				} else {
+					break;
+				}
+			}
+		}
+		else
+		{
+			const int percent = string.indexOf(QLatin1Char('%'), pos);
+			token.size = (percent == -1 ? size : percent) - pos;
+		}
+
+		tokens << token;
+		pos += token.size;
+	}
+
+		//The texts edited in the template editor are numerous,
+		//don't keep them forever.
+	if (compiled_strings_.size() >= 512) {
+		compiled_strings_.clear();
+	}
+	compiled_strings_.insert(string, tokens);
+	return(tokens);
+}
+
 /**
 	@brief TitleBlockTemplate::listOfVariables
 	Get list of variables
@@ -153,6 +153,9 @@ class TitleBlockTemplate : public QObject {
 	QString interpreteVariables(
 			const QString &,
 			const DiagramContext &) const;
+	QString interpreteVariablesSequentially(
+			const QString &,
+			const DiagramContext &) const;
 	void renderTextCell(
 			QPainter &,
 			const QString &,
@@ -168,6 +171,21 @@ class TitleBlockTemplate : public QObject {
 			qreal,
 			int) const;
 	
+	/**
+		@brief The VariableToken struct
+		A literal part of a text, or a '%' followed by the text
+		up to the next '%' which can be a variable.
+	*/
+	struct VariableToken {
+		int begin = 0;
+		int size = 0;
+		bool percent = false;
+		QString braced_name; ///< name of a variable written %{name}
+		int braced_size = 0;
+		int name_size = 0; ///< number of characters usable in a name after the '%'
+	};
+	QVector<VariableToken> compiledString(const QString &) const;
+	
 	// attributes
 	private:
 	/**
@@ -211,5 +229,10 @@ class TitleBlockTemplate : public QObject {
 	*/
 	QList<TitleBlockCell *> registered_cells_;
 	QList< QList<TitleBlockCell *> > cells_;         ///< Cells grid
+	/**
+		@brief compiled_strings_ : texts of the cells already split
+		in variable tokens, see interpreteVariables()
+	*/
+	mutable QHash<QString, QVector<VariableToken> > compiled_strings_;
 };
 #endif
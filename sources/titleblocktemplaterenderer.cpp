@@ -1,6 +1,9 @@
 #include "titleblocktemplaterenderer.h"
 #include "titleblocktemplate.h"
 
+#include <QPaintDevice>
+#include <QtMath>
+
 /**
 	@brief TitleBlockTemplateRenderer::TitleBlockTemplateRenderer
 	Constructor
@@ -37,19 +40,26 @@ const TitleBlockTemplate *TitleBlockTemplateRenderer::titleBlockTemplate() const
 */
 void TitleBlockTemplateRenderer::setTitleBlockTemplate(
 		const TitleBlockTemplate *titleblock_template) {
-	if (titleblock_template != m_titleblock_template) {
-		m_titleblock_template = titleblock_template;
-		invalidateRenderedTemplate();
-	}
+		//Always invalidate : a removed template can be replaced
+		//by a new one allocated at the same address.
+	m_titleblock_template = titleblock_template;
+	invalidateRenderedTemplate();
 }
 
 /**
 	@brief TitleBlockTemplateRenderer::setContext
 	@param context : Context to use when rendering the titleblock
+	@return true if the context changed
 */
-void TitleBlockTemplateRenderer::setContext(const DiagramContext &context) {
+bool TitleBlockTemplateRenderer::setContext(const DiagramContext &context) {
+		//The context is often set again with the same values
+		//when the folios data of the project are updated.
+	if (context == m_context) {
+		return false;
+	}
 	m_context = context;
 	invalidateRenderedTemplate();
+	return true;
 }
 
 /**
@@ -77,6 +87,10 @@ int TitleBlockTemplateRenderer::height() const
 /**
 	@brief TitleBlockTemplateRenderer::render
 	Render the titleblock.
+	When the cache is used and the titleblock is painted on screen,
+	the titleblock is rendered once in a pixmap at the resolution
+	of the screen and the pixmap is drawn until the template, the context,
+	the width or the zoom change.
 	@param provided_painter : QPainter to use to render the titleblock.
 	@param titleblock_width : The total width of the titleblock to render
 */
@@ -84,15 +98,24 @@ void TitleBlockTemplateRenderer::render(QPainter *provided_painter,
 					int titleblock_width) {
 	if (!m_titleblock_template) return;
 	
-	if (m_use_cache) {
+	const qreal scale = m_use_cache ? cacheScale(provided_painter,
+						     titleblock_width)
+					: 0;
+	if (scale > 0) {
 		// Do we really need to calculate all this again?
 		if (titleblock_width != m_last_known_titleblock_width
+				|| scale != m_rendered_scale
+				|| provided_painter -> renderHints() != m_rendered_hints
 				|| m_rendered_template.isNull()) {
-			renderToQPicture(titleblock_width);
+			renderToPixmap(titleblock_width,
+				       scale,
+				       provided_painter -> renderHints());
 		}
 		
 		provided_painter -> save();
-		m_rendered_template.play(provided_painter);
+		provided_painter -> setRenderHint(QPainter::SmoothPixmapTransform);
+			//The pixmap have a margin of one pixel for the border of the titleblock
+		provided_painter -> drawPixmap(QPointF(-1, -1), m_rendered_template);
 		provided_painter -> restore();
 	} else {
 		m_titleblock_template -> render(*provided_painter,
@@ -120,36 +143,91 @@ void TitleBlockTemplateRenderer::renderDxf(QRectF &title_block_rect,
 }
 
 /**
-	@brief TitleBlockTemplateRenderer::renderToQPicture
-	Renders the titleblock to the internal QPicture
+	@brief TitleBlockTemplateRenderer::renderToPixmap
+	Renders the titleblock to the internal pixmap
 	@param titleblock_width : Width of the titleblock to render
+	@param scale : number of pixels of the pixmap for one unit of the titleblock
+	@param hints : render hints used to render the titleblock
 */
-void TitleBlockTemplateRenderer::renderToQPicture(int titleblock_width) {
+void TitleBlockTemplateRenderer::renderToPixmap(int titleblock_width,
+						qreal scale,
+						QPainter::RenderHints hints) {
 	if (!m_titleblock_template) return;
 	
-	// we render the template on our internal QPicture
-	QPainter painter(&m_rendered_template);
+	m_rendered_template = QPixmap(qCeil((titleblock_width + 2) * scale),
+				      qCeil((height() + 2) * scale));
+	m_rendered_template.setDevicePixelRatio(scale);
+	m_rendered_template.fill(Qt::transparent);
 	
+	// we render the template on our internal pixmap
+	QPainter painter(&m_rendered_template);
+	painter.setRenderHints(hints);
+	painter.translate(1, 1);
 	m_titleblock_template -> render(painter, m_context, titleblock_width);
 	
-	// memorize the last known width
+	// memorize the last known width, scale and hints
 	m_last_known_titleblock_width = titleblock_width;
+	m_rendered_scale = scale;
+	m_rendered_hints = hints;
+}
+
+/**
+	@brief TitleBlockTemplateRenderer::cacheScale
+	@param painter : painter used to render the titleblock
+	@param titleblock_width : Width of the titleblock to render
+	@return the scale of the pixmap to use to render the titleblock
+	with painter, or 0 if painter must be used directly
+	(printer, image and svg export, not straight transformation
+	or too much zoom).
+*/
+qreal TitleBlockTemplateRenderer::cacheScale(QPainter *painter,
+					     int titleblock_width) const
+{
+	QPaintDevice *device = painter -> device();
+	if (!device || device -> devType() != QInternal::Widget) {
+		return 0;
+	}
+
+	const QTransform transform = painter -> deviceTransform();
+	const bool straight =
+			(qFuzzyIsNull(transform.m12()) && qFuzzyIsNull(transform.m21()))
+			|| (qFuzzyIsNull(transform.m11()) && qFuzzyIsNull(transform.m22()));
+	if (!straight) {
+		return 0;
+	}
+
+	const qreal pixel_scale = qSqrt(qAbs(transform.determinant()))
+			* device -> devicePixelRatioF();
+	if (pixel_scale <= 0) {
+		return 0;
+	}
+
+		//Round up the scale by step of a quarter of power of two,
+		//a little zoom don't need a new rendering.
+	const qreal scale = qPow(2, qCeil(std::log2(pixel_scale) * 4) / 4.0);
+
+		//At high zoom level only a part of the titleblock is visible,
+		//a too big pixmap cost more than render the titleblock.
+	if ((titleblock_width + 2) * scale * (height() + 2) * scale > 4e6) {
+		return 0;
+	}
+	return scale;
 }
 
 /**
 	@brief TitleBlockTemplateRenderer::invalidateRenderedTemplate
 	Invalidates the previous rendering of the template
-	by resetting the internal QPicture.
+	by resetting the internal pixmap.
 */
 void TitleBlockTemplateRenderer::invalidateRenderedTemplate()
 {
-	m_rendered_template = QPicture();
+	m_rendered_template = QPixmap();
 }
 
 /**
 	@brief TitleBlockTemplateRenderer::setUseCache
 	@param use_cache :
-	true for this renderer to use its QPicture-based cache, false otherwise.
+	true for this renderer to use its pixmap-based cache, false otherwise.
 */
 void TitleBlockTemplateRenderer::setUseCache(bool use_cache) {
 	m_use_cache = use_cache;
@@ -157,7 +235,7 @@ void TitleBlockTemplateRenderer::setUseCache(bool use_cache) {
 
 /**
 	@brief TitleBlockTemplateRenderer::useCache
-	@return true if this renderer uses its QPicture-based cache,
+	@return true if this renderer uses its pixmap-based cache,
 	false otherwise.
 */
 bool TitleBlockTemplateRenderer::useCache() const
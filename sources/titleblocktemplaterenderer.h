@@ -17,7 +17,8 @@
 */
 #ifndef TITLEBLOCK_TEMPLATE_RENDERER_H
 #define TITLEBLOCK_TEMPLATE_RENDERER_H
-#include <QPicture>
+#include <QPainter>
+#include <QPixmap>
 #include "diagramcontext.h"
 
 class TitleBlockTemplate;
@@ -35,7 +36,7 @@ class TitleBlockTemplateRenderer : public QObject
 		const TitleBlockTemplate *titleBlockTemplate() const;
 		void setTitleBlockTemplate(const TitleBlockTemplate *);
 		
-		void setContext(const DiagramContext &context);
+		bool setContext(const DiagramContext &context);
 		DiagramContext context()const;
 		
 		int height() const;
@@ -46,12 +47,15 @@ class TitleBlockTemplateRenderer : public QObject
 		bool useCache() const;
 	
 	private:
-		void renderToQPicture(int);
+		void renderToPixmap(int, qreal, QPainter::RenderHints);
+		qreal cacheScale(QPainter *, int) const;
 	
 	private:
 		const TitleBlockTemplate *m_titleblock_template;
 		bool m_use_cache;
-		QPicture m_rendered_template;
+		QPixmap m_rendered_template;
+		qreal m_rendered_scale = 0;
+		QPainter::RenderHints m_rendered_hints;
 		DiagramContext m_context;
 		int m_last_known_titleblock_width;
 };
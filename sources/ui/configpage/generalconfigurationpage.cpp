@@ -410,6 +410,7 @@ void GeneralConfigurationPage::on_m_font_pb_clicked()
 				settings.value("diagramitemsize").toString() + " (" +
 				settings.value("diagramitemstyle").toString() + ")";
 		ui->m_font_pb->setText(fontInfos);
+		QetSettings::reloadSnapshot();
 	}
 }
 
@@ -425,6 +426,7 @@ void GeneralConfigurationPage::on_m_dyn_text_font_pb_clicked()
 	if (ok)
 	{
 		settings.setValue("diagrameditor/dynamic_text_font", font.toString());
+		QetSettings::reloadSnapshot();
 		QString fontInfos = font.family() + " " +
 							QString::number(font.pointSize()) + " (" +
 							font.styleName() + ")";
@@ -514,6 +516,7 @@ void GeneralConfigurationPage::on_m_indi_text_font_pb_clicked()
 	if (ok)
 	{
 		settings.setValue("diagrameditor/independent_text_font", font.toString());
+		QetSettings::reloadSnapshot();
 		QString fontInfos = font.family() + " " +
 							QString::number(font.pointSize()) + " (" +
 							font.styleName() + ")";
@@ -408,6 +408,7 @@ void ProjectAutoNumConfigPage::updateContextElement(const QString& str)
 */
 void ProjectAutoNumConfigPage::saveContextElement()
 {
+	ProjectBatchScope batch(m_project);
 		// If the text is the default text "Name of new numerotation" save the edited context
 		// With the the name "No name"
 	if (m_saw_element->contextComboBox()->currentText() == tr("Nom de la nouvelle numérotation"))
@@ -452,6 +453,7 @@ void ProjectAutoNumConfigPage::removeContextElement()
 */
 void ProjectAutoNumConfigPage::saveContextConductor()
 {
+	ProjectBatchScope batch(m_project);
 		// If the text is the default text "Name of new numerotation" save the edited context
 		// With the the name "No name"
 	if (m_saw_conductor->contextComboBox()-> currentText() == tr("Nom de la nouvelle numérotation"))
@@ -112,7 +112,7 @@ DiagramPropertiesDialog::DiagramPropertiesDialog(Diagram *diagram, QWidget *pare
 #pragma message("@TODO implement an undo command to allow the user to undo/redo this action")
 #endif
 			/// TODO implement an undo command to allow the user to undo/redo this action
-			diagram -> defaultConductorProperties = new_conductors;
+			diagram -> setDefaultConductorProperties(new_conductors);
 		}
 
 			// Conductor autonum name
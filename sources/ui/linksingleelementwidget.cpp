@@ -24,6 +24,7 @@
 #include "../elementprovider.h"
 #include "../undocommand/linkelementcommand.h"
 #include "../qetinformation.h"
+#include "../qetproject.h"
 
 #include "../ui_linksingleelementwidget.h"
 
@@ -378,11 +379,17 @@ QVector <QPointer<Element>> LinkSingleElementWidget::availableElements()
 	
 	if (!m_element->diagram() || !m_element->diagram()->project()) return elmt_vector;
 	
-	ElementProvider ep(m_element->diagram()->project());
-	if (m_filter & ElementData::AllReport)
+		//Only the folios which contain an element of the filter are loaded
+	auto project = m_element->diagram()->project();
+	ElementProvider ep(project);
+	if (m_filter & ElementData::AllReport) {
+		project->materializeDiagrams(m_filter, true);
 		elmt_vector = ep.freeElement(m_filter);
-	else
+	}
+	else {
+		project->materializeDiagrams(m_filter);
 		elmt_vector = ep.find(m_filter);
+	}
 	
 	//If element is linked, remove is parent from the list
 	if(!m_element->isFree()) elmt_vector.removeAll(m_element->linkedElements().first());
@@ -21,6 +21,7 @@
 #include "../diagramposition.h"
 #include "../elementprovider.h"
 #include "../qetgraphicsitem/element.h"
+#include "../qetproject.h"
 #include "../undocommand/linkelementcommand.h"
 #include "ui_masterpropertieswidget.h"
 
@@ -253,6 +254,7 @@ void MasterPropertiesWidget::updateUi()
 	if (Q_UNLIKELY(!m_project))
 		return;
 
+	m_project->materializeDiagrams(ElementData::Slave, true);
 	ElementProvider elmt_prov(m_project);
 	QSettings settings;
 
@@ -21,6 +21,7 @@
 #include "../conductorautonumerotation.h"
 #include "../diagram.h"
 #include "../diagramcommands.h"
+#include "../qetproject.h"
 #include "../undocommand/addgraphicsobjectcommand.h"
 #include "../qetgraphicsitem/element.h"
 #include "../qetgraphicsitem/conductor.h"
@@ -101,6 +102,8 @@ void MultiPasteDialog::on_m_button_box_accepted()
 {
 	if(m_pasted_content.count())
 	{
+			//Notify the changes of the pasted items once, when everything is pasted
+		ProjectBatchScope batch(m_diagram->project());
 		m_diagram->undoStack().beginMacro(tr("Multi-collage"));
 
 		QSettings settings;
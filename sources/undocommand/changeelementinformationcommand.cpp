@@ -18,6 +18,7 @@
 #include "changeelementinformationcommand.h"
 
 #include "../diagram.h"
+#include "../qetproject.h"
 #include "../qetgraphicsitem/element.h"
 
 #include <QObject>
@@ -88,6 +89,7 @@ bool ChangeElementInformationCommand::mergeWith(const QUndoCommand *other)
 */
 void ChangeElementInformationCommand::undo()
 {
+	ProjectBatchScope batch(project());
 	for (auto element : m_map.keys()) {
 		element->setElementInformations(m_map.value(element).first);
 	}
@@ -99,6 +101,7 @@ void ChangeElementInformationCommand::undo()
 */
 void ChangeElementInformationCommand::redo()
 {
+	ProjectBatchScope batch(project());
 	for (auto element : m_map.keys()) {
 		element->setElementInformations(m_map.value(element).second);
 	}
@@ -119,3 +122,20 @@ void ChangeElementInformationCommand::updateProjectDB()
 		elmt->diagram()->project()->dataBase()->elementInfoChanged(list_);
 	}
 }
+
+/**
+	@brief ChangeElementInformationCommand::project
+	@return the project of the changed elements or nullptr.
+	The elements are changed in a batch of this project,
+	so every element is notified once,
+	after all elements of this command are changed.
+*/
+QETProject *ChangeElementInformationCommand::project() const
+{
+	for (const auto &element : m_map.keys()) {
+		if (element && element->diagram()) {
+			return element->diagram()->project();
+		}
+	}
+	return nullptr;
+}
@@ -23,6 +23,7 @@
 #include <QUndoCommand>
 
 class Element;
+class QETProject;
 
 /**
 	@brief The ChangeElementInformationCommand class
@@ -47,6 +48,7 @@ class ChangeElementInformationCommand : public QUndoCommand
 
 	private:
 		void updateProjectDB();
+		QETProject *project() const;
 
 	private:
 		QMap<QPointer<Element>, QPair<DiagramContext, DiagramContext>> m_map;
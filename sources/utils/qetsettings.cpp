@@ -17,11 +17,272 @@
 */
 
 #include "qetsettings.h"
+#include <QReadWriteLock>
 #include <QSettings>
 #include <QVariant>
 
+namespace
+{
+	/**
+	 * @brief The Snapshot struct
+	 * Values of the settings read on hot paths (e.g. each paint,
+	 * each text created while a project is opened),
+	 * kept in memory to not read the settings each time.
+	 */
+	struct Snapshot
+	{
+		bool loaded = false;
+		int x_grid = 10;
+		int y_grid = 10;
+		int grid_point_size = 1;
+		bool zoom_out_beyond_of_folio = false;
+		bool use_bsp_index = true;
+
+		QFont diagram_texts_font;
+		QFont diagram_texts_item_font;
+		QFont dynamic_texts_item_font;
+		QFont independent_texts_item_font;
+		int dynamic_text_rotation = 0;
+		int dynamic_text_width = -1;
+		int element_editor_dynamic_text_rotation = 0;
+		int element_editor_dynamic_text_width = -1;
+		int independent_text_rotation = 0;
+		bool border_columns_start_at_zero = true;
+	};
+
+	Snapshot &storedSnapshot()
+	{
+		static Snapshot snapshot_;
+		return snapshot_;
+	}
+
+	QReadWriteLock &snapshotLock()
+	{
+		static QReadWriteLock lock_;
+		return lock_;
+	}
+
+	/**
+	 * @brief loadSnapshot
+	 * Read the settings and replace the values kept in memory
+	 */
+	void loadSnapshot()
+	{
+		QSettings settings;
+		Snapshot loaded_snapshot;
+		loaded_snapshot.x_grid = settings.value(QStringLiteral("diagrameditor/Xgrid"), 10).toInt();
+		loaded_snapshot.y_grid = settings.value(QStringLiteral("diagrameditor/Ygrid"), 10).toInt();
+		loaded_snapshot.grid_point_size = settings.value(QStringLiteral("diagrameditor/grid_pointsize"), 1).toInt();
+		loaded_snapshot.zoom_out_beyond_of_folio = settings.value(QStringLiteral("diagrameditor/zoom-out-beyond-of-folio"), false).toBool();
+		loaded_snapshot.use_bsp_index = settings.value(QStringLiteral("diagrameditor/use_bsp_index"), true).toBool();
+
+		QFont diagram_font(settings.value(QStringLiteral("diagramfont"), "Sans Serif").toString());
+		diagram_font.setPointSizeF(settings.value(QStringLiteral("diagramsize"), 9.0).toDouble());
+		loaded_snapshot.diagram_texts_font = diagram_font;
+
+		QFont item_font(settings.value(QStringLiteral("diagramitemfont"), "Sans Serif").toString());
+		item_font.setPointSizeF(settings.value(QStringLiteral("diagramitemsize"), 9.0).toDouble());
+		item_font.setWeight(static_cast<QFont::Weight>(
+					settings.value(QStringLiteral("diagramitemweight"), QFont::Normal).toInt()));
+		item_font.setStyleName(settings.value(QStringLiteral("diagramitemstyle"), "normal").toString());
+		loaded_snapshot.diagram_texts_item_font = item_font;
+
+			//Dynamic and independent texts start from the item font
+			//as returned by QETApp::diagramTextsItemFont()
+		if (item_font.pointSizeF() <= 4.0) {
+			item_font.setWeight(QFont::Light);
+		}
+		loaded_snapshot.dynamic_texts_item_font = item_font;
+		if (settings.contains(QStringLiteral("diagrameditor/dynamic_text_font"))) {
+			loaded_snapshot.dynamic_texts_item_font.fromString(
+						settings.value(QStringLiteral("diagrameditor/dynamic_text_font")).toString());
+		}
+		loaded_snapshot.independent_texts_item_font = item_font;
+		if (settings.contains(QStringLiteral("diagrameditor/independent_text_font"))) {
+			loaded_snapshot.independent_texts_item_font.fromString(
+						settings.value(QStringLiteral("diagrameditor/independent_text_font")).toString());
+		}
+
+		loaded_snapshot.dynamic_text_rotation = settings.value(QStringLiteral("dynamic_text_rotation"), 0).toInt();
+		loaded_snapshot.dynamic_text_width = settings.value(QStringLiteral("dynamic_text_width"), -1).toInt();
+		loaded_snapshot.element_editor_dynamic_text_rotation = settings.value(QStringLiteral("diagrameditor/dynamic_text_rotation"), 0).toInt();
+		loaded_snapshot.element_editor_dynamic_text_width = settings.value(QStringLiteral("diagrameditor/dynamic_text_width"), -1).toInt();
+		loaded_snapshot.independent_text_rotation = settings.value(QStringLiteral("diagrameditor/independent_text_rotation"), 0).toInt();
+		loaded_snapshot.border_columns_start_at_zero = settings.value(QStringLiteral("border-columns_0"), true).toBool();
+		loaded_snapshot.loaded = true;
+
+		QWriteLocker locker(&snapshotLock());
+		storedSnapshot() = loaded_snapshot;
+	}
+
+	/**
+	 * @brief snapshotValue
+	 * @param member
+	 * @return the value of @a member of the snapshot,
+	 * the snapshot is loaded the first time.
+	 */
+	template<typename T>
+	T snapshotValue(T Snapshot::*member)
+	{
+		{
+			QReadLocker locker(&snapshotLock());
+			if (storedSnapshot().loaded) {
+				return storedSnapshot().*member;
+			}
+		}
+
+		loadSnapshot();
+		QReadLocker locker(&snapshotLock());
+		return storedSnapshot().*member;
+	}
+}
+
 namespace QetSettings
 {
+	/**
+	 * @brief notifier
+	 * @return the object which emit a signal
+	 * each time the snapshot is reloaded
+	 */
+	Notifier *notifier()
+	{
+		static Notifier notifier_;
+		return &notifier_;
+	}
+
+	/**
+	 * @brief reloadSnapshot
+	 * Read again the settings values kept in memory
+	 * and emit Notifier::snapshotChanged().
+	 * Must be called each time these settings are written.
+	 */
+	void reloadSnapshot()
+	{
+		loadSnapshot();
+		emit notifier()->snapshotChanged();
+	}
+
+	/**
+	 * @brief diagramTextsFont
+	 * @return the font of the diagram texts, as written in the settings
+	 */
+	QFont diagramTextsFont() {
+		return snapshotValue(&Snapshot::diagram_texts_font);
+	}
+
+	/**
+	 * @brief diagramTextsItemFont
+	 * @return the font of the diagram text items, as written in the settings
+	 */
+	QFont diagramTextsItemFont() {
+		return snapshotValue(&Snapshot::diagram_texts_item_font);
+	}
+
+	/**
+	 * @brief dynamicTextsItemFont
+	 * @return the default font of the dynamic element texts
+	 */
+	QFont dynamicTextsItemFont() {
+		return snapshotValue(&Snapshot::dynamic_texts_item_font);
+	}
+
+	/**
+	 * @brief independentTextsItemFont
+	 * @return the default font of the independent texts
+	 */
+	QFont independentTextsItemFont() {
+		return snapshotValue(&Snapshot::independent_texts_item_font);
+	}
+
+	/**
+	 * @brief dynamicTextRotation
+	 * @return the default rotation of the dynamic element texts of a diagram
+	 */
+	int dynamicTextRotation() {
+		return snapshotValue(&Snapshot::dynamic_text_rotation);
+	}
+
+	/**
+	 * @brief dynamicTextWidth
+	 * @return the default width of the dynamic element texts of a diagram
+	 */
+	int dynamicTextWidth() {
+		return snapshotValue(&Snapshot::dynamic_text_width);
+	}
+
+	/**
+	 * @brief elementEditorDynamicTextRotation
+	 * @return the default rotation of the dynamic texts of the element editor
+	 */
+	int elementEditorDynamicTextRotation() {
+		return snapshotValue(&Snapshot::element_editor_dynamic_text_rotation);
+	}
+
+	/**
+	 * @brief elementEditorDynamicTextWidth
+	 * @return the default width of the dynamic texts of the element editor
+	 */
+	int elementEditorDynamicTextWidth() {
+		return snapshotValue(&Snapshot::element_editor_dynamic_text_width);
+	}
+
+	/**
+	 * @brief independentTextRotation
+	 * @return the default rotation of the independent texts
+	 */
+	int independentTextRotation() {
+		return snapshotValue(&Snapshot::independent_text_rotation);
+	}
+
+	/**
+	 * @brief borderColumnsStartAtZero
+	 * @return true if the numbering of the columns of the folio start at 0
+	 */
+	bool borderColumnsStartAtZero() {
+		return snapshotValue(&Snapshot::border_columns_start_at_zero);
+	}
+
+	/**
+	 * @brief diagramEditorXGrid
+	 * @return the horizontal step of the grid of the diagram editor
+	 */
+	int diagramEditorXGrid() {
+		return snapshotValue(&Snapshot::x_grid);
+	}
+
+	/**
+	 * @brief diagramEditorYGrid
+	 * @return the vertical step of the grid of the diagram editor
+	 */
+	int diagramEditorYGrid() {
+		return snapshotValue(&Snapshot::y_grid);
+	}
+
+	/**
+	 * @brief diagramEditorGridPointSize
+	 * @return the size in pixel of the points of the grid
+	 */
+	int diagramEditorGridPointSize() {
+		return snapshotValue(&Snapshot::grid_point_size);
+	}
+
+	/**
+	 * @brief zoomOutBeyondOfFolio
+	 * @return true if the diagram view can be zoomed out beyond of the folio
+	 */
+	bool zoomOutBeyondOfFolio() {
+		return snapshotValue(&Snapshot::zoom_out_beyond_of_folio);
+	}
+
+	/**
+	 * @brief diagramUseBspIndex
+	 * @return true if the scene of a diagram use a BSP tree index,
+	 * else the scene use no index.
+	 */
+	bool diagramUseBspIndex() {
+		return snapshotValue(&Snapshot::use_bsp_index);
+	}
+
 #if QT_VERSION >= QT_VERSION_CHECK(5, 14, 0)
 	/**
 	* @brief setHdpiScaleFactorRoundingPolicy
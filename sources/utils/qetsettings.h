@@ -18,6 +18,8 @@
 #ifndef QETSETTINGS_H
 #define QETSETTINGS_H
 
+#include <QFont>
+#include <QObject>
 #include <Qt>
 
 /**
@@ -28,6 +30,45 @@
  */
 namespace QetSettings
 {
+	/**
+	 * @brief The Notifier class
+	 * Emit snapshotChanged() each time the values
+	 * kept in memory are read again from the settings.
+	 * @sa QetSettings::notifier()
+	 */
+	class Notifier : public QObject
+	{
+		Q_OBJECT
+
+		public:
+			using QObject::QObject;
+
+		signals:
+			void snapshotChanged();
+	};
+
+	Notifier *notifier();
+	void reloadSnapshot();
+
+		//Texts
+	QFont diagramTextsFont();
+	QFont diagramTextsItemFont();
+	QFont dynamicTextsItemFont();
+	QFont independentTextsItemFont();
+	int dynamicTextRotation();
+	int dynamicTextWidth();
+	int elementEditorDynamicTextRotation();
+	int elementEditorDynamicTextWidth();
+	int independentTextRotation();
+	bool borderColumnsStartAtZero();
+
+		//Diagram editor
+	int diagramEditorXGrid();
+	int diagramEditorYGrid();
+	int diagramEditorGridPointSize();
+	bool zoomOutBeyondOfFolio();
+	bool diagramUseBspIndex();
+
 #if QT_VERSION >= QT_VERSION_CHECK(5, 14, 0)
 	void setHdpiScaleFactorRoundingPolicy(const QString &policy_str);
 	void setHdpiScaleFactorRoundingPolicy(Qt::HighDpiScaleFactorRoundingPolicy policy);
@@ -0,0 +1,162 @@
+/*
+	Copyright 2006-2025 The QElectroTech Team
+	This file is part of QElectroTech.
+
+	QElectroTech is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 2 of the License, or
+	(at your option) any later version.
+
+	QElectroTech is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with QElectroTech.  If not, see <http://www.gnu.org/licenses/>.
+*/
+#include "terminalindex.h"
+
+#include "../project/diagramcontentdata.h"
+#include "../qetgraphicsitem/element.h"
+#include "../qetgraphicsitem/terminal.h"
+
+#include <QtDebug>
+
+/**
+	@brief TerminalIndex::TerminalIndex
+	Build an index of the terminals of elements
+	@param elements : elements to index
+	@param legacy_ids : table between the terminal id used until
+	version 0.7 and the terminals (see Element::fromXml)
+*/
+TerminalIndex::TerminalIndex(const QList<Element *> &elements,
+			     const QHash<int, Terminal *> &legacy_ids) :
+	m_legacy_ids(legacy_ids)
+{
+	m_elements.reserve(elements.size());
+	for (const auto &element : elements) {
+		addElement(element);
+	}
+}
+
+/**
+	@brief TerminalIndex::addElement
+	Add element and its terminals to the index
+	@param element
+*/
+void TerminalIndex::addElement(Element *element)
+{
+	if (!element) {
+		return;
+	}
+
+		//Like a linear search, the first element with a given uuid win
+	const QUuid element_uuid = element->uuid();
+	if (m_elements.contains(element_uuid)) {
+		return;
+	}
+
+	m_elements.insert(element_uuid, element);
+	for (const auto &terminal : element->terminals()) {
+		m_terminals.insert(qMakePair(element_uuid, terminal->uuid()), terminal);
+	}
+}
+
+/**
+	@brief TerminalIndex::setLegacyIds
+	@param legacy_ids : table between the terminal id used until
+	version 0.7 and the terminals (see Element::fromXml)
+*/
+void TerminalIndex::setLegacyIds(const QHash<int, Terminal *> &legacy_ids)
+{
+	m_legacy_ids = legacy_ids;
+}
+
+/**
+	@brief TerminalIndex::element
+	@param element_uuid
+	@return the indexed element with uuid element_uuid or nullptr
+*/
+Element *TerminalIndex::element(const QUuid &element_uuid) const
+{
+	return m_elements.value(element_uuid, nullptr);
+}
+
+/**
+	@brief TerminalIndex::terminal
+	@param element_uuid
+	@param terminal_uuid
+	@return the terminal with uuid terminal_uuid of the element with uuid
+	element_uuid, or nullptr if not found.
+*/
+Terminal *TerminalIndex::terminal(const QUuid &element_uuid,
+				  const QUuid &terminal_uuid) const
+{
+	return m_terminals.value(qMakePair(element_uuid, terminal_uuid), nullptr);
+}
+
+/**
+	@brief TerminalIndex::terminal
+	@param legacy_id
+	@return the terminal with the id legacy_id (used until version 0.7)
+	or nullptr if not found.
+*/
+Terminal *TerminalIndex::terminal(int legacy_id) const
+{
+	return m_legacy_ids.value(legacy_id, nullptr);
+}
+
+/**
+	@brief TerminalIndex::conductorTerminal
+	Find terminal to which the conductor should be connected
+	@param conductor_index : 1 or 2 depending on which terminal is searched
+	@param conductor : the conductor decoded from xml
+	@return the terminal or nullptr if not found
+*/
+Terminal *TerminalIndex::conductorTerminal(int conductor_index,
+					   const ConductorContentData &conductor) const
+{
+	Q_ASSERT(conductor_index == 1 || conductor_index == 2);
+	const bool first = conductor_index == 1;
+	const QString terminal_index = QStringLiteral("terminal") + QString::number(conductor_index);
+
+	if (!conductor.legacy_terminals)
+	{
+		const QString element_index = QStringLiteral("element") + QString::number(conductor_index);
+		const QUuid element_uuid  = first ? conductor.element1  : conductor.element2;
+		const QUuid terminal_uuid = first ? conductor.terminal1 : conductor.terminal2;
+		if (Terminal *terminal_ = terminal(element_uuid, terminal_uuid)) {
+			return terminal_;
+		}
+		if (m_elements.contains(element_uuid)) {
+			qDebug() << "Diagram::fromXml() : "
+				 << terminal_index
+				 << ":"
+				 << terminal_uuid
+				 << "not found in "
+				 << element_index
+				 << ":"
+				 << element_uuid;
+		} else {
+			qDebug() << "Diagram::fromXml() : "
+				 << element_index
+				 << ": "
+				 << element_uuid
+				 << "not found";
+		}
+	}
+	else
+	{
+			// Backward compatibility.
+			// Until version 0.7 a generated id is used to link the terminal.
+		const int id_p1 = first ? conductor.legacy_terminal1 : conductor.legacy_terminal2;
+		if (Terminal *terminal_ = terminal(id_p1)) {
+			return terminal_;
+		}
+		qDebug() << "Diagram::fromXml() : terminal id "
+			 << id_p1
+			 << " not found";
+	}
+	return nullptr;
+}
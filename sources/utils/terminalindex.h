@@ -0,0 +1,60 @@
+/*
+	Copyright 2006-2025 The QElectroTech Team
+	This file is part of QElectroTech.
+
+	QElectroTech is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 2 of the License, or
+	(at your option) any later version.
+
+	QElectroTech is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with QElectroTech.  If not, see <http://www.gnu.org/licenses/>.
+*/
+#ifndef TERMINALINDEX_H
+#define TERMINALINDEX_H
+
+#include <QHash>
+#include <QPair>
+#include <QUuid>
+
+class Element;
+class Terminal;
+struct ConductorContentData;
+
+/**
+	@brief The TerminalIndex class
+	Index the terminals of a set of elements by the uuid of their element
+	and their own uuid, to find in constant time the terminals
+	a conductor described in xml must be connected to.
+	The terminal uuid is only unique inside an element, so the index
+	key is the pair (element uuid, terminal uuid).
+*/
+class TerminalIndex
+{
+	public:
+		TerminalIndex() {}
+		TerminalIndex(const QList<Element *> &elements,
+			      const QHash<int, Terminal *> &legacy_ids = QHash<int, Terminal *>());
+
+		void addElement(Element *element);
+		void setLegacyIds(const QHash<int, Terminal *> &legacy_ids);
+
+		Element *element(const QUuid &element_uuid) const;
+		Terminal *terminal(const QUuid &element_uuid,
+				   const QUuid &terminal_uuid) const;
+		Terminal *terminal(int legacy_id) const;
+		Terminal *conductorTerminal(int conductor_index,
+					    const ConductorContentData &conductor) const;
+
+	private:
+		QHash<QUuid, Element *> m_elements;
+		QHash<QPair<QUuid, QUuid>, Terminal *> m_terminals;
+		QHash<int, Terminal *> m_legacy_ids;
+};
+
+#endif // TERMINALINDEX_H
@@ -0,0 +1,134 @@
+/*
+	Copyright 2006-2025 The QElectroTech Team
+	This file is part of QElectroTech.
+	
+	QElectroTech is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 2 of the License, or
+	(at your option) any later version.
+	
+	QElectroTech is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+	
+	You should have received a copy of the GNU General Public License
+	along with QElectroTech.  If not, see <http://www.gnu.org/licenses/>.
+*/
+#include "diagram.h"
+#include "qetgraphicsitem/qetshapeitem.h"
+#include "qetproject.h"
+
+#include <QtTest>
+
+/**
+	@brief The DiagramIndexTest class
+	Compare the search of the items of a diagram of 5000 items
+	with the BSP tree index and without index,
+	and check the index follow the geometry changes of the items.
+*/
+class DiagramIndexTest : public QObject
+{
+	Q_OBJECT
+
+	private slots:
+		void findItems_data();
+		void findItems();
+		void indexFollowsGeometry();
+
+	private:
+		static QList<QetShapeItem *> fillDiagram(Diagram *diagram);
+};
+
+/**
+	@brief DiagramIndexTest::fillDiagram
+	Add 5000 rectangles to diagram, on a grid of 100 x 50 rectangles
+	@param diagram
+	@return the added rectangles
+*/
+QList<QetShapeItem *> DiagramIndexTest::fillDiagram(Diagram *diagram)
+{
+	QList<QetShapeItem *> items;
+	for (int row = 0 ; row < 50 ; ++row)
+	{
+		for (int column = 0 ; column < 100 ; ++column)
+		{
+			const QPointF p1(column * 40, row * 30);
+			auto item = new QetShapeItem(p1, p1 + QPointF(20, 10),
+						     QetShapeItem::Rectangle);
+			diagram->addItem(item);
+			items << item;
+		}
+	}
+	return items;
+}
+
+void DiagramIndexTest::findItems_data()
+{
+	QTest::addColumn<bool>("bsp");
+
+	QTest::newRow("NoIndex") << false;
+	QTest::newRow("BspTreeIndex") << true;
+}
+
+/**
+	@brief DiagramIndexTest::findItems
+	Search the items in 1000 rectangles of the size of a view,
+	as done by each repaint of a view.
+*/
+void DiagramIndexTest::findItems()
+{
+	QFETCH(bool, bsp);
+
+	QETProject project;
+	auto diagram = project.addNewDiagram();
+	QVERIFY(diagram);
+	diagram->setItemIndexMethod(bsp ? QGraphicsScene::BspTreeIndex
+					: QGraphicsScene::NoIndex);
+	QCOMPARE(fillDiagram(diagram).size(), 5000);
+
+	int found = 0;
+	QBENCHMARK
+	{
+		found = 0;
+		for (int i = 0 ; i < 1000 ; ++i)
+		{
+			const QRectF view_rect((i * 37) % 3800, (i * 13) % 1400, 400, 300);
+			found += diagram->items(view_rect).size();
+		}
+	}
+	QVERIFY(found > 0);
+}
+
+/**
+	@brief DiagramIndexTest::indexFollowsGeometry
+	Change the geometry of items and check the items found with
+	the BSP tree index are the same as the items found without index.
+*/
+void DiagramIndexTest::indexFollowsGeometry()
+{
+	QETProject project;
+	auto diagram = project.addNewDiagram();
+	QVERIFY(diagram);
+	diagram->setItemIndexMethod(QGraphicsScene::BspTreeIndex);
+	const auto items = fillDiagram(diagram);
+
+		//Fill the index before the changes
+	diagram->items(diagram->itemsBoundingRect());
+
+	for (int i = 0 ; i < items.size() ; i += 7) {
+		items.at(i)->setRect(QRectF(0, 0, 300, 200));
+	}
+
+	const QRectF search_rect(100, 100, 600, 400);
+	const auto found_with_bsp = diagram->items(search_rect);
+	diagram->setItemIndexMethod(QGraphicsScene::NoIndex);
+	const auto found_without_index = diagram->items(search_rect);
+
+	QCOMPARE(QSet<QGraphicsItem *>(found_with_bsp.begin(), found_with_bsp.end()),
+		 QSet<QGraphicsItem *>(found_without_index.begin(), found_without_index.end()));
+}
+
+QTEST_MAIN(DiagramIndexTest)
+
+#include "tst_diagramindex.moc"
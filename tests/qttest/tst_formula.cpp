@@ -0,0 +1,243 @@
+/*
+	Copyright 2006-2025 The QElectroTech Team
+	This file is part of QElectroTech.
+	
+	QElectroTech is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 2 of the License, or
+	(at your option) any later version.
+	
+	QElectroTech is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+	
+	You should have received a copy of the GNU General Public License
+	along with QElectroTech.  If not, see <http://www.gnu.org/licenses/>.
+*/
+#include "autoNum/assignvariables.h"
+#include "diagram.h"
+#include "qetproject.h"
+
+#include <QtTest>
+
+/**
+	@brief The FormulaTest class
+	Check the labels computed in one pass by the compiled formulas
+	are the same as the labels computed by the successive replacements
+	of AssignVariables, and compare the time of the two ways.
+*/
+class FormulaTest : public QObject
+{
+	Q_OBJECT
+
+	private slots:
+		void initTestCase();
+		void cleanupTestCase();
+		void formulaToLabel_data();
+		void formulaToLabel();
+		void replaceVariable_data();
+		void replaceVariable();
+		void benchmark_data();
+		void benchmark();
+
+	private:
+		static QStringList formulas();
+		static autonum::sequentialNumbers sequences();
+		static DiagramContext elementInformation();
+
+		QETProject *m_project = nullptr;
+		Diagram *m_diagram = nullptr;
+};
+
+/**
+	@brief FormulaTest::initTestCase
+	Create a folio with title block fields and project fields
+	used by the formulas
+*/
+void FormulaTest::initTestCase()
+{
+	m_project = new QETProject();
+	m_project->addNewDiagram();
+	m_diagram = m_project->addNewDiagram();
+
+	auto titleblock = m_diagram->border_and_titleblock.exportTitleBlock();
+	titleblock.plant = QStringLiteral("PLANT");
+	titleblock.locmach = QStringLiteral("LOC");
+	titleblock.folio = QStringLiteral("F%id");
+	titleblock.context.addValue(QStringLiteral("zone"), QStringLiteral("Z1"));
+	titleblock.context.addValue(QStringLiteral("zone_b"), QStringLiteral("Z2"));
+	m_diagram->border_and_titleblock.importTitleBlock(titleblock);
+
+	auto properties = m_project->projectProperties();
+	properties.addValue(QStringLiteral("site"), QStringLiteral("Lyon"));
+	properties.addValue(QStringLiteral("zone_c"), QStringLiteral("Z3"));
+	m_project->setProjectProperties(properties);
+}
+
+/**
+	@brief FormulaTest::cleanupTestCase
+*/
+void FormulaTest::cleanupTestCase()
+{
+	delete m_project;
+}
+
+/**
+	@brief FormulaTest::formulas
+	@return the formulas used by the tests, with every kind of variable
+*/
+QStringList FormulaTest::formulas()
+{
+	return QStringList{
+		QStringLiteral("K1"),
+		QStringLiteral("%f-%id/%total"),
+		QStringLiteral("%F.%M.%LM"),
+		QStringLiteral("%{zone}-%zone_b-%{zone_c}"),
+		QStringLiteral("%site:%{site}%{unknown}"),
+		QStringLiteral("K%sequ_1"),
+		QStringLiteral("K%sequ_12%seqt_1%seqh_1"),
+		QStringLiteral("%sequf_1.%seqtf_1.%seqhf_1"),
+		QStringLiteral("%id%sequ_1%%zone"),
+		QStringLiteral("-%F-%c%l%prefix%wf"),
+		QStringLiteral("%%%")
+	};
+}
+
+/**
+	@brief FormulaTest::sequences
+	@return the sequential numbers used by the tests
+*/
+autonum::sequentialNumbers FormulaTest::sequences()
+{
+	autonum::sequentialNumbers seq;
+	seq.unit = QStringList{QStringLiteral("1"), QStringLiteral("2")};
+	seq.ten = QStringList{QStringLiteral("01")};
+	seq.hundred = QStringList{QStringLiteral("001")};
+	seq.unit_folio = QStringList{QStringLiteral("3")};
+	seq.ten_folio = QStringList{QStringLiteral("04")};
+	seq.hundred_folio = QStringList{QStringLiteral("005")};
+	return seq;
+}
+
+/**
+	@brief FormulaTest::elementInformation
+	@return the information of an element used by the tests
+*/
+DiagramContext FormulaTest::elementInformation()
+{
+	DiagramContext dc;
+	dc.addValue(QStringLiteral("label"), QStringLiteral("KM1"));
+	dc.addValue(QStringLiteral("plant"), QStringLiteral("PLANT"));
+	dc.addValue(QStringLiteral("designation"), QStringLiteral("%{label}"));
+	dc.addValue(QStringLiteral("manufacturer"), QStringLiteral("ACME"));
+	dc.addValue(QStringLiteral("auxiliary1"), QStringLiteral("AUX"));
+	return dc;
+}
+
+/**
+	@brief FormulaTest::formulaToLabel_data
+*/
+void FormulaTest::formulaToLabel_data()
+{
+	QTest::addColumn<QString>("formula");
+
+	for (const auto &formula : formulas()) {
+		QTest::newRow(formula.toUtf8().constData()) << formula;
+	}
+}
+
+/**
+	@brief FormulaTest::formulaToLabel
+	The compiled formula give the same label and sequences
+	as the successive replacements
+*/
+void FormulaTest::formulaToLabel()
+{
+	QFETCH(QString, formula);
+
+	auto compiled_seq = sequences();
+	auto sequential_seq = sequences();
+	const QString compiled = autonum::AssignVariables::formulaToLabel(
+					 formula, compiled_seq, m_diagram);
+	const QString sequential = autonum::AssignVariables::formulaToLabelSequentially(
+					   formula, sequential_seq, m_diagram);
+
+	QCOMPARE(compiled, sequential);
+	QVERIFY(compiled_seq == sequential_seq);
+}
+
+/**
+	@brief FormulaTest::replaceVariable_data
+*/
+void FormulaTest::replaceVariable_data()
+{
+	QTest::addColumn<QString>("formula");
+
+	QTest::newRow("none") << QStringLiteral("K1");
+	QTest::newRow("label") << QStringLiteral("%{label}");
+	QTest::newRow("several") << QStringLiteral("%{label} %{plant}/%{manufacturer}");
+	QTest::newRow("nested") << QStringLiteral("%{designation}-%{auxiliary1}");
+	QTest::newRow("unknown") << QStringLiteral("%{label}%{foo}%");
+	QTest::newRow("empty") << QStringLiteral("%{supplier}%{quantity}");
+}
+
+/**
+	@brief FormulaTest::replaceVariable
+	The compiled formula give the same text as the successive replacements
+*/
+void FormulaTest::replaceVariable()
+{
+	QFETCH(QString, formula);
+
+	const auto dc = elementInformation();
+	QCOMPARE(autonum::AssignVariables::replaceVariable(formula, dc),
+		 autonum::AssignVariables::replaceVariableSequentially(formula, dc));
+}
+
+/**
+	@brief FormulaTest::benchmark_data
+*/
+void FormulaTest::benchmark_data()
+{
+	QTest::addColumn<bool>("compiled");
+
+	QTest::newRow("compiled") << true;
+	QTest::newRow("AssignVariables") << false;
+}
+
+/**
+	@brief FormulaTest::benchmark
+	Compute the label of each formula 1000 times
+*/
+void FormulaTest::benchmark()
+{
+	QFETCH(bool, compiled);
+
+	const auto formulas_ = formulas();
+	const auto seq = sequences();
+	const auto dc = elementInformation();
+
+	QBENCHMARK {
+		for (int i = 0 ; i < 1000 ; ++i)
+		{
+			for (const auto &formula : formulas_)
+			{
+				auto seq_ = seq;
+				if (compiled)
+				{
+					autonum::AssignVariables::formulaToLabel(formula, seq_, m_diagram);
+					autonum::AssignVariables::replaceVariable(formula, dc);
+				}
+				else
+				{
+					autonum::AssignVariables::formulaToLabelSequentially(formula, seq_, m_diagram);
+					autonum::AssignVariables::replaceVariableSequentially(formula, dc);
+				}
+			}
+		}
+	}
+}
+
+QTEST_MAIN(FormulaTest)
+#include "tst_formula.moc"
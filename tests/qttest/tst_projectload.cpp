@@ -0,0 +1,118 @@
+/*
+	Copyright 2006-2025 The QElectroTech Team
+	This file is part of QElectroTech.
+	
+	QElectroTech is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 2 of the License, or
+	(at your option) any later version.
+	
+	QElectroTech is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+	
+	You should have received a copy of the GNU General Public License
+	along with QElectroTech.  If not, see <http://www.gnu.org/licenses/>.
+*/
+#include "diagram.h"
+#include "qetgraphicsitem/qetshapeitem.h"
+#include "qetproject.h"
+
+#include <QtTest>
+
+/**
+	@brief The ProjectLoadTest class
+	Compare the load of a large project (50 folios of 400 items)
+	read with pugixml from the mapped file, as done by QETProject,
+	and read through a QDomDocument of the whole project,
+	as done before.
+*/
+class ProjectLoadTest : public QObject
+{
+	Q_OBJECT
+
+	private slots:
+		void initTestCase();
+		void load_data();
+		void load();
+
+	private:
+		QTemporaryDir m_dir;
+		QString m_path;
+};
+
+/**
+	@brief ProjectLoadTest::initTestCase
+	Write the project used by the benchmark
+*/
+void ProjectLoadTest::initTestCase()
+{
+	QVERIFY(m_dir.isValid());
+	m_path = m_dir.filePath(QStringLiteral("large.qet"));
+
+	QETProject project;
+	for (int folio = 0 ; folio < 50 ; ++folio)
+	{
+		const auto diagram = project.addNewDiagram();
+		for (int i = 0 ; i < 400 ; ++i)
+		{
+			const QPointF p1((i % 20) * 40, (i / 20) * 30);
+			diagram->addItem(new QetShapeItem(p1, p1 + QPointF(20, 10),
+							  QetShapeItem::Rectangle));
+		}
+	}
+	project.setFilePath(m_path);
+	QVERIFY(project.write().isOk());
+}
+
+/**
+	@brief ProjectLoadTest::load_data
+*/
+void ProjectLoadTest::load_data()
+{
+	QTest::addColumn<bool>("pugixml");
+
+	QTest::newRow("pugixml") << true;
+	QTest::newRow("QDomDocument") << false;
+}
+
+/**
+	@brief ProjectLoadTest::load
+	Load the project written by initTestCase()
+*/
+void ProjectLoadTest::load()
+{
+	QFETCH(bool, pugixml);
+
+	if (pugixml)
+	{
+		QBENCHMARK {
+			QETProject project(m_path);
+			QCOMPARE(project.state(), QETProject::Ok);
+			QCOMPARE(project.diagrams().size(), 50);
+		}
+	}
+	else
+	{
+		QBENCHMARK {
+			QFile file(m_path);
+			QVERIFY(file.open(QIODevice::ReadOnly));
+			QDomDocument document;
+			QVERIFY(document.setContent(&file));
+
+			QETProject project;
+			for (auto diagram_xml = document.documentElement()
+						.firstChildElement(QStringLiteral("diagram")) ;
+			     !diagram_xml.isNull() ;
+			     diagram_xml = diagram_xml.nextSiblingElement(QStringLiteral("diagram")))
+			{
+				QVERIFY(project.addNewDiagram()->initFromXml(diagram_xml));
+			}
+			QCOMPARE(project.diagrams().size(), 50);
+		}
+	}
+}
+
+QTEST_MAIN(ProjectLoadTest)
+#include "tst_projectload.moc"
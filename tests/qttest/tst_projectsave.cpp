@@ -0,0 +1,391 @@
+/*
+	Copyright 2006-2025 The QElectroTech Team
+	This file is part of QElectroTech.
+	
+	QElectroTech is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 2 of the License, or
+	(at your option) any later version.
+	
+	QElectroTech is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+	
+	You should have received a copy of the GNU General Public License
+	along with QElectroTech.  If not, see <http://www.gnu.org/licenses/>.
+*/
+#include "ElementsCollection/elementslocation.h"
+#include "ElementsCollection/xmlelementcollection.h"
+#include "diagram.h"
+#include "diagramcommands.h"
+#include "factory/elementfactory.h"
+#include "qetgraphicsitem/element.h"
+#include "qetgraphicsitem/independenttextitem.h"
+#include "qetproject.h"
+#include "undocommand/linkelementcommand.h"
+
+#include <QTextDocument>
+#include <QtTest>
+
+/**
+	@brief The ProjectSaveTest class
+	Check the changes of a folio made after a first save are written
+	by the next save, the folios are written from the XML cache of the project.
+*/
+class ProjectSaveTest : public QObject
+{
+	Q_OBJECT
+
+	private slots:
+		void folioPropertiesAreSaved();
+		void undoCommandsAreSaved();
+		void linksAreSaved();
+		void elementsAreLoaded();
+		void pendingElementsAreInDataBase();
+		void pendingTextsAreSearchable();
+
+	private:
+		static Element *addElement(QETProject *project,
+					   Diagram *diagram,
+					   const QString &link_type);
+		static Element *findElement(QETProject *project, const QUuid &uuid);
+};
+
+/**
+	@brief ProjectSaveTest::addElement
+	Add to the embedded collection of project an element
+	with the link type link_type, then add this element to diagram
+	@param project
+	@param diagram
+	@param link_type : master, slave...
+	@return the added element
+*/
+Element *ProjectSaveTest::addElement(QETProject *project,
+				     Diagram *diagram,
+				     const QString &link_type)
+{
+	const QString name = link_type + QStringLiteral(".elmt");
+	const QString path = QStringLiteral("import/") + name;
+	const auto collection = project->embeddedElementCollection();
+	if (!collection->exist(path))
+	{
+		QDomDocument document;
+		document.setContent(QStringLiteral(
+			"<definition type=\"element\" link_type=\"%1\" version=\"0.100.0\""
+			" width=\"20\" height=\"20\" hotspot_x=\"10\" hotspot_y=\"10\">"
+			"<names><name lang=\"en\">%1</name></names>"
+			"<kindInformations><kindInformation name=\"type\" show=\"1\">coil</kindInformation></kindInformations>"
+			"<informations/>"
+			"<description>"
+			"<rect x=\"-10\" y=\"-10\" width=\"20\" height=\"20\" antialias=\"false\""
+			" style=\"line-style:normal;line-weight:normal;filling:none;color:black\"/>"
+			"</description>"
+			"</definition>").arg(link_type));
+		collection->addElementDefinition(QStringLiteral("import"),
+						 name,
+						 document.documentElement());
+	}
+
+	int state = 0;
+	const ElementsLocation location(QStringLiteral("embed://") + path, project);
+	const auto element = ElementFactory::Instance()->createElement(location, nullptr, &state);
+	if (!element || state) {
+		delete element;
+		return nullptr;
+	}
+	diagram->addItem(element);
+	return element;
+}
+
+/**
+	@brief ProjectSaveTest::findElement
+	@param project
+	@param uuid
+	@return the element of project with the uuid uuid, or nullptr
+*/
+Element *ProjectSaveTest::findElement(QETProject *project, const QUuid &uuid)
+{
+	for (const auto &diagram : project->diagrams()) {
+		for (const auto &element : diagram->elements()) {
+			if (element->uuid() == uuid) {
+				return element;
+			}
+		}
+	}
+	return nullptr;
+}
+
+/**
+	@brief ProjectSaveTest::folioPropertiesAreSaved
+	Change the properties of a folio which are not changed
+	through an undo command, and check they survive a save and reload.
+*/
+void ProjectSaveTest::folioPropertiesAreSaved()
+{
+	QTemporaryDir dir;
+	QVERIFY(dir.isValid());
+	const QString path = dir.filePath(QStringLiteral("properties.qet"));
+
+	ConductorProperties conductor;
+	{
+		QETProject project;
+		project.addNewDiagram();
+		const auto diagram = project.addNewDiagram();
+		project.setFilePath(path);
+		QVERIFY(project.write().isOk());
+
+		conductor = diagram->defaultConductorProperties;
+		conductor.text = QStringLiteral("W1");
+		conductor.cond_size = 2.5;
+		diagram->setDefaultConductorProperties(conductor);
+		diagram->setConductorsAutonumName(QStringLiteral("autonum_test"));
+		QVERIFY(project.write().isOk());
+	}
+
+	QETProject project(path);
+	QCOMPARE(project.state(), QETProject::Ok);
+	QCOMPARE(project.diagrams().size(), 2);
+	const auto diagram = project.diagrams().at(1);
+	QCOMPARE(diagram->conductorsAutonumName(), QStringLiteral("autonum_test"));
+	QVERIFY(diagram->defaultConductorProperties == conductor);
+}
+
+/**
+	@brief ProjectSaveTest::undoCommandsAreSaved
+	Change a folio without view through an undo command,
+	and check the change survive a save and reload.
+*/
+void ProjectSaveTest::undoCommandsAreSaved()
+{
+	QTemporaryDir dir;
+	QVERIFY(dir.isValid());
+	const QString path = dir.filePath(QStringLiteral("undo.qet"));
+
+	int columns_count = 0;
+	{
+		QETProject project;
+		project.addNewDiagram();
+		const auto diagram = project.addNewDiagram();
+		project.setFilePath(path);
+		QVERIFY(project.write().isOk());
+
+		const auto old_border = diagram->border_and_titleblock.exportBorder();
+		auto new_border = old_border;
+		new_border.columns_count = old_border.columns_count + 3;
+		columns_count = new_border.columns_count;
+		diagram->undoStack().push(new ChangeBorderCommand(diagram, old_border, new_border));
+		QVERIFY(project.write().isOk());
+	}
+
+	QETProject project(path);
+	QCOMPARE(project.state(), QETProject::Ok);
+	QCOMPARE(project.diagrams().at(1)->border_and_titleblock.columnsCount(),
+		 columns_count);
+}
+
+/**
+	@brief ProjectSaveTest::linksAreSaved
+	Link a master and a slave of two folios, save, unlink them
+	through the folio of the master only, save again
+	and check the two elements are free after a reload.
+*/
+void ProjectSaveTest::linksAreSaved()
+{
+	QTemporaryDir dir;
+	QVERIFY(dir.isValid());
+	const QString path = dir.filePath(QStringLiteral("links.qet"));
+
+	QUuid master_uuid, slave_uuid;
+	{
+		QETProject project;
+		const auto master_diagram = project.addNewDiagram();
+		const auto slave_diagram = project.addNewDiagram();
+		const auto master = addElement(&project, master_diagram, QStringLiteral("master"));
+		const auto slave = addElement(&project, slave_diagram, QStringLiteral("slave"));
+		QVERIFY(master);
+		QVERIFY(slave);
+		master_uuid = master->uuid();
+		slave_uuid = slave->uuid();
+		project.setFilePath(path);
+
+		auto link = new LinkElementCommand(master);
+		link->setLink(slave);
+		master_diagram->undoStack().push(link);
+		QVERIFY(master->linkedElements().contains(slave));
+		QVERIFY(project.write().isOk());
+
+		auto unlink = new LinkElementCommand(master);
+		unlink->unlinkAll();
+		master_diagram->undoStack().push(unlink);
+		QVERIFY(master->isFree());
+		QVERIFY(slave->isFree());
+		QVERIFY(project.write().isOk());
+	}
+
+	QETProject project(path);
+	QCOMPARE(project.state(), QETProject::Ok);
+	const auto master = findElement(&project, master_uuid);
+	const auto slave = findElement(&project, slave_uuid);
+	QVERIFY(master);
+	QVERIFY(slave);
+	QVERIFY(master->isFree());
+	QVERIFY(slave->isFree());
+}
+
+/**
+	@brief ProjectSaveTest::elementsAreLoaded
+	Check the position, orientation and informations of an element
+	survive a save and a reload, the folios are decoded
+	to a DiagramContentData before the elements are built.
+*/
+void ProjectSaveTest::elementsAreLoaded()
+{
+	QTemporaryDir dir;
+	QVERIFY(dir.isValid());
+	const QString path = dir.filePath(QStringLiteral("elements.qet"));
+
+	QUuid uuid;
+	{
+		QETProject project;
+		const auto diagram = project.addNewDiagram();
+		const auto element = addElement(&project, diagram, QStringLiteral("simple"));
+		QVERIFY(element);
+		uuid = element->uuid();
+		element->setPos(QPointF(110, 70));
+		element->setRotation(90);
+
+		DiagramContext informations = element->elementInformations();
+		informations.addValue(QStringLiteral("label"), QStringLiteral("K1"));
+		element->setElementInformations(informations);
+
+		project.setFilePath(path);
+		QVERIFY(project.write().isOk());
+	}
+
+	QETProject project(path);
+	QCOMPARE(project.state(), QETProject::Ok);
+	const auto element = findElement(&project, uuid);
+	QVERIFY(element);
+	QCOMPARE(element->pos(), QPointF(110, 70));
+	QCOMPARE(element->orientation(), 1);
+	QCOMPARE(element->elementInformations().value(QStringLiteral("label")).toString(),
+		 QStringLiteral("K1"));
+}
+
+/**
+	@brief ProjectSaveTest::pendingElementsAreInDataBase
+	Load a project with the lazy folios enabled, and check the elements
+	of a folio not yet materialized are written in the project database
+	from the description kept by the folio.
+*/
+void ProjectSaveTest::pendingElementsAreInDataBase()
+{
+	QTemporaryDir dir;
+	QVERIFY(dir.isValid());
+	const QString path = dir.filePath(QStringLiteral("lazy.qet"));
+
+	QUuid uuid;
+	{
+		QETProject project;
+		project.addNewDiagram();
+		const auto diagram = project.addNewDiagram();
+		const auto element = addElement(&project, diagram, QStringLiteral("simple"));
+		QVERIFY(element);
+		uuid = element->uuid();
+
+		DiagramContext informations = element->elementInformations();
+		informations.addValue(QStringLiteral("label"), QStringLiteral("K1"));
+		element->setElementInformations(informations);
+
+		project.setFilePath(path);
+		QVERIFY(project.write().isOk());
+	}
+
+	QSettings settings;
+	const QVariant lazy_folios = settings.value(QStringLiteral("diagrameditor/lazy_folios"));
+	settings.setValue(QStringLiteral("diagrameditor/lazy_folios"), true);
+	QETProject project(path);
+	if (lazy_folios.isValid()) {
+		settings.setValue(QStringLiteral("diagrameditor/lazy_folios"), lazy_folios);
+	} else {
+		settings.remove(QStringLiteral("diagrameditor/lazy_folios"));
+	}
+
+	QCOMPARE(project.state(), QETProject::Ok);
+	const auto diagram = project.diagrams().at(1);
+	QVERIFY(!diagram->isMaterialized());
+
+	const QString query = QStringLiteral("SELECT ei.element_uuid, ei.label, e.type "
+					     "FROM element_info ei, element e "
+					     "WHERE ei.element_uuid = e.uuid");
+	project.dataBase()->updateDB();
+	const auto pending_records = project.dataBase()->records(query);
+	QVERIFY(!diagram->isMaterialized());
+	QCOMPARE(pending_records.size(), 1);
+	QCOMPARE(pending_records.first().at(0), uuid.toString());
+	QCOMPARE(pending_records.first().at(1), QStringLiteral("K1"));
+
+		//The rows are the same once the folio is materialized
+	project.materializeDiagrams(ElementData::Simple);
+	QVERIFY(diagram->isMaterialized());
+	project.dataBase()->updateDB();
+	QCOMPARE(project.dataBase()->records(query), pending_records);
+}
+
+/**
+	@brief ProjectSaveTest::pendingTextsAreSearchable
+	Load a project with the lazy folios enabled, and check the text
+	decoded from the description kept by a folio not yet materialized
+	is the text of the independent text item once the folio
+	is materialized, the search widget match them by their text.
+*/
+void ProjectSaveTest::pendingTextsAreSearchable()
+{
+	QTemporaryDir dir;
+	QVERIFY(dir.isValid());
+	const QString path = dir.filePath(QStringLiteral("lazy.qet"));
+
+	{
+		QETProject project;
+		project.addNewDiagram();
+		const auto diagram = project.addNewDiagram();
+		diagram->addItem(new IndependentTextItem(QStringLiteral("Pompe P1")));
+
+		project.setFilePath(path);
+		QVERIFY(project.write().isOk());
+	}
+
+	QSettings settings;
+	const QVariant lazy_folios = settings.value(QStringLiteral("diagrameditor/lazy_folios"));
+	settings.setValue(QStringLiteral("diagrameditor/lazy_folios"), true);
+	QETProject project(path);
+	if (lazy_folios.isValid()) {
+		settings.setValue(QStringLiteral("diagrameditor/lazy_folios"), lazy_folios);
+	} else {
+		settings.remove(QStringLiteral("diagrameditor/lazy_folios"));
+	}
+
+	QCOMPARE(project.state(), QETProject::Ok);
+	const auto diagram = project.diagrams().at(1);
+	QVERIFY(!diagram->isMaterialized());
+	QCOMPARE(diagram->pendingContent().texts_html.size(), 1);
+
+	QTextDocument document;
+	document.setHtml(diagram->pendingContent().texts_html.first());
+	QCOMPARE(document.toPlainText(), QStringLiteral("Pompe P1"));
+
+	project.materializeDiagram(diagram);
+	QVERIFY(diagram->isMaterialized());
+	QList<IndependentTextItem *> texts;
+	for (const auto &item : diagram->items()) {
+		if (const auto text = qgraphicsitem_cast<IndependentTextItem *>(item)) {
+			texts << text;
+		}
+	}
+	QCOMPARE(texts.size(), 1);
+	QCOMPARE(texts.first()->toPlainText(), document.toPlainText());
+}
+
+QTEST_MAIN(ProjectSaveTest)
+#include "tst_projectsave.moc"